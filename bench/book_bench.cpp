@@ -0,0 +1,147 @@
+// OrderBook microbenchmarks: passive adds, aggressive sweeps, cancels by
+// queue position and top-of-book reads
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <vector>
+#include "engine/CompactOrder.h"
+#include "engine/OrderBook.h"
+
+namespace {
+
+// Prices are ticks of 0.01 around 100.00
+constexpr int64_t MID_TICKS = 10000;
+
+CompactOrder limit(uint64_t id, OrderSide side, int64_t ticks, uint32_t qty) {
+    return CompactOrder::fromOrder(Order(id, 1, "BENCH", OrderType::LIMIT, side, ticks * 0.01, qty));
+}
+
+// Resting bids below and asks above the mid, nothing crossing
+void fillBook(OrderBook& book, int64_t levels, uint64_t& nextId) {
+    for (int64_t level = 1; level <= levels; ++level) {
+        book.addOrder(limit(nextId++, OrderSide::BUY, MID_TICKS - level, 100));
+        book.addOrder(limit(nextId++, OrderSide::SELL, MID_TICKS + level, 100));
+    }
+}
+
+} // namespace
+
+// 4096 bids spread over range(0) levels, none crossing. The book is emptied
+// again between iterations with the timer paused.
+static void BM_AddPassive(benchmark::State& state) {
+    const int64_t levels = state.range(0);
+    std::vector<CompactOrder> orders, cancels;
+    for (uint64_t id = 1; id <= 4096; ++id) {
+        CompactOrder order = limit(id, OrderSide::BUY, MID_TICKS - 1 - static_cast<int64_t>(id) % levels, 100);
+        orders.push_back(order);
+        cancels.push_back(CompactOrder::makeCancel(id, order.symbolId));
+    }
+    OrderBook book;
+    for (auto _ : state) {
+        for (const auto& order : orders) book.addOrder(order);
+        state.PauseTiming();
+        for (const auto& cancel : cancels) book.addOrder(cancel);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * orders.size());
+}
+BENCHMARK(BM_AddPassive)->ArgName("levels")->Arg(1)->Arg(16)->Arg(256);
+
+// Buys that each sweep exactly range(0) ask levels of one order apiece.
+// Every iteration lays out 1024 ask levels with the timer paused, then sends
+// 1024 / range(0) sweeps that clear them from the best price up.
+static void BM_AddAggressive(benchmark::State& state) {
+    constexpr int64_t LEVELS = 1024;
+    const int64_t levels = state.range(0);
+    const int64_t sweeps = LEVELS / levels;
+    std::vector<CompactOrder> asks, buys;
+    for (int64_t level = 0; level < LEVELS; ++level) {
+        asks.push_back(limit(level + 1, OrderSide::SELL, MID_TICKS + level, 10));
+    }
+    for (int64_t sweep = 0; sweep < sweeps; ++sweep) {
+        buys.push_back(limit(LEVELS + sweep + 1, OrderSide::BUY, MID_TICKS + (sweep + 1) * levels - 1,
+                             static_cast<uint32_t>(10 * levels)));
+    }
+    OrderBook book;
+    book.addOrder(limit(1000000, OrderSide::BUY, MID_TICKS - 100, 100));
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (const auto& ask : asks) book.addOrder(ask);
+        state.ResumeTiming();
+        for (const auto& buy : buys) book.addOrder(buy);
+    }
+    if (book.getTotalTrades() != static_cast<uint64_t>(state.iterations() * LEVELS)) {
+        state.SkipWithError("sweeps did not clear every level");
+    }
+    state.SetItemsProcessed(state.iterations() * sweeps);
+    state.counters["fills"] = static_cast<double>(levels);
+}
+BENCHMARK(BM_AddAggressive)->ArgName("levels")->RangeMultiplier(2)->Range(1, 64);
+
+enum class QueuePosition { FRONT, MIDDLE, BACK };
+
+// Cancels 256 orders, each at the given position of a level that starts
+// 1024 deep. Which ids those are is worked out, and the level refilled at
+// the back afterwards, with the timer paused.
+static void BM_Cancel(benchmark::State& state, QueuePosition position) {
+    constexpr size_t DEPTH = 1024;
+    constexpr size_t BATCH = 256;
+    OrderBook book;
+    uint64_t nextId = 1;
+    fillBook(book, 32, nextId);
+    CompactOrder resting = limit(0, OrderSide::BUY, MID_TICKS - 1, 100);
+    std::deque<uint64_t> queue;
+    auto refill = [&] {
+        while (queue.size() < DEPTH) {
+            resting.orderId = nextId++;
+            book.addOrder(resting);
+            queue.push_back(resting.orderId);
+        }
+    };
+    refill();
+    std::vector<uint64_t> ids;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ids.clear();
+        while (ids.size() < BATCH) {
+            size_t index = position == QueuePosition::FRONT ? 0
+                         : position == QueuePosition::MIDDLE ? queue.size() / 2 : queue.size() - 1;
+            ids.push_back(queue[index]);
+            queue.erase(queue.begin() + index);
+        }
+        state.ResumeTiming();
+        for (uint64_t id : ids) book.cancelOrder(id);
+        state.PauseTiming();
+        refill();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK_CAPTURE(BM_Cancel, front, QueuePosition::FRONT);
+BENCHMARK_CAPTURE(BM_Cancel, middle, QueuePosition::MIDDLE);
+BENCHMARK_CAPTURE(BM_Cancel, back, QueuePosition::BACK);
+
+// Lock-free seqlock read of the published best bid and offer
+static void BM_TopOfBook(benchmark::State& state) {
+    OrderBook book;
+    uint64_t nextId = 1;
+    fillBook(book, 100, nextId);
+    for (auto _ : state) {
+        TopOfBook top = book.getTopOfBook();
+        benchmark::DoNotOptimize(top);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TopOfBook);
+
+// The same answer taken under the book lock from the price levels
+static void BM_DepthSnapshotTop(benchmark::State& state) {
+    OrderBook book;
+    uint64_t nextId = 1;
+    fillBook(book, 100, nextId);
+    for (auto _ : state) {
+        DepthSnapshot snapshot = book.getDepthSnapshot(1);
+        benchmark::DoNotOptimize(snapshot);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DepthSnapshotTop);
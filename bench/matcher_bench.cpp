@@ -0,0 +1,74 @@
+// Matcher end to end: producer threads submitting through the MPSC ring
+// until the worker has applied everything
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "engine/Matcher.h"
+
+namespace {
+
+constexpr size_t TOTAL_ORDERS = 1 << 16;
+constexpr size_t SUBMIT_BATCH = 64;
+
+// Crossing limits around 100.00 so a good share of orders trade. Ids are
+// unique across producers.
+std::vector<std::vector<CompactOrder>> makeFlows(size_t producers) {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> tick(9950, 10050);
+    std::uniform_int_distribution<uint32_t> qty(1, 100);
+    std::vector<std::vector<CompactOrder>> flows(producers);
+    for (uint64_t id = 1; id <= TOTAL_ORDERS; ++id) {
+        Order order(id, 1, "BENCH", OrderType::LIMIT, id % 2 ? OrderSide::BUY : OrderSide::SELL,
+                    tick(rng) / 100.0, qty(rng));
+        flows[id % producers].push_back(CompactOrder::fromOrder(order));
+    }
+    return flows;
+}
+
+} // namespace
+
+static void BM_MatcherEndToEnd(benchmark::State& state) {
+    const size_t producers = static_cast<size_t>(state.range(0));
+    auto flows = makeFlows(producers);
+    Logger logger("/dev/null", LogMode::ASYNC_BINARY);
+    MatcherConfig config;
+    config.ingress = IngressMode::MPSC_RING;
+    std::unique_ptr<OrderBook> book;
+    std::unique_ptr<Matcher> matcher;
+    uint64_t trades = 0;
+    for (auto _ : state) {
+        // A fresh book and worker per run, built with the timer paused
+        state.PauseTiming();
+        if (book) trades += book->getTotalTrades();
+        matcher.reset();
+        book = std::make_unique<OrderBook>();
+        matcher = std::make_unique<Matcher>(*book, logger, config);
+        matcher->start();
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        for (const auto& flow : flows) {
+            threads.emplace_back([&matcher, &flow] {
+                for (size_t i = 0; i < flow.size(); i += SUBMIT_BATCH) {
+                    matcher->submitBatch(flow.data() + i, std::min(SUBMIT_BATCH, flow.size() - i));
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        // stop() drains the ring before returning
+        matcher->stop();
+        if (matcher->getProcessedOrders() != TOTAL_ORDERS) {
+            state.SkipWithError("matcher lost orders");
+            break;
+        }
+    }
+    if (book) trades += book->getTotalTrades();
+    state.SetItemsProcessed(state.iterations() * TOTAL_ORDERS);
+    state.counters["trades_per_run"] = benchmark::Counter(static_cast<double>(trades),
+                                                          benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MatcherEndToEnd)->ArgName("producers")->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
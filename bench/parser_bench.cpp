@@ -0,0 +1,92 @@
+// Per-message decode cost of every input format the engine accepts
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "engine/SymbolTable.h"
+#include "io/BulkDecoder.h"
+#include "io/OrderParser.h"
+#include "io/WireFormat.h"
+
+namespace {
+
+constexpr size_t MESSAGE_COUNT = 1024;
+const char* const SYMBOLS[] = {"AAPL", "MSFT", "GOOGL", "TSLA"};
+
+std::vector<std::string> makeMessages(char format) {
+    std::vector<std::string> messages;
+    for (size_t i = 1; i <= MESSAGE_COUNT; ++i) {
+        std::string id = std::to_string(i);
+        std::string symbol = SYMBOLS[i % 4];
+        std::string side = i % 2 ? "BUY" : "SELL";
+        std::string price = std::to_string(100 + i % 50) + "." + std::to_string(10 + i % 90);
+        std::string qty = std::to_string(1 + i % 500);
+        if (format == 'j') {
+            messages.push_back("{\"orderId\":" + id + ",\"clientId\":7,\"symbol\":\"" + symbol +
+                               "\",\"type\":\"LIMIT\",\"side\":\"" + side + "\",\"price\":" + price +
+                               ",\"quantity\":" + qty + "}");
+        } else {
+            std::string sep(1, format);
+            messages.push_back(id + sep + symbol + sep + "LIMIT" + sep + side + sep + price + sep + qty + sep + "7");
+        }
+    }
+    return messages;
+}
+
+} // namespace
+
+// One line through OrderParser's allocation-free string_view path
+static void BM_Parse(benchmark::State& state, char format) {
+    std::vector<std::string> messages = makeMessages(format);
+    OrderParser parser;
+    Order order;
+    size_t i = 0;
+    for (auto _ : state) {
+        ParseError error = parser.parse(messages[i], order);
+        benchmark::DoNotOptimize(error);
+        i = (i + 1) % MESSAGE_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Parse, json, 'j');
+BENCHMARK_CAPTURE(BM_Parse, csv, ',');
+BENCHMARK_CAPTURE(BM_Parse, pipe, '|');
+
+// Columnar batch decode of newline-delimited lines; the time is per buffer
+// of MESSAGE_COUNT lines
+static void BM_BulkDecode(benchmark::State& state, char format) {
+    std::string data;
+    for (const auto& message : makeMessages(format)) data += message + "\n";
+    BulkDecoder decoder;
+    OrderBatch batch;
+    batch.reserve(MESSAGE_COUNT);
+    for (auto _ : state) {
+        batch.clear();
+        decoder.decode(data, batch);
+        benchmark::DoNotOptimize(batch.size());
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGE_COUNT);
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.SetLabel(BulkDecoder::isaName(decoder.getIsa()));
+}
+BENCHMARK_CAPTURE(BM_BulkDecode, json, 'j');
+BENCHMARK_CAPTURE(BM_BulkDecode, csv, ',');
+
+// Binary NEW_ORDER messages walked and mapped onto CompactOrder
+static void BM_WireDecode(benchmark::State& state) {
+    OrderParser parser;
+    WireEncoder encoder;
+    for (const auto& message : makeMessages(',')) encoder.encodeNewOrder(parser.parse(message));
+    std::string_view data(encoder.buffer().data(), encoder.size());
+    SymbolCache symbols;
+    for (auto _ : state) {
+        WireDecoder decoder(data);
+        WireMessage message;
+        while (decoder.next(message) == WireStatus::OK) {
+            CompactOrder order = WireDecoder::toCompactOrder(message.newOrder, symbols);
+            benchmark::DoNotOptimize(order);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGE_COUNT);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_WireDecode);
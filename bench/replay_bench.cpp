@@ -0,0 +1,78 @@
+// Full-speed replay of a synthetic workload into the books and the Matcher.
+// Set OBME_WORKLOAD to a file written by obme-workload to replay it;
+// otherwise 200k messages are generated with the default WorkloadConfig.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "engine/Matcher.h"
+#include "io/Workload.h"
+
+namespace {
+
+const std::vector<CompactOrder>& workload() {
+    static const std::vector<CompactOrder> orders = [] {
+        const char* path = std::getenv("OBME_WORKLOAD");
+        if (path && *path) return WorkloadFile::load(path);
+        WorkloadGenerator generator;
+        return generator.generateCompact(200000);
+    }();
+    return orders;
+}
+
+} // namespace
+
+// Every message straight into its symbol's book on this thread
+static void BM_ReplayBooks(benchmark::State& state) {
+    const auto& orders = workload();
+    std::unique_ptr<BookRegistry> books;
+    std::vector<OrderBook*> bookFor;
+    for (auto _ : state) {
+        state.PauseTiming();
+        books = std::make_unique<BookRegistry>();
+        bookFor.assign(bookFor.size(), nullptr);
+        for (const auto& order : orders) {
+            if (order.symbolId >= bookFor.size()) bookFor.resize(order.symbolId + 1, nullptr);
+            if (!bookFor[order.symbolId]) bookFor[order.symbolId] = &books->getBook(order.symbolId);
+        }
+        state.ResumeTiming();
+        for (const auto& order : orders) bookFor[order.symbolId]->addOrder(order);
+    }
+    state.SetItemsProcessed(state.iterations() * orders.size());
+    state.counters["trades_per_run"] = benchmark::Counter(static_cast<double>(books->getTotalTrades()));
+}
+BENCHMARK(BM_ReplayBooks)->Unit(benchmark::kMillisecond);
+
+// One producer submitting in batches through the SPSC ring until the
+// worker has applied everything
+static void BM_ReplayMatcher(benchmark::State& state) {
+    const auto& orders = workload();
+    const size_t batch = static_cast<size_t>(state.range(0));
+    Logger logger("/dev/null", LogMode::ASYNC_BINARY);
+    MatcherConfig config;
+    config.ingress = IngressMode::SPSC_RING;
+    std::unique_ptr<BookRegistry> books;
+    std::unique_ptr<Matcher> matcher;
+    for (auto _ : state) {
+        state.PauseTiming();
+        matcher.reset();
+        books = std::make_unique<BookRegistry>();
+        matcher = std::make_unique<Matcher>(*books, logger, config);
+        matcher->start();
+        state.ResumeTiming();
+        for (size_t i = 0; i < orders.size(); i += batch) {
+            matcher->submitBatch(orders.data() + i, std::min(batch, orders.size() - i));
+        }
+        matcher->stop();
+        if (matcher->getProcessedOrders() != orders.size()) {
+            state.SkipWithError("matcher lost orders");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * orders.size());
+    LatencySnapshot wait = matcher->getQueueWait();
+    state.counters["queue_wait_p99_ns"] = static_cast<double>(wait.percentile(0.99));
+}
+BENCHMARK(BM_ReplayMatcher)->ArgName("batch")->Arg(1)->Arg(64)->Arg(256)
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,72 @@
+#include "BookRegistry.h"
+#include "SymbolTable.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+BookRegistry::BookRegistry(size_t poolCapacity, PoolMode poolMode)
+    : poolCapacity_(poolCapacity), poolMode_(poolMode) {}
+
+OrderBook& BookRegistry::getBook(uint32_t symbolId) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        auto it = books_.find(symbolId);
+        if (it != books_.end()) return *it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    auto& book = books_[symbolId];
+    if (!book) {
+        book = std::make_unique<OrderBook>(poolCapacity_, poolMode_);
+        if (tradeCb_) book->setTradeCallback(tradeCb_);
+        if (tradeBatchCb_) book->setTradeBatchCallback(tradeBatchCb_);
+    }
+    return *book;
+}
+
+OrderBook& BookRegistry::getBook(const std::string& symbol) {
+    return getBook(SymbolTable::instance().intern(symbol));
+}
+
+OrderBook* BookRegistry::findBook(uint32_t symbolId) const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    auto it = books_.find(symbolId);
+    return it == books_.end() ? nullptr : it->second.get();
+}
+
+OrderBook* BookRegistry::findBook(const std::string& symbol) const {
+    uint32_t symbolId = SymbolTable::instance().find(symbol);
+    return symbolId ? findBook(symbolId) : nullptr;
+}
+
+void BookRegistry::setTradeCallback(OrderBook::TradeCallback cb) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    tradeCb_ = cb;
+    for (auto& entry : books_) entry.second->setTradeCallback(cb);
+}
+
+void BookRegistry::setTradeBatchCallback(OrderBook::TradeBatchCallback cb) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    tradeBatchCb_ = cb;
+    for (auto& entry : books_) entry.second->setTradeBatchCallback(cb);
+}
+
+void BookRegistry::forEachBook(const std::function<void(uint32_t, const OrderBook&)>& visit) const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    std::vector<uint32_t> symbolIds;
+    symbolIds.reserve(books_.size());
+    for (const auto& entry : books_) symbolIds.push_back(entry.first);
+    std::sort(symbolIds.begin(), symbolIds.end());
+    for (uint32_t symbolId : symbolIds) visit(symbolId, *books_.at(symbolId));
+}
+
+size_t BookRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    return books_.size();
+}
+
+uint64_t BookRegistry::getTotalTrades() const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    uint64_t total = 0;
+    for (const auto& entry : books_) total += entry.second->getTotalTrades();
+    return total;
+}
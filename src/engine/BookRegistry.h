@@ -0,0 +1,38 @@
+#pragma once
+#include "OrderBook.h"
+#include <shared_mutex>
+#include <string>
+
+// One OrderBook per interned symbol. Books are created on first use and
+// never destroyed or moved, so a pointer obtained once can be cached by the
+// thread that owns the symbol. Callbacks should be set before matching
+// starts; they are copied onto books created afterwards.
+class BookRegistry {
+public:
+    explicit BookRegistry(size_t poolCapacity = OrderPool::DEFAULT_CAPACITY,
+                          PoolMode poolMode = PoolMode::GROWABLE);
+
+    // Creates the book on first use
+    OrderBook& getBook(uint32_t symbolId);
+    OrderBook& getBook(const std::string& symbol);
+    // Returns nullptr if no order for the symbol has been seen yet
+    OrderBook* findBook(uint32_t symbolId) const;
+    OrderBook* findBook(const std::string& symbol) const;
+
+    void setTradeCallback(OrderBook::TradeCallback cb);
+    void setTradeBatchCallback(OrderBook::TradeBatchCallback cb);
+
+    // Visits every book with its symbol id, lowest id first
+    void forEachBook(const std::function<void(uint32_t, const OrderBook&)>& visit) const;
+
+    size_t size() const;
+    uint64_t getTotalTrades() const;
+
+private:
+    size_t poolCapacity_;
+    PoolMode poolMode_;
+    OrderBook::TradeCallback tradeCb_;
+    OrderBook::TradeBatchCallback tradeBatchCb_;
+    std::unordered_map<uint32_t, std::unique_ptr<OrderBook>> books_;
+    mutable std::shared_mutex mtx_;
+};
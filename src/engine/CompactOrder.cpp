@@ -0,0 +1,123 @@
+#include "CompactOrder.h"
+#include "SymbolTable.h"
+#include "Utils.h"
+
+namespace {
+
+// Offset between the monotonic and wall clocks, sampled once per process so
+// conversions in both directions agree
+int64_t monotonicOffsetNs() {
+    static const int64_t offset =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count() -
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    return offset;
+}
+
+std::chrono::system_clock::time_point fromMonotonicNs(uint64_t ns) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(static_cast<int64_t>(ns) - monotonicOffsetNs())));
+}
+
+} // namespace
+
+uint64_t CompactOrder::toMonotonicNs(std::chrono::system_clock::time_point wallClock) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        wallClock.time_since_epoch()).count() + monotonicOffsetNs();
+}
+
+bool CompactOrder::fromOrder(const Order& order, CompactOrder& out) {
+    if (order.symbol.size() > MAX_SYMBOL_LENGTH) {
+        out = CompactOrder{};
+        return false;
+    }
+    auto& symbols = SymbolTable::instance();
+    out.orderId = order.orderId;
+    out.clientId = order.clientId;
+    out.symbolId = symbols.intern(order.symbol);
+    double tickSize = symbols.getTickSize(out.symbolId);
+    out.priceTicks = limitTicks(order.price, tickSize, order.side);
+    out.stopTicks = stopTicksFor(order.stopPrice, tickSize, order.side);
+    out.timestampNs = toMonotonicNs(order.timestamp);
+    out.quantity = order.quantity;
+    out.remainingQty = order.remainingQty;
+    out.type = order.type;
+    out.side = order.side;
+    out.timeInForce = order.timeInForce;
+    out.displayQty = order.displayQty;
+    out.submitNs = 0;
+    return pricesOnTick(order.type, order.price, order.stopPrice, tickSize);
+}
+
+bool CompactOrder::pricesOnTick(OrderType type, double price, double stopPrice, double tickSize) {
+    bool usesPrice = type == OrderType::LIMIT || type == OrderType::STOP_LIMIT ||
+                     type == OrderType::MODIFY;
+    bool usesStop = type == OrderType::STOP || type == OrderType::STOP_LIMIT;
+    return (!usesPrice || Utils::isOnTick(price, tickSize)) &&
+           (!usesStop || Utils::isOnTick(stopPrice, tickSize));
+}
+
+CompactOrder CompactOrder::fromOrder(const Order& order) {
+    CompactOrder compact;
+    fromOrder(order, compact);
+    return compact;
+}
+
+// Trades only happen on the grid, so these roundings change nothing about
+// which trades an order can take part in
+int64_t CompactOrder::limitTicks(double price, double tickSize, OrderSide side) {
+    return side == OrderSide::BUY ? Utils::priceToTicksDown(price, tickSize)
+                                  : Utils::priceToTicksUp(price, tickSize);
+}
+
+int64_t CompactOrder::stopTicksFor(double stopPrice, double tickSize, OrderSide side) {
+    return side == OrderSide::BUY ? Utils::priceToTicksUp(stopPrice, tickSize)
+                                  : Utils::priceToTicksDown(stopPrice, tickSize);
+}
+
+CompactOrder CompactOrder::makeCancel(uint64_t orderId, uint32_t symbolId) {
+    CompactOrder order = {};
+    order.orderId = orderId;
+    order.symbolId = symbolId;
+    order.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    order.type = OrderType::CANCEL;
+    return order;
+}
+
+CompactOrder CompactOrder::makeModify(uint64_t orderId, uint32_t symbolId, int64_t priceTicks,
+                                      uint32_t quantity) {
+    CompactOrder order = makeCancel(orderId, symbolId);
+    order.type = OrderType::MODIFY;
+    order.priceTicks = priceTicks;
+    order.quantity = quantity;
+    order.remainingQty = quantity;
+    return order;
+}
+
+Order CompactOrder::toOrder() const {
+    Order order;
+    copyTo(order);
+    return order;
+}
+
+void CompactOrder::copyTo(Order& out) const {
+    auto& symbols = SymbolTable::instance();
+    double tickSize = symbols.getTickSize(symbolId);
+    out.orderId = orderId;
+    out.clientId = clientId;
+    out.symbol = symbols.name(symbolId);
+    out.type = type;
+    out.side = side;
+    out.timeInForce = timeInForce;
+    out.displayQty = displayQty;
+    out.visibleQty = 0;
+    out.price = Utils::ticksToPrice(priceTicks, tickSize);
+    out.quantity = quantity;
+    out.remainingQty = remainingQty;
+    out.timestamp = fromMonotonicNs(timestampNs);
+    out.lastModified = out.timestamp;
+    out.stopPrice = Utils::ticksToPrice(stopTicks, tickSize);
+}
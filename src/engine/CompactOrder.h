@@ -0,0 +1,63 @@
+#pragma once
+#include "Order.h"
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+// Hot-path order representation: one cache line, trivially copyable, so it
+// can be queued and copied with a plain memcpy. Symbols are interned ids from
+// SymbolTable, prices are integer ticks at the symbol's tick size, and the
+// timestamp is monotonic nanoseconds. Order stays the external/parsing type.
+struct alignas(64) CompactOrder {
+    uint64_t orderId;
+    uint64_t clientId;
+    int64_t priceTicks;
+    int64_t stopTicks;
+    uint64_t timestampNs;
+    uint32_t symbolId;
+    uint32_t quantity;
+    uint32_t remainingQty;
+    uint32_t displayQty;    // Iceberg peak size, 0 when fully shown
+    uint32_t submitNs;      // Low bits of the monotonic clock at Matcher submit, for queue-wait timing
+    OrderType type;
+    OrderSide side;
+    TimeInForce timeInForce;
+
+    // Interns the symbol and converts prices to ticks at its tick size.
+    // Returns false if the limit or stop price the order's type uses is off
+    // that grid, or, without interning it, if the symbol is longer than
+    // MAX_SYMBOL_LENGTH. Otherwise out is still filled in, each off-tick price rounded
+    // so the order never trades past it: a buy limit down and a sell limit
+    // up, a buy stop up and a sell stop down.
+    static bool fromOrder(const Order& order, CompactOrder& out);
+    // The same conversion for callers that accept the directed rounding
+    static CompactOrder fromOrder(const Order& order);
+    // The directed roundings, for decoders that build CompactOrders directly
+    static int64_t limitTicks(double price, double tickSize, OrderSide side);
+    static int64_t stopTicksFor(double stopPrice, double tickSize, OrderSide side);
+    // The rule fromOrder applies: true if the prices type uses are on the grid
+    static bool pricesOnTick(OrderType type, double price, double stopPrice, double tickSize);
+    // Wall-clock time on the monotonic clock timestampNs uses, with one
+    // offset per process so toOrder() gives the same wall-clock time back
+    static uint64_t toMonotonicNs(std::chrono::system_clock::time_point wallClock);
+    // Requests against a resting order. They must carry the order's symbol so
+    // registries and shards route them to the book that holds it; quantity is
+    // the new total, as for OrderBook::modifyOrder.
+    static CompactOrder makeCancel(uint64_t orderId, uint32_t symbolId);
+    static CompactOrder makeModify(uint64_t orderId, uint32_t symbolId, int64_t priceTicks,
+                                   uint32_t quantity);
+    Order toOrder() const;
+    // Overwrites every field of an existing Order; reuses its symbol storage
+    void copyTo(Order& out) const;
+
+    bool isValid() const {
+        return orderId > 0 && quantity > 0 && symbolId != 0;
+    }
+
+    bool sameSymbol(const CompactOrder& other) const {
+        return symbolId == other.symbolId;
+    }
+};
+
+static_assert(sizeof(CompactOrder) <= 64, "CompactOrder must fit in one cache line");
+static_assert(std::is_trivially_copyable<CompactOrder>::value, "CompactOrder must be trivially copyable");
@@ -0,0 +1,61 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+void LatencySnapshot::merge(const LatencySnapshot& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) counts[i] += other.counts[i];
+    count += other.count;
+    max = std::max(max, other.max);
+}
+
+uint64_t LatencySnapshot::percentile(double p) const {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(p * static_cast<double>(count)));
+    rank = std::min(std::max<uint64_t>(rank, 1), count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(LatencyHistogram::bucketLimit(i), max);
+    }
+    return max;
+}
+
+std::string LatencySnapshot::summary() const {
+    std::ostringstream out;
+    out << "count=" << count << " p50=" << percentile(0.5) << " p99=" << percentile(0.99)
+        << " p99.9=" << percentile(0.999) << " max=" << max;
+    return out.str();
+}
+
+uint64_t LatencyHistogram::bucketLimit(size_t bucket) {
+    if (bucket < LINEAR_LIMIT) return bucket;
+    size_t offset = bucket - LINEAR_LIMIT;
+    unsigned exponent = LINEAR_BITS + static_cast<unsigned>(offset / SUB_BUCKETS);
+    unsigned shift = exponent - SUB_BUCKET_BITS;
+    uint64_t lower = (SUB_BUCKETS + offset % SUB_BUCKETS) << shift;
+    return lower + (1ULL << shift) - 1;
+}
+
+#ifdef OBME_LATENCY_TSC
+double LatencyHistogram::calibrateTsc() {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    uint64_t startTicks = __rdtsc();
+    auto end = start;
+    while (end - start < std::chrono::milliseconds(2)) end = Clock::now();
+    uint64_t ticks = __rdtsc() - startTicks;
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ticks ? ns / static_cast<double>(ticks) : 1.0;
+}
+#endif
+
+LatencySnapshot LatencyHistogram::snapshot() const {
+    LatencySnapshot out;
+    for (size_t i = 0; i < LatencySnapshot::BUCKET_COUNT; ++i) {
+        out.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        out.count += out.counts[i];
+    }
+    out.max = max_.load(std::memory_order_relaxed);
+    return out;
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include "PriceLevel.h"
+#include "RingBuffer.h"
+#include "../models/OrderSide.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// New state of one price level after a change. qty is the displayed
+// aggregate (iceberg reserves stay hidden); qty == 0 means the level is gone.
+// Every update takes the next sequence number, including ones dropped
+// because the feed was full, so a consumer that sees a gap knows to resync
+// from a snapshot.
+struct LevelUpdate {
+    uint64_t sequence;
+    double price;
+    uint64_t qty;
+    uint32_t orderCount;
+    OrderSide side;
+};
+
+struct LevelSnapshot {
+    double price;
+    uint64_t qty;
+    uint32_t orderCount;
+};
+
+// Best levels of each side, best first. Reflects every update up to and
+// including sequence, so a late joiner applies only later updates on top.
+struct DepthSnapshot {
+    uint64_t sequence = 0;
+    std::vector<LevelSnapshot> bids;
+    std::vector<LevelSnapshot> asks;
+};
+
+// The book is the single producer (it publishes under its own lock) and one
+// market data thread drains the other end
+using DepthFeed = SpscRingBuffer<LevelUpdate>;
+
+// Stamps and pushes level updates for a book. Publishing reads the level's
+// running aggregates, so each change costs O(1) however deep the level is.
+class DepthPublisher {
+public:
+    void setFeed(DepthFeed* feed) { feed_ = feed; }
+    bool enabled() const { return feed_ != nullptr; }
+
+    void publish(OrderSide side, double price, const PriceLevel& level) {
+        LevelUpdate update{++sequence_, price, level.displayedQty, level.orderCount, side};
+        if (!feed_->tryPush(update)) dropped_++;
+    }
+
+    uint64_t sequence() const { return sequence_; }
+    uint64_t dropped() const { return dropped_; }
+
+private:
+    DepthFeed* feed_ = nullptr;
+    uint64_t sequence_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+// One fill as the book executed it. tradeId numbers the book's trades from
+// 1; sequence numbers the reports on the feed, dropped ones included, so a
+// consumer that sees a gap knows reports were lost.
+struct ExecutionReport {
+    uint64_t sequence;
+    uint64_t tradeId;
+    uint64_t buyOrderId;
+    uint64_t sellOrderId;
+    double price;
+    uint32_t qty;
+    OrderSide aggressor;        // Side of the incoming order that took liquidity
+};
+
+// Same shape as DepthFeed: the book pushes under its lock and one consumer
+// thread drains the other end. Size it for the longest burst the consumer
+// may fall behind by; a full feed drops reports rather than stall matching.
+using ExecutionFeed = SpscRingBuffer<ExecutionReport>;
+
+// Stamps and pushes execution reports for a book: a fixed-size copy into a
+// preallocated slot, with no allocation or formatting on the matching path
+class ExecutionPublisher {
+public:
+    void setFeed(ExecutionFeed* feed) { feed_ = feed; }
+    bool enabled() const { return feed_ != nullptr; }
+
+    void publish(uint64_t tradeId, uint64_t buyOrderId, uint64_t sellOrderId, double price,
+                 uint32_t qty, OrderSide aggressor) {
+        ExecutionReport report{++sequence_, tradeId, buyOrderId, sellOrderId, price, qty, aggressor};
+        if (!feed_->tryPush(report)) dropped_++;
+    }
+
+    uint64_t dropped() const { return dropped_; }
+
+private:
+    ExecutionFeed* feed_ = nullptr;
+    uint64_t sequence_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+// Best bid and ask with their displayed sizes; a price of 0.0 means that
+// side is empty. sequence counts how many times the top has changed.
+struct TopOfBook {
+    double bidPrice = 0.0;
+    uint64_t bidQty = 0;
+    double askPrice = 0.0;
+    uint64_t askQty = 0;
+    uint64_t sequence = 0;
+};
+
+// Single-writer seqlock around a TopOfBook. The book writes under its own
+// lock; any number of readers copy the fields and retry if the version moved
+// or was odd (a write in progress), so they never take the book lock and
+// never hold up the writer. The fields are relaxed atomics so a torn read is
+// retried rather than being a data race.
+class SeqlockTopOfBook {
+public:
+    // Writer side; a no-op when nothing visible changed
+    void publish(double bidPrice, uint64_t bidQty, double askPrice, uint64_t askQty) {
+        if (bidPrice == last_.bidPrice && bidQty == last_.bidQty &&
+            askPrice == last_.askPrice && askQty == last_.askQty) return;
+        last_ = TopOfBook{bidPrice, bidQty, askPrice, askQty, last_.sequence + 1};
+        uint64_t version = version_.load(std::memory_order_relaxed);
+        version_.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bidPrice_.store(bidPrice, std::memory_order_relaxed);
+        bidQty_.store(bidQty, std::memory_order_relaxed);
+        askPrice_.store(askPrice, std::memory_order_relaxed);
+        askQty_.store(askQty, std::memory_order_relaxed);
+        sequence_.store(last_.sequence, std::memory_order_relaxed);
+        version_.store(version + 2, std::memory_order_release);
+    }
+
+    // Any thread
+    TopOfBook read() const {
+        TopOfBook top;
+        uint64_t before, after;
+        do {
+            before = version_.load(std::memory_order_acquire);
+            top.bidPrice = bidPrice_.load(std::memory_order_relaxed);
+            top.bidQty = bidQty_.load(std::memory_order_relaxed);
+            top.askPrice = askPrice_.load(std::memory_order_relaxed);
+            top.askQty = askQty_.load(std::memory_order_relaxed);
+            top.sequence = sequence_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = version_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return top;
+    }
+
+private:
+    // Readers hammer this line, so keep it off the book's own cache lines
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> version_{0};
+    std::atomic<double> bidPrice_{0.0};
+    std::atomic<uint64_t> bidQty_{0};
+    std::atomic<double> askPrice_{0.0};
+    std::atomic<uint64_t> askQty_{0};
+    std::atomic<uint64_t> sequence_{0};
+    alignas(CACHE_LINE_SIZE) TopOfBook last_;   // Writer-owned
+};
@@ -1,43 +1,415 @@
-#include "Matcher.h"
-
-Matcher::Matcher(OrderBook& book, Logger& logger) : book_(book), logger_(logger) {}
-
-void Matcher::start() {
-    running_ = true;
-    worker_ = std::thread(&Matcher::run, this);
-}
-
-void Matcher::stop() {
-    running_ = false;
-    cv_.notify_all();
-    if (worker_.joinable()) worker_.join();
-}
-
-void Matcher::submitOrder(const Order& order) {
-    {
-        std::lock_guard<std::mutex> lock(mtx_);
-        orderQueue_.push(order);
-    }
-    cv_.notify_one();
-}
-
-uint64_t Matcher::getProcessedOrders() const {
-    return processedOrders_.load();
-}
-
-void Matcher::run() {
-    while (running_) {
-        Order order;
-        {
-            std::unique_lock<std::mutex> lock(mtx_);
-            cv_.wait(lock, [&]{ return !orderQueue_.empty() || !running_; });
-            if (!running_ && orderQueue_.empty()) break;
-            order = orderQueue_.front();
-            orderQueue_.pop();
-        }
-        auto orderPtr = std::make_shared<Order>(order);
-        book_.addOrder(orderPtr);
-        processedOrders_++;
-        logger_.log("Order processed: id=" + std::to_string(order.orderId));
-    }
-}
+#include "Matcher.h"
+#include "Utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+Matcher::Matcher(OrderBook& book, Logger& logger, MatcherConfig config)
+    : Matcher(&book, nullptr, logger, config) {}
+
+Matcher::Matcher(BookRegistry& books, Logger& logger, MatcherConfig config)
+    : Matcher(nullptr, &books, logger, config) {}
+
+Matcher::Matcher(OrderBook* book, BookRegistry* registry, Logger& logger, MatcherConfig config)
+    : book_(book), registry_(registry), logger_(logger), config_(config) {
+    if (config_.maxBatch == 0) config_.maxBatch = 1;
+    if (config_.snapshotInterval > 0) {
+        if (!config_.journal || config_.snapshotPath.empty()) {
+            throw std::invalid_argument("Periodic snapshots need a journal and a snapshot path");
+        }
+        lastSnapshotSequence_ = config_.journal->getLastSequence();
+    }
+    if (config_.ingress == IngressMode::SPSC_RING) {
+        spscRing_ = std::make_unique<SpscRingBuffer<CompactOrder>>(config_.ringCapacity);
+    } else if (config_.ingress == IngressMode::MPSC_RING) {
+        mpscRing_ = std::make_unique<MpscRingBuffer<CompactOrder>>(config_.ringCapacity);
+    }
+}
+
+void Matcher::start() {
+    running_ = true;
+    ready_ = std::promise<void>();
+    std::future<void> ready = ready_.get_future();
+    worker_ = std::thread(&Matcher::run, this);
+    ready.wait();
+}
+
+void Matcher::stop() {
+    running_ = false;
+    {
+        // Taking the lock orders this notify after a sleeping consumer's wait
+        std::lock_guard<std::mutex> lock(mtx_);
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+bool Matcher::convert(const Order& order, CompactOrder& out) {
+    if (CompactOrder::fromOrder(order, out)) return true;
+    refusedOrders_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool Matcher::submitOrder(const Order& order) {
+    CompactOrder compact;
+    if (!convert(order, compact)) return false;
+    submitOrder(compact);
+    return true;
+}
+
+namespace {
+
+// Truncated to 32 bits: queue waits are differences taken modulo 2^32 ns
+// (about 4.3 s), which leaves CompactOrder its single cache line
+uint32_t submitClock() {
+    return static_cast<uint32_t>(LatencyHistogram::now());
+}
+
+CompactOrder stamped(const CompactOrder& order) {
+    CompactOrder out = order;
+    out.submitNs = submitClock();
+    return out;
+}
+
+} // namespace
+
+void Matcher::submitOrder(const CompactOrder& unstamped) {
+    CompactOrder order = stamped(unstamped);
+    if (config_.ingress == IngressMode::LOCKED_QUEUE) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            orderQueue_.push(order);
+        }
+        cv_.notify_one();
+        return;
+    }
+    while (!pushRing(order)) {
+        // Backpressure: wait for the matcher to free a slot
+        if (config_.wait == WaitStrategy::BUSY_SPIN) Utils::cpuRelax();
+        else std::this_thread::yield();
+    }
+    wakeConsumer();
+}
+
+bool Matcher::trySubmitOrder(const Order& order) {
+    CompactOrder compact;
+    return convert(order, compact) && trySubmitOrder(compact);
+}
+
+bool Matcher::trySubmitOrder(const CompactOrder& order) {
+    if (config_.ingress == IngressMode::LOCKED_QUEUE) {
+        submitOrder(order);
+        return true;
+    }
+    if (!pushRing(stamped(order))) {
+        rejectedSubmits_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    wakeConsumer();
+    return true;
+}
+
+void Matcher::submitBatch(const CompactOrder* orders, size_t count) {
+    if (count == 0) return;
+    if (config_.ingress == IngressMode::LOCKED_QUEUE) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            uint32_t now = submitClock();
+            for (size_t i = 0; i < count; ++i) {
+                orderQueue_.push(orders[i]);
+                orderQueue_.back().submitNs = now;
+            }
+        }
+        cv_.notify_one();
+        return;
+    }
+    // Stamped in chunks on the stack, one clock read each, so the caller's
+    // array stays const
+    constexpr size_t CHUNK = 64;
+    CompactOrder chunk[CHUNK];
+    for (size_t offset = 0; offset < count; offset += CHUNK) {
+        size_t size = std::min(CHUNK, count - offset);
+        uint32_t now = submitClock();
+        for (size_t i = 0; i < size; ++i) {
+            chunk[i] = orders[offset + i];
+            chunk[i].submitNs = now;
+        }
+        size_t sent = 0;
+        while (sent < size) {
+            size_t n = pushRingBatch(chunk + sent, size - sent);
+            if (n) {
+                sent += n;
+                wakeConsumer();
+            } else if (config_.wait == WaitStrategy::BUSY_SPIN) {
+                Utils::cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+size_t Matcher::submitBatch(const std::vector<Order>& orders) {
+    std::vector<CompactOrder> compact(orders.size());
+    size_t count = 0;
+    for (const auto& order : orders) {
+        if (convert(order, compact[count])) count++;
+    }
+    submitBatch(compact.data(), count);
+    return count;
+}
+
+LatencySnapshot Matcher::getQueueWait() const {
+    return queueWaitNs_.snapshot();
+}
+
+uint64_t Matcher::getProcessedOrders() const {
+    return processedOrders_.load();
+}
+
+uint64_t Matcher::getRejectedSubmits() const {
+    return rejectedSubmits_.load();
+}
+
+uint64_t Matcher::getRefusedOrders() const {
+    return refusedOrders_.load();
+}
+
+bool Matcher::isHalted() const {
+    return halted_.load(std::memory_order_acquire);
+}
+
+std::string Matcher::getHaltReason() const {
+    return isHalted() ? haltReason_ : std::string();
+}
+
+uint64_t Matcher::getDroppedOrders() const {
+    return droppedOrders_.load();
+}
+
+uint64_t Matcher::getSnapshotFailures() const {
+    return snapshotFailures_.load();
+}
+
+void Matcher::run() {
+    setUpWorker();
+    ready_.set_value();
+    if (config_.ingress == IngressMode::LOCKED_QUEUE) {
+        runLockedQueue();
+    } else {
+        runRing();
+    }
+    finishSnapshot();
+}
+
+// Pin first: everything allocated after that is first-touched by this
+// thread, so Linux places it on the pinned CPU's NUMA node
+void Matcher::setUpWorker() {
+    if (config_.cpu >= 0) {
+        if (!Utils::pinCurrentThreadToCpu(config_.cpu)) {
+            logger_.log("Matcher could not pin worker to cpu " + std::to_string(config_.cpu));
+        } else if (config_.reserveOrders > 0) {
+            // Where the reservation below will land
+            logger_.log("Matcher worker pinned to cpu " + std::to_string(config_.cpu) +
+                        ", NUMA node " + std::to_string(Utils::getCurrentNumaNode()));
+        }
+    }
+    if (config_.realtimePriority > 0 && !Utils::setCurrentThreadRealtime(config_.realtimePriority)) {
+        logger_.log("Matcher could not set SCHED_FIFO priority " + std::to_string(config_.realtimePriority));
+    }
+    if (batch_.size() != config_.maxBatch) batch_ = std::vector<CompactOrder>(config_.maxBatch);
+    if (config_.reserveOrders > 0 && book_) book_->reserveOrders(config_.reserveOrders);
+    // Registry books are reserved as bookFor first meets them
+    if (config_.lockMemory && !Utils::lockProcessMemory()) {
+        logger_.log("Matcher could not lock process memory");
+    }
+}
+
+void Matcher::runLockedQueue() {
+    while (true) {
+        size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [&]{ return !orderQueue_.empty() || !running_; });
+            // Drain whatever was submitted before stop()
+            if (!running_ && orderQueue_.empty()) break;
+            while (count < batch_.size() && !orderQueue_.empty()) {
+                batch_[count++] = orderQueue_.front();
+                orderQueue_.pop();
+            }
+        }
+        processBatch(count);
+    }
+}
+
+void Matcher::runRing() {
+    while (true) {
+        size_t count = popRingBatch(batch_.data(), batch_.size());
+        if (count) {
+            processBatch(count);
+            continue;
+        }
+        if (!running_.load(std::memory_order_acquire)) {
+            // Orders pushed before stop() are visible once running_ reads false
+            count = popRingBatch(batch_.data(), batch_.size());
+            if (count) {
+                processBatch(count);
+                continue;
+            }
+            break;
+        }
+        waitForOrders();
+    }
+}
+
+bool Matcher::pushRing(const CompactOrder& order) {
+    return spscRing_ ? spscRing_->tryPush(order) : mpscRing_->tryPush(order);
+}
+
+size_t Matcher::pushRingBatch(const CompactOrder* orders, size_t count) {
+    if (spscRing_) return spscRing_->tryPushBatch(orders, count);
+    size_t n = 0;
+    while (n < count && mpscRing_->tryPush(orders[n])) n++;
+    return n;
+}
+
+size_t Matcher::popRingBatch(CompactOrder* orders, size_t maxCount) {
+    return spscRing_ ? spscRing_->tryPopBatch(orders, maxCount)
+                     : mpscRing_->tryPopBatch(orders, maxCount);
+}
+
+bool Matcher::ringEmpty() const {
+    return spscRing_ ? spscRing_->empty() : mpscRing_->empty();
+}
+
+void Matcher::wakeConsumer() {
+    if (config_.wait != WaitStrategy::BLOCK) return;
+    // Pairs with the fence in waitForOrders: either we see the consumer
+    // asleep, or it sees our push before it goes to sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerSleeping_.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+        }
+        cv_.notify_one();
+    }
+}
+
+void Matcher::waitForOrders() {
+    switch (config_.wait) {
+        case WaitStrategy::BUSY_SPIN:
+            Utils::cpuRelax();
+            break;
+        case WaitStrategy::YIELD:
+            std::this_thread::yield();
+            break;
+        case WaitStrategy::BLOCK: {
+            std::unique_lock<std::mutex> lock(mtx_);
+            consumerSleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cv_.wait(lock, [&]{ return !ringEmpty() || !running_; });
+            consumerSleeping_.store(false, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+// Journals everything drained in one go, applies it under a single book lock
+// and writes one log record for the batch
+void Matcher::processBatch(size_t count) {
+    uint32_t now = submitClock();
+    for (size_t i = 0; i < count; ++i) queueWaitNs_.record(static_cast<uint32_t>(now - batch_[i].submitNs));
+    if (halted_.load(std::memory_order_relaxed)) {
+        droppedOrders_.fetch_add(count, std::memory_order_relaxed);
+        return;
+    }
+    if (config_.journal) {
+        try {
+            config_.journal->append(batch_.data(), count);
+        } catch (const std::exception& e) {
+            halt(std::string("journal append failed: ") + e.what());
+            droppedOrders_.fetch_add(count, std::memory_order_relaxed);
+            return;
+        }
+    }
+    applyBatch(count);
+    processedOrders_ += count;
+    logger_.logOrderBatch(count, batch_[0].orderId, batch_[count - 1].orderId);
+    if (config_.snapshotInterval > 0) maybeSnapshot();
+}
+
+void Matcher::halt(const std::string& reason) {
+    haltReason_ = reason;
+    halted_.store(true, std::memory_order_release);
+    logger_.log("Matcher halted, dropping all further orders: " + reason);
+}
+
+// Between batches the books hold exactly the journaled messages, so that is
+// where a snapshot starts. Rotating first ends a segment at its sequence;
+// only the fork itself stalls this thread.
+// A failed snapshot only costs disk: matching carries on, the segments it
+// would have covered stay, and the next one is tried an interval later.
+void Matcher::maybeSnapshot() {
+    try {
+        if (snapshot_.poll()) config_.journal->dropThrough(snapshot_.getSequence());
+    } catch (const std::exception& e) {
+        snapshotFailed(e.what());
+    }
+    uint64_t sequence = config_.journal->getLastSequence();
+    if (snapshot_.running() || sequence - lastSnapshotSequence_ < config_.snapshotInterval) return;
+    try {
+        config_.journal->rotate();
+    } catch (const std::exception& e) {
+        halt(std::string("journal rotate failed: ") + e.what());
+        return;
+    }
+    lastSnapshotSequence_ = sequence;
+    try {
+        if (book_) {
+            snapshot_.start(config_.snapshotPath, *book_, sequence);
+        } else {
+            snapshot_.start(config_.snapshotPath, *registry_, sequence);
+        }
+    } catch (const std::exception& e) {
+        snapshotFailed(e.what());
+    }
+}
+
+void Matcher::finishSnapshot() {
+    if (config_.snapshotInterval == 0) return;
+    try {
+        if (snapshot_.wait()) config_.journal->dropThrough(snapshot_.getSequence());
+    } catch (const std::exception& e) {
+        snapshotFailed(e.what());
+    }
+}
+
+void Matcher::snapshotFailed(const std::string& reason) {
+    snapshotFailures_.fetch_add(1, std::memory_order_relaxed);
+    logger_.log("Snapshot failed, journal segments kept: " + reason);
+}
+
+void Matcher::applyBatch(size_t count) {
+    if (book_) {
+        book_->addOrders(batch_.data(), count);
+        return;
+    }
+    // Hand each run of same-symbol orders to its book in one call
+    size_t start = 0;
+    while (start < count) {
+        uint32_t symbolId = batch_[start].symbolId;
+        size_t end = start + 1;
+        while (end < count && batch_[end].symbolId == symbolId) end++;
+        bookFor(symbolId).addOrders(batch_.data() + start, end - start);
+        start = end;
+    }
+}
+
+OrderBook& Matcher::bookFor(uint32_t symbolId) {
+    if (symbolId >= bookCache_.size()) bookCache_.resize(symbolId + 1, nullptr);
+    OrderBook*& book = bookCache_[symbolId];
+    if (!book) {
+        book = &registry_->getBook(symbolId);
+        if (config_.reserveOrders > 0) book->reserveOrders(config_.reserveOrders);
+    }
+    return *book;
+}
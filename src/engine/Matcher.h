@@ -1,27 +1,143 @@
-#pragma once
-#include "OrderBook.h"
-#include <thread>
-#include <queue>
-#include <condition_variable>
-#include <atomic>
-#include <memory>
-#include "../io/Logger.h"
-
-class Matcher {
-public:
-    Matcher(OrderBook& book, Logger& logger);
-    void start();
-    void stop();
-    void submitOrder(const Order& order);
-    uint64_t getProcessedOrders() const;
-private:
-    OrderBook& book_;
-    Logger& logger_;
-    std::queue<Order> orderQueue_;
-    std::mutex mtx_;
-    std::condition_variable cv_;
-    std::thread worker_;
-    std::atomic<bool> running_{false};
-    std::atomic<uint64_t> processedOrders_{0};
-    void run();
-};
+#pragma once
+#include "OrderBook.h"
+#include "BookRegistry.h"
+#include "RingBuffer.h"
+#include <thread>
+#include <queue>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+#include <memory>
+#include "../io/Logger.h"
+#include "../io/Journal.h"
+#include "../io/Snapshot.h"
+
+enum class IngressMode {
+    LOCKED_QUEUE,   // Unbounded std::queue behind a mutex
+    SPSC_RING,      // Bounded lock-free ring, exactly one submitting thread
+    MPSC_RING       // Bounded lock-free ring, any number of submitting threads
+};
+
+enum class WaitStrategy {
+    BUSY_SPIN,      // Lowest latency, burns a core while idle (with a pause hint)
+    YIELD,          // Spin but give the core away between polls
+    BLOCK           // Sleep on a condition variable until work arrives
+};
+
+struct MatcherConfig {
+    IngressMode ingress = IngressMode::LOCKED_QUEUE;
+    WaitStrategy wait = WaitStrategy::BLOCK;
+    size_t ringCapacity = 65536;
+    size_t maxBatch = 1024;     // Most orders the worker applies per book lock
+    int cpu = -1;               // Pin the worker to this CPU when >= 0
+    // SCHED_FIFO priority (1-99) for the worker when > 0. With BUSY_SPIN it
+    // never yields, so give it an isolated core or it starves the others.
+    int realtimePriority = 0;
+    // mlockall at worker startup so steady state takes no page faults
+    bool lockMemory = false;
+    // Resting orders to preallocate in each book the worker applies orders
+    // to. Done by the worker after pinning: it allocates fresh pool and level
+    // node slabs, used ahead of the book's constructor slabs, and rebuilds
+    // the id map, so the hot memory is first-touched on its NUMA node.
+    size_t reserveOrders = 0;
+    // Write-ahead journal: each drained batch is appended (and synced, if
+    // the journal is configured to) before it touches a book. Owned by the
+    // caller and written only by this matcher's worker. If an append fails
+    // the matcher halts (see isHalted).
+    JournalWriter* journal = nullptr;
+    // Periodic snapshots: once snapshotInterval messages have been journaled
+    // since the last one, the worker rotates the journal between batches and
+    // starts a BackgroundSnapshot to snapshotPath; when it completes, the
+    // journal segments it covers are deleted. Needs a journal; 0 disables.
+    // A snapshot that fails is logged and counted (getSnapshotFailures);
+    // matching continues, its segments are kept, and the next snapshot is
+    // tried an interval later.
+    std::string snapshotPath;
+    uint64_t snapshotInterval = 0;
+};
+
+class Matcher {
+public:
+    Matcher(OrderBook& book, Logger& logger, MatcherConfig config = MatcherConfig());
+    // Routes each order to its symbol's book in the registry
+    Matcher(BookRegistry& books, Logger& logger, MatcherConfig config = MatcherConfig());
+    // Returns once the worker has pinned itself and done its allocations
+    void start();
+    void stop();
+    // CANCEL and MODIFY orders share this path and are applied in submission
+    // order with new orders. Blocks (spinning or yielding) while a ring is full.
+    // An Order whose limit or stop price is off its symbol's tick grid, or
+    // whose symbol is longer than MAX_SYMBOL_LENGTH, is refused: false is
+    // returned and nothing is queued.
+    bool submitOrder(const Order& order);
+    void submitOrder(const CompactOrder& order);
+    // Returns false instead of waiting when a ring is full
+    bool trySubmitOrder(const Order& order);
+    bool trySubmitOrder(const CompactOrder& order);
+    // Submits the whole batch with one lock (LOCKED_QUEUE) or as few ring
+    // publishes as space allows; blocks like submitOrder while a ring is full
+    void submitBatch(const CompactOrder* orders, size_t count);
+    // Skips orders submitOrder would refuse; returns how many were submitted
+    size_t submitBatch(const std::vector<Order>& orders);
+    uint64_t getProcessedOrders() const;
+    uint64_t getRejectedSubmits() const;
+    // Orders refused at submit: off-tick prices and overlong symbols
+    uint64_t getRefusedOrders() const;
+    // A failed journal append halts matching for good: orders the journal
+    // did not record must never reach a book, or recovery would rebuild
+    // different books. The worker logs the error and keeps draining so
+    // submitters never block, but drops everything from that batch on.
+    // The owner should check isHalted and shut down.
+    bool isHalted() const;
+    std::string getHaltReason() const;
+    uint64_t getDroppedOrders() const;
+    uint64_t getSnapshotFailures() const;
+    // Submit-to-dequeue time in nanoseconds of every order processed so far.
+    // Recorded by the worker; safe to call from any thread while it runs.
+    LatencySnapshot getQueueWait() const;
+private:
+    OrderBook* book_ = nullptr;
+    BookRegistry* registry_ = nullptr;
+    std::vector<OrderBook*> bookCache_; // Worker-owned, indexed by symbol id
+    Logger& logger_;
+    MatcherConfig config_;
+    std::queue<CompactOrder> orderQueue_;
+    std::unique_ptr<SpscRingBuffer<CompactOrder>> spscRing_;
+    std::unique_ptr<MpscRingBuffer<CompactOrder>> mpscRing_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    std::promise<void> ready_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> consumerSleeping_{false};
+    std::atomic<uint64_t> processedOrders_{0};
+    std::atomic<uint64_t> rejectedSubmits_{0};
+    std::atomic<uint64_t> refusedOrders_{0};
+    std::atomic<uint64_t> droppedOrders_{0};
+    std::atomic<uint64_t> snapshotFailures_{0};
+    std::atomic<bool> halted_{false};
+    std::string haltReason_;    // Written once, before halted_ is set
+    LatencyHistogram queueWaitNs_;
+    std::vector<CompactOrder> batch_;   // Worker-owned drain buffer
+    BackgroundSnapshot snapshot_;
+    uint64_t lastSnapshotSequence_ = 0;
+    Matcher(OrderBook* book, BookRegistry* registry, Logger& logger, MatcherConfig config);
+    bool convert(const Order& order, CompactOrder& out);
+    void run();
+    void setUpWorker();
+    void runLockedQueue();
+    void runRing();
+    bool pushRing(const CompactOrder& order);
+    size_t pushRingBatch(const CompactOrder* orders, size_t count);
+    size_t popRingBatch(CompactOrder* orders, size_t maxCount);
+    bool ringEmpty() const;
+    void wakeConsumer();
+    void waitForOrders();
+    void processBatch(size_t count);
+    void halt(const std::string& reason);
+    void applyBatch(size_t count);
+    void maybeSnapshot();
+    void finishSnapshot();
+    void snapshotFailed(const std::string& reason);
+    OrderBook& bookFor(uint32_t symbolId);
+};
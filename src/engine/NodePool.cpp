@@ -0,0 +1,40 @@
+#include "NodePool.h"
+#include <algorithm>
+
+NodePool::NodePool(size_t blockSize, size_t capacity)
+    : blockSize_(std::max(blockSize, sizeof(FreeBlock))), slabSize_(std::max<size_t>(capacity, 1)) {
+    // Warm-up: the whole initial slab is threaded, and so touched, now
+    addSlab(slabSize_);
+}
+
+void* NodePool::allocate() {
+    if (!freeList_) addSlab(slabSize_);
+    FreeBlock* block = freeList_;
+    freeList_ = block->next;
+    inUse_++;
+    return block;
+}
+
+void NodePool::deallocate(void* block) {
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeList_;
+    freeList_ = freed;
+    inUse_--;
+}
+
+void NodePool::reserve(size_t count) {
+    if (count > 0) addSlab(count);
+}
+
+void NodePool::addSlab(size_t count) {
+    // Blocks are whole max_align_t units so every one stays aligned for any node
+    size_t units = (blockSize_ + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+    std::unique_ptr<std::max_align_t[]> slab(new std::max_align_t[units * count]);
+    for (size_t i = count; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab.get() + i * units);
+        block->next = freeList_;
+        freeList_ = block;
+    }
+    slabs_.push_back(std::move(slab));
+    capacity_ += count;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Freelist of equal-sized blocks for the nodes of node-based containers, so
+// the books' std::map price levels stop calling malloc once the pool is warm.
+// Blocks live in slabs that are only freed with the pool; running dry adds a
+// slab rather than failing, since a map cannot be refused a node. Not
+// thread-safe: the owning book guards it.
+class NodePool {
+public:
+    NodePool(size_t blockSize, size_t capacity);
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    void* allocate();
+    void deallocate(void* block);
+    // Adds a slab of count blocks, threaded by the calling thread and handed
+    // out before any block already free
+    void reserve(size_t count);
+
+    size_t blockSize() const { return blockSize_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    void addSlab(size_t count);
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::vector<std::unique_ptr<std::max_align_t[]>> slabs_;
+    FreeBlock* freeList_ = nullptr;
+    size_t blockSize_;
+    size_t slabSize_;
+    size_t capacity_ = 0;
+    size_t inUse_ = 0;
+};
+
+// Allocator handing single nodes out of a NodePool. Array requests, nodes
+// larger than the pool's blocks, and a null pool go to the global heap.
+template<typename T>
+class NodeAllocator {
+public:
+    using value_type = T;
+
+    explicit NodeAllocator(NodePool* pool = nullptr) noexcept : pool_(pool) {}
+    template<typename U>
+    NodeAllocator(const NodeAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(size_t n) {
+        if (pooled(n)) return static_cast<T*>(pool_->allocate());
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (pooled(n)) pool_->deallocate(p);
+        else ::operator delete(p);
+    }
+
+    NodePool* pool() const { return pool_; }
+
+    template<typename U>
+    bool operator==(const NodeAllocator<U>& other) const { return pool_ == other.pool(); }
+    template<typename U>
+    bool operator!=(const NodeAllocator<U>& other) const { return pool_ != other.pool(); }
+
+private:
+    bool pooled(size_t n) const {
+        return pool_ && n == 1 && sizeof(T) <= pool_->blockSize() &&
+               alignof(T) <= alignof(std::max_align_t);
+    }
+
+    NodePool* pool_;
+};
@@ -1,60 +1,97 @@
-#pragma once
-#include <string>
-#include <chrono>
-#include "../models/OrderType.h"
-#include "../models/OrderSide.h"
-
-struct Order {
-    // Core identifiers
-    uint64_t orderId;
-    uint64_t clientId;
-    std::string symbol;
-    
-    // Order specifications
-    OrderType type;
-    OrderSide side;
-    double price;           // For limit orders, ignored for market orders
-    uint32_t quantity;
-    uint32_t remainingQty;  // Tracks partial fills
-    
-    // Timing and lifecycle
-    std::chrono::system_clock::time_point timestamp;
-    std::chrono::system_clock::time_point lastModified;
-    
-    // For stop orders
-    double stopPrice;       // Trigger price for stop orders
-    
-    // Constructors
-    Order();
-    Order(uint64_t id, uint64_t client, const std::string& sym, OrderType t, 
-          OrderSide s, double p, uint32_t qty, double stop = 0.0);
-    Order(const Order& other);
-    Order& operator=(const Order& other);
-    
-    // Order lifecycle methods
-    void updateRemainingQty(uint32_t filledQty);
-    void cancel();
-    uint32_t getFilledQty() const;
-    
-    // Matching and execution
-    bool canMatchWith(const Order& other) const;
-    double getExecutionPrice(const Order& other) const;
-    
-    // Utility methods
-    std::string toString() const;
-    bool operator==(const Order& other) const;
-    bool operator<(const Order& other) const;
-    
-    // Validation and utility (inline implementations)
-    bool isValid() const {
-        return orderId > 0 && quantity > 0 && !symbol.empty();
-    }
-    
-    bool isPartiallyFilled() const {
-        return remainingQty < quantity && remainingQty > 0;
-    }
-    
-    bool isFullyFilled() const {
-        return remainingQty == 0;
-    }
-};
+#pragma once
+#include <string>
+#include <chrono>
+#include "../models/OrderType.h"
+#include "../models/OrderSide.h"
+#include "../models/TimeInForce.h"
+
+// Longest symbol the engine accepts: journal and snapshot records store
+// names in 48 NUL-terminated bytes
+constexpr size_t MAX_SYMBOL_LENGTH = 47;
+
+struct Order {
+    // Core identifiers
+    uint64_t orderId;
+    uint64_t clientId;
+    std::string symbol;
+    
+    // Order specifications
+    OrderType type;
+    OrderSide side;
+    double price;           // For limit orders, ignored for market orders
+    uint32_t quantity;
+    uint32_t remainingQty;  // Tracks partial fills
+    TimeInForce timeInForce = TimeInForce::GTC;
+    
+    // Iceberg orders show at most displayQty of remainingQty at a time and
+    // keep the rest hidden; 0 shows the whole order. visibleQty is the part
+    // of the current slice still resting.
+    uint32_t displayQty = 0;
+    uint32_t visibleQty = 0;
+    
+    // Timing and lifecycle
+    std::chrono::system_clock::time_point timestamp;
+    std::chrono::system_clock::time_point lastModified;
+    
+    // For stop orders
+    double stopPrice;       // Trigger price for stop orders
+    
+    // Intrusive links into the resting price level; owned by the book and
+    // never copied between orders
+    Order* prevInLevel = nullptr;
+    Order* nextInLevel = nullptr;
+    
+    // Constructors
+    Order();
+    Order(uint64_t id, uint64_t client, const std::string& sym, OrderType t, 
+          OrderSide s, double p, uint32_t qty, double stop = 0.0);
+    Order(const Order& other);
+    Order& operator=(const Order& other);
+    
+    // Order lifecycle methods
+    void updateRemainingQty(uint32_t filledQty);
+    void cancel();
+    uint32_t getFilledQty() const;
+    
+    // Matching and execution
+    bool canMatchWith(const Order& other) const;
+    double getExecutionPrice(const Order& other) const;
+    
+    // Utility methods
+    std::string toString() const;
+    bool operator==(const Order& other) const;
+    bool operator<(const Order& other) const;
+    
+    // Validation and utility (inline implementations)
+    bool isValid() const {
+        return orderId > 0 && quantity > 0 && !symbol.empty() && symbol.size() <= MAX_SYMBOL_LENGTH;
+    }
+    
+    bool isPartiallyFilled() const {
+        return remainingQty < quantity && remainingQty > 0;
+    }
+    
+    bool isFullyFilled() const {
+        return remainingQty == 0;
+    }
+    
+    bool isIceberg() const {
+        return displayQty > 0;
+    }
+    
+    // Quantity a resting order offers to the next incoming order
+    uint32_t shownQty() const {
+        return displayQty > 0 ? visibleQty : remainingQty;
+    }
+    
+    // Starts a fresh iceberg slice, capped by what is left
+    void showNextSlice() {
+        visibleQty = displayQty < remainingQty ? displayQty : remainingQty;
+    }
+    
+    // Market, IOC and FOK orders never rest; whatever they cannot fill on
+    // arrival is dropped
+    bool canRest() const {
+        return type != OrderType::MARKET && timeInForce == TimeInForce::GTC;
+    }
+};
@@ -1,110 +1,462 @@
-#include "OrderBook.h"
-#include <algorithm>
-#include <cassert>
-
-OrderBook::OrderBook() {}
-
-void OrderBook::addOrder(OrderPtr order) {
-    if (!order || !order->isValid()) return;
-    std::lock_guard<std::mutex> lock(mtx_);
-    orderMap_[order->orderId] = order;
-    if (order->side == OrderSide::BUY) {
-        match(order);
-        if (order->remainingQty > 0) {
-            bids_[order->price].push_back(order);
-        }
-    } else {
-        match(order);
-        if (order->remainingQty > 0) {
-            asks_[order->price].push_back(order);
-        }
-    }
-}
-
-void OrderBook::cancelOrder(uint64_t orderId) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    auto it = orderMap_.find(orderId);
-    if (it == orderMap_.end()) return;
-    auto order = it->second;
-    order->remainingQty = 0;
-    // Remove from price level
-    if (order->side == OrderSide::BUY) {
-        auto pit = bids_.find(order->price);
-        if (pit != bids_.end()) {
-            auto& dq = pit->second;
-            dq.erase(std::remove_if(dq.begin(), dq.end(), [orderId](const OrderPtr& o){ return o->orderId == orderId; }), dq.end());
-            if (dq.empty()) bids_.erase(pit);
-        }
-    } else {
-        auto pit = asks_.find(order->price);
-        if (pit != asks_.end()) {
-            auto& dq = pit->second;
-            dq.erase(std::remove_if(dq.begin(), dq.end(), [orderId](const OrderPtr& o){ return o->orderId == orderId; }), dq.end());
-            if (dq.empty()) asks_.erase(pit);
-        }
-    }
-    orderMap_.erase(it);
-}
-
-void OrderBook::setTradeCallback(TradeCallback cb) {
-    tradeCb_ = cb;
-}
-
-double OrderBook::getBestBid() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return bids_.empty() ? 0.0 : bids_.begin()->first;
-}
-
-double OrderBook::getBestAsk() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return asks_.empty() ? 0.0 : asks_.begin()->first;
-}
-
-uint64_t OrderBook::getTotalTrades() const {
-    return totalTrades_.load();
-}
-
-void OrderBook::match(OrderPtr order) {
-    if (order->side == OrderSide::BUY) {
-        // Match buy order against asks (sell orders)
-        while (order->remainingQty > 0 && !asks_.empty()) {
-            auto it = asks_.begin();
-            double price = it->first;
-            if (order->price < price) {
-                break; // Buy price too low to match
-            }
-            auto& dq = it->second;
-            while (order->remainingQty > 0 && !dq.empty()) {
-                auto matchOrder = dq.front();
-                uint32_t fillQty = std::min(order->remainingQty, matchOrder->remainingQty);
-                executeTrade(order, matchOrder, price, fillQty);
-                if (matchOrder->remainingQty == 0) dq.pop_front();
-            }
-            if (dq.empty()) asks_.erase(it);
-        }
-    } else {
-        // Match sell order against bids (buy orders)
-        while (order->remainingQty > 0 && !bids_.empty()) {
-            auto it = bids_.begin();
-            double price = it->first;
-            if (order->price > price) {
-                break; // Sell price too high to match
-            }
-            auto& dq = it->second;
-            while (order->remainingQty > 0 && !dq.empty()) {
-                auto matchOrder = dq.front();
-                uint32_t fillQty = std::min(order->remainingQty, matchOrder->remainingQty);
-                executeTrade(matchOrder, order, price, fillQty);
-                if (matchOrder->remainingQty == 0) dq.pop_front();
-            }
-            if (dq.empty()) bids_.erase(it);
-        }
-    }
-}
-
-void OrderBook::executeTrade(OrderPtr buy, OrderPtr sell, double price, uint32_t qty) {
-    buy->remainingQty -= qty;
-    sell->remainingQty -= qty;
-    totalTrades_++;
-    if (tradeCb_) tradeCb_(*buy, *sell, price, qty);
-}
+#include "OrderBook.h"
+#include "SymbolTable.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cassert>
+
+OrderBook::OrderBook(size_t poolCapacity, PoolMode poolMode)
+    : levelNodes_(LEVEL_NODE_SIZE, poolCapacity),
+      bids_(LevelMap<std::greater<double>>::allocator_type(&levelNodes_)),
+      asks_(LevelMap<std::less<double>>::allocator_type(&levelNodes_)),
+      orderMap_(poolCapacity),
+      pool_(poolCapacity, poolMode),
+      stops_(&levelNodes_) {}
+
+bool OrderBook::addOrder(const Order& order) {
+    if (order.type == OrderType::CANCEL) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        uint64_t start = LatencyHistogram::now();
+        bool found = cancelResting(order.orderId);
+        publishTop();
+        recordService(order.type, start);
+        return found;
+    }
+    if (order.type == OrderType::MODIFY) {
+        return modifyOrder(order.orderId, order.price, order.quantity);
+    }
+    if (!order.isValid()) return false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    // A resting order owns its id until it is filled or cancelled
+    if (orderMap_.contains(order.orderId)) return false;
+    uint64_t start = LatencyHistogram::now();
+    bool accepted = admit(pool_.acquire(order));
+    flushTrades();
+    publishTop();
+    recordService(order.type, start);
+    return accepted;
+}
+
+bool OrderBook::addOrder(OrderPtr order) {
+    return order ? addOrder(*order) : false;
+}
+
+bool OrderBook::addOrder(const CompactOrder& order) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    uint64_t start = LatencyHistogram::now();
+    bool accepted = admitCompact(order);
+    flushTrades();
+    publishTop();
+    recordService(order.type, start);
+    return accepted;
+}
+
+size_t OrderBook::addOrders(const CompactOrder* orders, size_t count) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    size_t accepted = 0;
+    // One clock read per order: each order's time runs from the end of the last
+    uint64_t start = LatencyHistogram::now();
+    for (size_t i = 0; i < count; ++i) {
+        if (admitCompact(orders[i])) accepted++;
+        uint64_t end = LatencyHistogram::now();
+        (orders[i].type == OrderType::CANCEL ? cancelNs_ : serviceNs_).record(end - start);
+        start = end;
+    }
+    flushTrades();
+    publishTop();
+    return accepted;
+}
+
+// Cancels and modifies travel the same path as new orders, so a batch from
+// the matcher applies all three under its one lock
+bool OrderBook::admitCompact(const CompactOrder& order) {
+    if (order.type == OrderType::CANCEL) return cancelResting(order.orderId);
+    if (order.type == OrderType::MODIFY) {
+        double tickSize = SymbolTable::instance().getTickSize(order.symbolId);
+        return modifyResting(order.orderId, Utils::ticksToPrice(order.priceTicks, tickSize),
+                             order.quantity);
+    }
+    if (!order.isValid()) return false;
+    if (orderMap_.contains(order.orderId)) return false;
+    Order* pooled = pool_.acquire();
+    if (pooled) order.copyTo(*pooled);
+    return admit(pooled);
+}
+
+// Matches a freshly pooled order and rests or recycles whatever is left
+bool OrderBook::admit(Order* pooled) {
+    if (!pooled) return false;
+    if (StopBook::isStop(*pooled)) {
+        if (!StopBook::isTriggered(*pooled, lastTradePrice_)) {
+            orderMap_.insert(pooled->orderId, RestingOrder{pooled, stops_.add(pooled)});
+            return true;
+        }
+        // The market is already through the stop
+        StopBook::activate(*pooled);
+    }
+    // A fill-or-kill that cannot complete never touches the book
+    if (pooled->timeInForce == TimeInForce::FOK && !canFill(*pooled)) {
+        pool_.release(pooled);
+        return true;
+    }
+    uint64_t tradesBefore = totalTrades_.load(std::memory_order_relaxed);
+    match(*pooled);
+    matchDepth_.record(totalTrades_.load(std::memory_order_relaxed) - tradesBefore);
+    if (pooled->remainingQty > 0 && pooled->canRest()) {
+        rest(pooled);
+    } else {
+        pool_.release(pooled);
+    }
+    releaseStops();
+    return true;
+}
+
+// Admits fired stops one at a time in firing order. Stops fired while doing
+// so join the back of the queue, so a cascade resolves within the call that
+// started it, in the same order every time.
+void OrderBook::releaseStops() {
+    if (releasingStops_) return;
+    releasingStops_ = true;
+    while (!triggeredStops_.empty()) {
+        Order* order = triggeredStops_.front();
+        triggeredStops_.remove(order);
+        orderMap_.erase(order->orderId);
+        StopBook::activate(*order);
+        admit(order);
+    }
+    releasingStops_ = false;
+}
+
+void OrderBook::cancelOrder(uint64_t orderId) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    uint64_t start = LatencyHistogram::now();
+    cancelResting(orderId);
+    publishTop();
+    recordService(OrderType::CANCEL, start);
+}
+
+bool OrderBook::cancelResting(uint64_t orderId) {
+    RestingOrder* resting = orderMap_.find(orderId);
+    if (!resting) return false;
+    unlink(*resting);
+    return true;
+}
+
+void OrderBook::reduceOrder(uint64_t orderId, uint32_t qty) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    RestingOrder* resting = orderMap_.find(orderId);
+    if (!resting) return;
+    auto& order = *resting->order;
+    // Reducing keeps the order's place in the queue
+    uint32_t cut = std::min(qty, order.remainingQty);
+    uint32_t shown = order.shownQty();
+    order.remainingQty -= cut;
+    order.visibleQty = std::min(order.visibleQty, order.remainingQty);
+    resting->level->reduce(cut, shown - order.shownQty());
+    if (order.remainingQty == 0) {
+        unlink(*resting);
+    } else if (!StopBook::isStop(order)) {
+        publishLevel(order.side, order.price, *resting->level);
+    }
+    publishTop();
+}
+
+bool OrderBook::modifyOrder(uint64_t orderId, double price, uint32_t quantity) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    uint64_t start = LatencyHistogram::now();
+    bool found = modifyResting(orderId, price, quantity);
+    flushTrades();
+    publishTop();
+    recordService(OrderType::MODIFY, start);
+    return found;
+}
+
+bool OrderBook::modifyResting(uint64_t orderId, double price, uint32_t quantity) {
+    RestingOrder* resting = orderMap_.find(orderId);
+    if (!resting) return false;
+    Order* order = resting->order;
+    uint32_t filled = order->quantity - order->remainingQty;
+    if (quantity <= filled) {
+        // Nothing left to trade at the new size
+        unlink(*resting);
+        return true;
+    }
+    uint32_t remaining = quantity - filled;
+    order->lastModified = std::chrono::system_clock::now();
+    if (price == order->price && remaining <= order->remainingQty) {
+        uint32_t cut = order->remainingQty - remaining;
+        uint32_t shown = order->shownQty();
+        order->quantity = quantity;
+        order->remainingQty = remaining;
+        order->visibleQty = std::min(order->visibleQty, remaining);
+        resting->level->reduce(cut, shown - order->shownQty());
+        if (!StopBook::isStop(*order)) publishLevel(order->side, order->price, *resting->level);
+        return true;
+    }
+
+    // Lose priority: take the order off its level and admit it again
+    detach(*resting);
+    order->price = price;
+    order->quantity = quantity;
+    order->remainingQty = remaining;
+    return admit(order);
+}
+
+void OrderBook::rest(Order* order) {
+    if (order->isIceberg()) order->showNextSlice();
+    place(order);
+}
+
+void OrderBook::place(Order* order) {
+    PriceLevel* level = order->side == OrderSide::BUY
+        ? &bids_[order->price]
+        : &asks_[order->price];
+    level->pushBack(order);
+    orderMap_.insert(order->orderId, RestingOrder{order, level});
+    publishLevel(order->side, order->price, *level);
+}
+
+// Both take the entry by value: erasing it from the id map may move others
+// into its slot
+void OrderBook::unlink(RestingOrder resting) {
+    pool_.release(detach(resting));
+}
+
+Order* OrderBook::detach(RestingOrder resting) {
+    Order* order = resting.order;
+    if (StopBook::isStop(*order)) {
+        stops_.remove(order);
+    } else {
+        PriceLevel* level = resting.level;
+        level->remove(order);
+        publishLevel(order->side, order->price, *level);
+        if (level->empty()) {
+            if (order->side == OrderSide::BUY) bids_.erase(order->price);
+            else asks_.erase(order->price);
+        }
+    }
+    orderMap_.erase(order->orderId);
+    return order;
+}
+
+void OrderBook::setTradeCallback(TradeCallback cb) {
+    tradeCb_ = cb;
+}
+
+void OrderBook::setTradeBatchCallback(TradeBatchCallback cb) {
+    tradeBatchCb_ = cb;
+}
+
+// Hands the trades collected during one call to the batch callback
+void OrderBook::flushTrades() {
+    if (pendingTrades_.empty()) return;
+    tradeBatchCb_(pendingTrades_);
+    pendingTrades_.clear();
+}
+
+// Called at the end of every mutating call, so readers only ever see the
+// book between calls, never halfway through a sweep
+void OrderBook::publishTop() {
+    top_.publish(bids_.empty() ? 0.0 : bids_.begin()->first,
+                 bids_.empty() ? 0 : bids_.begin()->second.displayedQty,
+                 asks_.empty() ? 0.0 : asks_.begin()->first,
+                 asks_.empty() ? 0 : asks_.begin()->second.displayedQty);
+}
+
+void OrderBook::recordService(OrderType type, uint64_t startNs) {
+    (type == OrderType::CANCEL ? cancelNs_ : serviceNs_).record(LatencyHistogram::now() - startNs);
+}
+
+double OrderBook::getBestBid() const {
+    return top_.read().bidPrice;
+}
+
+double OrderBook::getBestAsk() const {
+    return top_.read().askPrice;
+}
+
+TopOfBook OrderBook::getTopOfBook() const {
+    return top_.read();
+}
+
+void OrderBook::setDepthFeed(DepthFeed* feed) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    depth_.setFeed(feed);
+}
+
+DepthSnapshot OrderBook::getDepthSnapshot(size_t depth) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    DepthSnapshot snapshot;
+    snapshot.sequence = depth_.sequence();
+    for (auto it = bids_.begin(); it != bids_.end() && snapshot.bids.size() < depth; ++it) {
+        snapshot.bids.push_back({it->first, it->second.displayedQty, it->second.orderCount});
+    }
+    for (auto it = asks_.begin(); it != asks_.end() && snapshot.asks.size() < depth; ++it) {
+        snapshot.asks.push_back({it->first, it->second.displayedQty, it->second.orderCount});
+    }
+    return snapshot;
+}
+
+uint64_t OrderBook::getDroppedDepthUpdates() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return depth_.dropped();
+}
+
+void OrderBook::setExecutionFeed(ExecutionFeed* feed) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    executions_.setFeed(feed);
+}
+
+uint64_t OrderBook::getDroppedExecutionReports() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return executions_.dropped();
+}
+
+uint64_t OrderBook::getTotalTrades() const {
+    return totalTrades_.load();
+}
+
+size_t OrderBook::getPendingStops() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stops_.size();
+}
+
+OrderPool::Stats OrderBook::getPoolStats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return pool_.getStats();
+}
+
+void OrderBook::reserveOrders(size_t count) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    pool_.reserve(count);
+    levelNodes_.reserve(count);
+    orderMap_.rebuild(orderMap_.size() + count);
+}
+
+BookLatencyStats OrderBook::getLatencyStats() const {
+    return BookLatencyStats{serviceNs_.snapshot(), cancelNs_.snapshot(), matchDepth_.snapshot()};
+}
+
+void OrderBook::forEachResting(const std::function<void(const Order&)>& visit) const {
+    for (const auto& entry : bids_) {
+        for (const Order* order = entry.second.front(); order; order = order->nextInLevel) visit(*order);
+    }
+    for (const auto& entry : asks_) {
+        for (const Order* order = entry.second.front(); order; order = order->nextInLevel) visit(*order);
+    }
+    stops_.forEach(visit);
+}
+
+double OrderBook::getLastTradePrice() const {
+    return lastTradePrice_;
+}
+
+bool OrderBook::restoreResting(const Order& order) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (orderMap_.contains(order.orderId)) return false;
+    Order* pooled = pool_.acquire(order);
+    if (!pooled) return false;
+    if (StopBook::isStop(*pooled)) {
+        orderMap_.insert(pooled->orderId, RestingOrder{pooled, stops_.add(pooled)});
+    } else {
+        place(pooled);
+    }
+    publishTop();
+    return true;
+}
+
+void OrderBook::restoreLastTradePrice(double price) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    lastTradePrice_ = price;
+}
+
+void OrderBook::match(Order& order) {
+    if (order.side == OrderSide::BUY) {
+        // Match buy order against asks (sell orders)
+        while (order.remainingQty > 0 && !asks_.empty()) {
+            auto it = asks_.begin();
+            double price = it->first;
+            if (order.type != OrderType::MARKET && order.price < price) {
+                break; // Buy price too low to match
+            }
+            auto& level = it->second;
+            while (order.remainingQty > 0 && !level.empty()) {
+                Order* matchOrder = level.front();
+                uint32_t fillQty = std::min(order.remainingQty, matchOrder->shownQty());
+                executeTrade(order, *matchOrder, price, fillQty, OrderSide::BUY);
+                fillResting(level, matchOrder, fillQty);
+            }
+            publishLevel(OrderSide::SELL, price, level);
+            if (level.empty()) asks_.erase(it);
+        }
+    } else {
+        // Match sell order against bids (buy orders)
+        while (order.remainingQty > 0 && !bids_.empty()) {
+            auto it = bids_.begin();
+            double price = it->first;
+            if (order.type != OrderType::MARKET && order.price > price) {
+                break; // Sell price too high to match
+            }
+            auto& level = it->second;
+            while (order.remainingQty > 0 && !level.empty()) {
+                Order* matchOrder = level.front();
+                uint32_t fillQty = std::min(order.remainingQty, matchOrder->shownQty());
+                executeTrade(*matchOrder, order, price, fillQty, OrderSide::SELL);
+                fillResting(level, matchOrder, fillQty);
+            }
+            publishLevel(OrderSide::BUY, price, level);
+            if (level.empty()) bids_.erase(it);
+        }
+    }
+}
+
+// Books a fill against the order at the front of a level. The fill comes out
+// of the shown quantity, so an iceberg whose slice is used up is requeued
+// with the next one.
+void OrderBook::fillResting(PriceLevel& level, Order* resting, uint32_t qty) {
+    level.reduce(qty, qty);
+    if (resting->isIceberg()) resting->visibleQty -= qty;
+    if (resting->remainingQty == 0) {
+        level.remove(resting);
+        orderMap_.erase(resting->orderId);
+        pool_.release(resting);
+    } else if (resting->isIceberg() && resting->visibleQty == 0) {
+        level.replenish(resting);
+    }
+}
+
+// Sums the opposite side level by level until the order's quantity is
+// covered or its limit is passed, so the cost is O(levels), not O(orders)
+bool OrderBook::canFill(const Order& order) const {
+    uint64_t available = 0;
+    if (order.side == OrderSide::BUY) {
+        for (const auto& entry : asks_) {
+            if (order.type != OrderType::MARKET && order.price < entry.first) break;
+            available += entry.second.totalQty;
+            if (available >= order.remainingQty) return true;
+        }
+    } else {
+        for (const auto& entry : bids_) {
+            if (order.type != OrderType::MARKET && order.price > entry.first) break;
+            available += entry.second.totalQty;
+            if (available >= order.remainingQty) return true;
+        }
+    }
+    return false;
+}
+
+void OrderBook::executeTrade(Order& buy, Order& sell, double price, uint32_t qty, OrderSide aggressor) {
+    buy.remainingQty -= qty;
+    sell.remainingQty -= qty;
+    uint64_t tradeId = totalTrades_.fetch_add(1) + 1;
+    lastTradePrice_ = price;
+    if (!stops_.empty()) stops_.trigger(price, triggeredStops_);
+    if (executions_.enabled()) {
+        executions_.publish(tradeId, buy.orderId, sell.orderId, price, qty, aggressor);
+    }
+    if (tradeCb_) tradeCb_(buy, sell, price, qty);
+    if (tradeBatchCb_) pendingTrades_.push_back(Trade{buy.orderId, sell.orderId, price, qty});
+}
+
+void OrderBook::publishLevel(OrderSide side, double price, const PriceLevel& level) {
+    if (depth_.enabled()) depth_.publish(side, price, level);
+}
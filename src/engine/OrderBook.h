@@ -1,37 +1,161 @@
-#pragma once
-#include "Order.h"
-#include <map>
-#include <deque>
-#include <unordered_map>
-#include <mutex>
-#include <memory>
-#include <vector>
-#include <functional>
-#include <atomic>
-
-class Logger;
-
-class OrderBook {
-public:
-    using OrderPtr = std::shared_ptr<Order>;
-    using TradeCallback = std::function<void(const Order&, const Order&, double, uint32_t)>;
-
-    OrderBook();
-    void addOrder(OrderPtr order);
-    void cancelOrder(uint64_t orderId);
-    void setTradeCallback(TradeCallback cb);
-    double getBestBid() const;
-    double getBestAsk() const;
-    uint64_t getTotalTrades() const;
-
-private:
-    // Price -> queue of orders (FIFO for price-time priority)
-    std::map<double, std::deque<OrderPtr>, std::greater<double>> bids_;
-    std::map<double, std::deque<OrderPtr>, std::less<double>> asks_;
-    std::unordered_map<uint64_t, OrderPtr> orderMap_;
-    mutable std::mutex mtx_;
-    TradeCallback tradeCb_;
-    std::atomic<uint64_t> totalTrades_{0};
-    void match(OrderPtr order);
-    void executeTrade(OrderPtr buy, OrderPtr sell, double price, uint32_t qty);
-};
+#pragma once
+#include "Order.h"
+#include "PriceLevel.h"
+#include "OrderPool.h"
+#include "CompactOrder.h"
+#include "StopBook.h"
+#include "MarketData.h"
+#include "LatencyHistogram.h"
+#include "NodePool.h"
+#include "OrderIdMap.h"
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <atomic>
+
+class Logger;
+
+struct Trade {
+    uint64_t buyOrderId;
+    uint64_t sellOrderId;
+    double price;
+    uint32_t qty;
+};
+
+// Distributions recorded by the book itself. Times are nanoseconds with the
+// book lock held, so they measure the book's own work, not lock waits.
+struct BookLatencyStats {
+    LatencySnapshot service;    // Each new order and modify
+    LatencySnapshot cancel;     // Each cancel
+    LatencySnapshot matchDepth; // Resting orders each incoming order traded against
+};
+
+class OrderBook {
+public:
+    using OrderPtr = std::shared_ptr<Order>;
+    using TradeCallback = std::function<void(const Order&, const Order&, double, uint32_t)>;
+    // Receives every trade produced by one addOrder/addOrders call at once
+    using TradeBatchCallback = std::function<void(const std::vector<Trade>&)>;
+
+    explicit OrderBook(size_t poolCapacity = OrderPool::DEFAULT_CAPACITY,
+                       PoolMode poolMode = PoolMode::GROWABLE);
+    // Returns false if the order was rejected (invalid, duplicate resting id,
+    // or a FIXED pool with no free slots). The book matches and rests its own
+    // pooled copy, so the caller's order is left untouched. MARKET orders
+    // sweep without a price limit; MARKET, IOC and FOK residuals are dropped
+    // instead of resting, and a FOK that cannot fill completely does not
+    // trade at all. Neither counts as a rejection. STOP and STOP_LIMIT orders
+    // wait in a stop book until a trade reaches their stop price, then enter
+    // as MARKET or LIMIT orders; stops fired by a call's trades, including
+    // ones fired by other stops, are released before it returns. CANCEL and MODIFY
+    // orders are applied to the resting order with the same id instead, and
+    // return false if no such order is resting.
+    bool addOrder(const Order& order);
+    bool addOrder(OrderPtr order);
+    bool addOrder(const CompactOrder& order);
+    // Applies a whole batch under one lock acquisition; returns how many
+    // orders were accepted
+    size_t addOrders(const CompactOrder* orders, size_t count);
+    void cancelOrder(uint64_t orderId);
+    void reduceOrder(uint64_t orderId, uint32_t qty);
+    // Cancel-replace. quantity is the new total, filled quantity included.
+    // Keeping the price without growing the order keeps its queue position;
+    // otherwise it is matched again at the new price and rests at the back.
+    bool modifyOrder(uint64_t orderId, double price, uint32_t quantity);
+    void setTradeCallback(TradeCallback cb);
+    void setTradeBatchCallback(TradeBatchCallback cb);
+    // Streams a LevelUpdate for every visible level change made by the calls
+    // above. The caller owns the feed; nullptr stops the stream.
+    void setDepthFeed(DepthFeed* feed);
+    // Up to depth levels per side, consistent with the feed's sequence
+    DepthSnapshot getDepthSnapshot(size_t depth) const;
+    uint64_t getDroppedDepthUpdates() const;
+    // Streams an ExecutionReport for every fill. Reports are copied into the
+    // caller's preallocated feed under the book lock, so unlike the trade
+    // callbacks, matching never waits on what the consumer does with them.
+    // nullptr stops the stream.
+    void setExecutionFeed(ExecutionFeed* feed);
+    uint64_t getDroppedExecutionReports() const;
+    // Read the top of book published at the end of the last mutating call.
+    // They never take the book lock, so readers cannot stall matching.
+    double getBestBid() const;
+    double getBestAsk() const;
+    TopOfBook getTopOfBook() const;
+    uint64_t getTotalTrades() const;
+    size_t getPendingStops() const;
+    OrderPool::Stats getPoolStats() const;
+    // Room for count more resting orders without allocating: a fresh pool
+    // slab and level node slab, and an id map rebuilt for them, all touched
+    // by the calling thread so the pages land on its NUMA node. The fresh
+    // slabs are used before the ones made when the book was constructed.
+    void reserveOrders(size_t count);
+    // Always recorded; reading never takes the book lock, so a monitoring
+    // thread can poll it without pausing matching
+    BookLatencyStats getLatencyStats() const;
+
+    // Snapshot support. forEachResting visits every resting order, each side
+    // best price first and each level in FIFO order, then the pending stops
+    // in trigger order; restoring them in that order rebuilds the book and
+    // its id map exactly. It takes no lock, so call it only where nothing
+    // else can change the book: the thread applying its orders, or a forked
+    // child holding a copy of it. getLastTradePrice has the same rule.
+    void forEachResting(const std::function<void(const Order&)>& visit) const;
+    double getLastTradePrice() const;
+    // Rests a copy of order exactly as given, without matching it or
+    // starting a fresh iceberg slice. Returns false if the id is already
+    // resting or the pool is full. For loading a snapshot into an empty book.
+    bool restoreResting(const Order& order);
+    void restoreLastTradePrice(double price);
+
+private:
+    // Pool handle for a resting order plus the level it is linked into (a
+    // stop book level while the order is a pending stop)
+    struct RestingOrder {
+        Order* order;
+        PriceLevel* level;
+    };
+
+    // One node per price level, bids, asks and stop prices alike. Levels never
+    // outnumber pooled orders, so a FIXED book sized by its pool stops
+    // allocating once constructed.
+    NodePool levelNodes_;
+    // Price -> queue of orders (FIFO for price-time priority)
+    LevelMap<std::greater<double>> bids_;
+    LevelMap<std::less<double>> asks_;
+    OrderIdMap<RestingOrder> orderMap_;
+    OrderPool pool_;
+    mutable std::mutex mtx_;
+    TradeCallback tradeCb_;
+    TradeBatchCallback tradeBatchCb_;
+    std::vector<Trade> pendingTrades_;
+    std::atomic<uint64_t> totalTrades_{0};
+    StopBook stops_;
+    PriceLevel triggeredStops_;     // Fired, waiting to be admitted in order
+    double lastTradePrice_ = 0.0;
+    bool releasingStops_ = false;
+    DepthPublisher depth_;
+    ExecutionPublisher executions_;
+    SeqlockTopOfBook top_;
+    LatencyHistogram serviceNs_;    // Written only under mtx_
+    LatencyHistogram cancelNs_;
+    LatencyHistogram matchDepth_;
+    bool admitCompact(const CompactOrder& order);
+    bool admit(Order* pooled);
+    bool cancelResting(uint64_t orderId);
+    bool modifyResting(uint64_t orderId, double price, uint32_t quantity);
+    void flushTrades();
+    void publishTop();
+    void recordService(OrderType type, uint64_t startNs);
+    void releaseStops();
+    bool canFill(const Order& order) const;
+    void match(Order& order);
+    void fillResting(PriceLevel& level, Order* resting, uint32_t qty);
+    void rest(Order* order);
+    void place(Order* order);
+    void unlink(RestingOrder resting);
+    // Takes a resting order off its level and out of the id map, keeping it pooled
+    Order* detach(RestingOrder resting);
+    void executeTrade(Order& buy, Order& sell, double price, uint32_t qty, OrderSide aggressor);
+    void publishLevel(OrderSide side, double price, const PriceLevel& level);
+};
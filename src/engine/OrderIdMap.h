@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Order id -> Value table with open addressing and linear probing, sized up
+// front so inserts and erases never allocate: the table only rehashes when
+// it passes half full, which a book whose pool bounds its resting orders
+// never reaches after reserve(). Erase shifts the rest of the probe run back
+// instead of leaving tombstones, so lookups stay short under churn.
+template<typename Value>
+class OrderIdMap {
+public:
+    explicit OrderIdMap(size_t count = 0) { reserve(count); }
+
+    // Room for count ids without rehashing
+    void reserve(size_t count) {
+        size_t slots = slotsFor(count);
+        if (slots > slots_.size()) rehash(slots);
+    }
+
+    // As reserve, but always moves the table into memory the calling thread
+    // allocates, and so first-touches
+    void rebuild(size_t count) {
+        rehash(std::max(slotsFor(count), slotsFor(size_)));
+    }
+
+    Value* find(uint64_t id) {
+        for (size_t i = indexOf(id);; i = (i + 1) & mask_) {
+            Slot& slot = slots_[i];
+            if (!slot.used) return nullptr;
+            if (slot.id == id) return &slot.value;
+        }
+    }
+
+    bool contains(uint64_t id) const {
+        return const_cast<OrderIdMap*>(this)->find(id) != nullptr;
+    }
+
+    // Returns false if the id is already present
+    bool insert(uint64_t id, const Value& value) {
+        if ((size_ + 1) * 2 > slots_.size()) rehash(slots_.size() * 2);
+        size_t i = indexOf(id);
+        for (; slots_[i].used; i = (i + 1) & mask_) {
+            if (slots_[i].id == id) return false;
+        }
+        slots_[i] = Slot{id, value, true};
+        size_++;
+        return true;
+    }
+
+    bool erase(uint64_t id) {
+        size_t i = indexOf(id);
+        for (; slots_[i].id != id; i = (i + 1) & mask_) {
+            if (!slots_[i].used) return false;
+        }
+        if (!slots_[i].used) return false;
+        // Pull later entries of the run into the hole when their home slot
+        // does not lie cyclically in (hole, current]
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask_; slots_[j].used; j = (j + 1) & mask_) {
+            size_t home = indexOf(slots_[j].id);
+            if (((j - home) & mask_) >= ((j - hole) & mask_)) {
+                slots_[hole] = slots_[j];
+                hole = j;
+            }
+        }
+        slots_[hole].used = false;
+        size_--;
+        return true;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    static size_t slotsFor(size_t count) {
+        size_t slots = 16;
+        while (slots < count * 2) slots <<= 1;
+        return slots;
+    }
+
+    struct Slot {
+        uint64_t id;
+        Value value;
+        bool used;
+    };
+
+    // Fibonacci hashing spreads the sequential ids most feeds use
+    size_t indexOf(uint64_t id) const {
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    void rehash(size_t slots) {
+        std::vector<Slot> old(slots, Slot{});
+        old.swap(slots_);
+        mask_ = slots - 1;
+        shift_ = 64;
+        for (size_t n = slots; n > 1; n >>= 1) shift_--;
+        size_ = 0;
+        for (const Slot& slot : old) {
+            if (slot.used) insert(slot.id, slot.value);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    unsigned shift_ = 64;
+    size_t size_ = 0;
+};
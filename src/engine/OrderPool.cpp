@@ -0,0 +1,58 @@
+#include "OrderPool.h"
+#include <algorithm>
+
+OrderPool::OrderPool(size_t capacity, PoolMode mode)
+    : mode_(mode), slabSize_(std::max<size_t>(capacity, 1)) {
+    // Warm-up: construct (and so first-touch) the whole initial slab now
+    addSlab(slabSize_);
+}
+
+Order* OrderPool::acquire() {
+    if (!freeList_) {
+        if (mode_ == PoolMode::FIXED) {
+            failedAcquires_++;
+            return nullptr;
+        }
+        addSlab(slabSize_);
+    }
+    Order* order = freeList_;
+    freeList_ = order->nextInLevel;
+    order->prevInLevel = nullptr;
+    order->nextInLevel = nullptr;
+    inUse_++;
+    highWaterMark_ = std::max(highWaterMark_, inUse_);
+    return order;
+}
+
+Order* OrderPool::acquire(const Order& source) {
+    Order* order = acquire();
+    if (order) *order = source;
+    return order;
+}
+
+void OrderPool::release(Order* order) {
+    if (!order) return;
+    order->prevInLevel = nullptr;
+    order->nextInLevel = freeList_;
+    freeList_ = order;
+    inUse_--;
+}
+
+OrderPool::Stats OrderPool::getStats() const {
+    return Stats{capacity_, inUse_, highWaterMark_, slabs_.size(), failedAcquires_};
+}
+
+void OrderPool::reserve(size_t count) {
+    if (count > 0) addSlab(count);
+}
+
+void OrderPool::addSlab(size_t count) {
+    std::unique_ptr<Order[]> slab(new Order[count]);
+    // Thread the new slab onto the freelist so the lowest address is used first
+    for (size_t i = count; i-- > 0;) {
+        slab[i].nextInLevel = freeList_;
+        freeList_ = &slab[i];
+    }
+    slabs_.push_back(std::move(slab));
+    capacity_ += count;
+}
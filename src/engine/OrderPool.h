@@ -0,0 +1,57 @@
+#pragma once
+#include "Order.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+enum class PoolMode {
+    GROWABLE,   // Add a slab when the freelist runs dry
+    FIXED       // Preallocate everything up front; acquire() never allocates
+};
+
+// Slab allocator for resting orders. Orders live in fixed slabs, so the
+// pointer handed out by acquire() stays valid until it is released, and
+// released orders go back on an intrusive freelist (threaded through
+// Order::nextInLevel) for reuse. Not thread-safe: the owning book guards it.
+class OrderPool {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    struct Stats {
+        size_t capacity;        // Orders preallocated across all slabs
+        size_t inUse;           // Orders currently handed out
+        size_t highWaterMark;   // Peak of inUse
+        size_t slabs;
+        uint64_t failedAcquires; // FIXED mode requests refused when exhausted
+    };
+
+    explicit OrderPool(size_t capacity = DEFAULT_CAPACITY, PoolMode mode = PoolMode::GROWABLE);
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    // Return nullptr when a FIXED pool is exhausted. The bare overload hands
+    // back a slot with stale contents for the caller to overwrite.
+    Order* acquire();
+    Order* acquire(const Order& source);
+    void release(Order* order);
+    // Adds a slab of count orders, even in FIXED mode and however many are
+    // already free. The slab is constructed, and so first-touched, by the
+    // calling thread and goes to the front of the freelist, so the next count
+    // acquires come from it before any older slot.
+    void reserve(size_t count);
+
+    Stats getStats() const;
+    PoolMode getMode() const { return mode_; }
+
+private:
+    void addSlab(size_t count);
+
+    std::vector<std::unique_ptr<Order[]>> slabs_;
+    Order* freeList_ = nullptr;
+    PoolMode mode_;
+    size_t slabSize_;
+    size_t capacity_ = 0;
+    size_t inUse_ = 0;
+    size_t highWaterMark_ = 0;
+    uint64_t failedAcquires_ = 0;
+};
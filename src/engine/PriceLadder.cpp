@@ -0,0 +1,255 @@
+#include "PriceLadder.h"
+#include <algorithm>
+#include <climits>
+#include <iterator>
+
+void LevelBitmap::resize(size_t slots) {
+    size_t words = (slots + 63) / 64;
+    words_.assign(words, 0);
+    summary_.assign((words + 63) / 64, 0);
+    occupied_ = 0;
+}
+
+void LevelBitmap::set(size_t slot) {
+    size_t w = slot >> 6;
+    uint64_t bit = 1ULL << (slot & 63);
+    if (words_[w] & bit) return;
+    words_[w] |= bit;
+    summary_[w >> 6] |= 1ULL << (w & 63);
+    occupied_++;
+}
+
+void LevelBitmap::clear(size_t slot) {
+    size_t w = slot >> 6;
+    uint64_t bit = 1ULL << (slot & 63);
+    if (!(words_[w] & bit)) return;
+    words_[w] &= ~bit;
+    if (words_[w] == 0) summary_[w >> 6] &= ~(1ULL << (w & 63));
+    occupied_--;
+}
+
+bool LevelBitmap::test(size_t slot) const {
+    return (words_[slot >> 6] >> (slot & 63)) & 1ULL;
+}
+
+int64_t LevelBitmap::highest() const {
+    if (occupied_ == 0) return -1;
+    for (size_t s = summary_.size(); s-- > 0;) {
+        if (summary_[s] == 0) continue;
+        size_t w = s * 64 + (63 - __builtin_clzll(summary_[s]));
+        return static_cast<int64_t>(w * 64 + (63 - __builtin_clzll(words_[w])));
+    }
+    return -1;
+}
+
+int64_t LevelBitmap::lowest() const {
+    if (occupied_ == 0) return -1;
+    for (size_t s = 0; s < summary_.size(); ++s) {
+        if (summary_[s] == 0) continue;
+        size_t w = s * 64 + __builtin_ctzll(summary_[s]);
+        return static_cast<int64_t>(w * 64 + __builtin_ctzll(words_[w]));
+    }
+    return -1;
+}
+
+int64_t LevelBitmap::nextAbove(size_t slot) const {
+    size_t start = slot + 1;
+    size_t w = start >> 6;
+    if (w >= words_.size()) return -1;
+    uint64_t bits = words_[w] & (~0ULL << (start & 63));
+    if (bits) return static_cast<int64_t>(w * 64 + __builtin_ctzll(bits));
+    // Let the summary skip runs of empty words
+    size_t nextWord = w + 1;
+    size_t s = nextWord >> 6;
+    if (s >= summary_.size()) return -1;
+    uint64_t words = summary_[s] & (~0ULL << (nextWord & 63));
+    while (!words) {
+        if (++s >= summary_.size()) return -1;
+        words = summary_[s];
+    }
+    size_t found = s * 64 + __builtin_ctzll(words);
+    return static_cast<int64_t>(found * 64 + __builtin_ctzll(words_[found]));
+}
+
+int64_t LevelBitmap::nextBelow(size_t slot) const {
+    if (slot == 0) return -1;
+    size_t start = slot - 1;
+    size_t w = start >> 6;
+    uint64_t bits = words_[w] & (~0ULL >> (63 - (start & 63)));
+    if (bits) return static_cast<int64_t>(w * 64 + (63 - __builtin_clzll(bits)));
+    if (w == 0) return -1;
+    size_t prevWord = w - 1;
+    size_t s = prevWord >> 6;
+    uint64_t words = summary_[s] & (~0ULL >> (63 - (prevWord & 63)));
+    while (!words) {
+        if (s == 0) return -1;
+        words = summary_[--s];
+    }
+    size_t found = s * 64 + (63 - __builtin_clzll(words));
+    return static_cast<int64_t>(found * 64 + (63 - __builtin_clzll(words_[found])));
+}
+
+PriceLadder::PriceLadder(size_t initialLevels, size_t maxLevels)
+    : levels_(std::max<size_t>(initialLevels, 64)),
+      maxLevels_(std::max(maxLevels, levels_.size())) {
+    bidBits_.resize(levels_.size());
+    askBits_.resize(levels_.size());
+}
+
+PriceLadder::Level& PriceLadder::levelAt(int64_t tick, OrderSide side) {
+    if (!anchored_) {
+        // Center the window on the first price seen
+        baseTick_ = tick - static_cast<int64_t>(levels_.size() / 2);
+        anchored_ = true;
+    }
+    if (!inWindow(tick)) grow(tick);
+    if (inWindow(tick)) return levels_[slotOf(tick)];
+    return overflowFor(side)[tick];
+}
+
+PriceLadder::Level* PriceLadder::findLevel(int64_t tick) {
+    if (anchored_ && inWindow(tick)) return &levels_[slotOf(tick)];
+    auto it = overflowBids_.find(tick);
+    if (it != overflowBids_.end()) return &it->second;
+    it = overflowAsks_.find(tick);
+    if (it != overflowAsks_.end()) return &it->second;
+    return nullptr;
+}
+
+const PriceLadder::Level* PriceLadder::findLevel(int64_t tick) const {
+    return const_cast<PriceLadder*>(this)->findLevel(tick);
+}
+
+void PriceLadder::markOccupied(int64_t tick, OrderSide side) {
+    // Overflow levels are occupied for as long as their map entry exists
+    if (inWindow(tick)) (side == OrderSide::BUY ? bidBits_ : askBits_).set(slotOf(tick));
+}
+
+void PriceLadder::markEmpty(int64_t tick, OrderSide side) {
+    if (inWindow(tick)) {
+        (side == OrderSide::BUY ? bidBits_ : askBits_).clear(slotOf(tick));
+    } else {
+        overflowFor(side).erase(tick);
+    }
+}
+
+bool PriceLadder::hasOrders(OrderSide side) const {
+    if (side == OrderSide::BUY) return !bidBits_.empty() || !overflowBids_.empty();
+    return !askBits_.empty() || !overflowAsks_.empty();
+}
+
+int64_t PriceLadder::bestBidTick() const {
+    int64_t best = INT64_MIN;
+    if (!bidBits_.empty()) best = baseTick_ + bidBits_.highest();
+    if (!overflowBids_.empty()) best = std::max(best, overflowBids_.rbegin()->first);
+    return best;
+}
+
+int64_t PriceLadder::bestAskTick() const {
+    int64_t best = INT64_MAX;
+    if (!askBits_.empty()) best = baseTick_ + askBits_.lowest();
+    if (!overflowAsks_.empty()) best = std::min(best, overflowAsks_.begin()->first);
+    return best;
+}
+
+bool PriceLadder::nextLevel(OrderSide side, int64_t tick, int64_t& next) const {
+    int64_t end = baseTick_ + static_cast<int64_t>(levels_.size());
+    int64_t slot = -1;
+    bool found = false;
+    if (side == OrderSide::BUY) {
+        if (tick >= end) slot = bidBits_.highest();
+        else if (tick > baseTick_) slot = bidBits_.nextBelow(slotOf(tick));
+        if (slot >= 0) {
+            next = baseTick_ + slot;
+            found = true;
+        }
+        auto it = overflowBids_.lower_bound(tick);
+        if (it != overflowBids_.begin() && (!found || std::prev(it)->first > next)) {
+            next = std::prev(it)->first;
+            found = true;
+        }
+    } else {
+        if (tick < baseTick_) slot = askBits_.lowest();
+        else if (tick < end) slot = askBits_.nextAbove(slotOf(tick));
+        if (slot >= 0) {
+            next = baseTick_ + slot;
+            found = true;
+        }
+        auto it = overflowAsks_.upper_bound(tick);
+        if (it != overflowAsks_.end() && (!found || it->first < next)) {
+            next = it->first;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void PriceLadder::grow(int64_t tick) {
+    int64_t size = static_cast<int64_t>(levels_.size());
+    if (bidBits_.empty() && askBits_.empty()) {
+        // Nothing rests in the window, so re-centering is just moving it
+        baseTick_ = tick - size / 2;
+        rebase(baseTick_, levels_.size());
+        return;
+    }
+    int64_t oldBase = baseTick_;
+    int64_t oldEnd = baseTick_ + size;
+    int64_t lo = std::min(oldBase, tick);
+    int64_t hi = std::max(oldEnd, tick + 1);
+    uint64_t span = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+
+    if (span > maxLevels_) {
+        // A far-away price must not size the window; grow to the cap toward
+        // it and let levelAt park it in the overflow map if still outside
+        if (levels_.size() < maxLevels_) {
+            int64_t cap = static_cast<int64_t>(maxLevels_);
+            rebase(tick < oldBase ? oldEnd - cap : oldBase, maxLevels_);
+        }
+        return;
+    }
+
+    // At least double so repeated out-of-window prices stay amortized O(1),
+    // and keep the old window roughly centered in the new one
+    size_t newSize = std::min(std::max<size_t>(levels_.size() * 2, span * 2), maxLevels_);
+    int64_t slack = static_cast<int64_t>(newSize - span);
+    rebase(lo - slack / 2, newSize);
+}
+
+// Moves the window to [newBase, newBase + newSize). Occupied levels that fall
+// outside it go to the overflow maps, and overflow levels inside it come back.
+void PriceLadder::rebase(int64_t newBase, size_t newSize) {
+    if (newBase != baseTick_ || newSize != levels_.size()) {
+        std::vector<Level> levels(newSize);
+        LevelBitmap bids, asks;
+        bids.resize(newSize);
+        asks.resize(newSize);
+        int64_t newEnd = newBase + static_cast<int64_t>(newSize);
+        for (size_t i = 0; i < levels_.size(); ++i) {
+            bool bid = bidBits_.test(i);
+            if (!bid && !askBits_.test(i)) continue;
+            int64_t tick = baseTick_ + static_cast<int64_t>(i);
+            if (tick >= newBase && tick < newEnd) {
+                size_t slot = static_cast<size_t>(tick - newBase);
+                (bid ? bids : asks).set(slot);
+                levels[slot] = std::move(levels_[i]);
+            } else {
+                overflowFor(bid ? OrderSide::BUY : OrderSide::SELL).emplace(tick, std::move(levels_[i]));
+            }
+        }
+        levels_ = std::move(levels);
+        bidBits_ = std::move(bids);
+        askBits_ = std::move(asks);
+        baseTick_ = newBase;
+    }
+    for (OrderSide side : {OrderSide::BUY, OrderSide::SELL}) {
+        Overflow& overflow = overflowFor(side);
+        auto first = overflow.lower_bound(baseTick_);
+        auto last = overflow.lower_bound(baseTick_ + static_cast<int64_t>(levels_.size()));
+        for (auto it = first; it != last; ++it) {
+            size_t slot = slotOf(it->first);
+            levels_[slot] = std::move(it->second);
+            (side == OrderSide::BUY ? bidBits_ : askBits_).set(slot);
+        }
+        overflow.erase(first, last);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "PriceLevel.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Two-level occupancy bitmap over ladder slots. The summary word marks which
+// 64-slot words are non-empty, so the highest/lowest occupied slot is found
+// with a handful of bit scans instead of walking the levels.
+class LevelBitmap {
+public:
+    void resize(size_t slots);
+    void set(size_t slot);
+    void clear(size_t slot);
+    bool test(size_t slot) const;
+    bool empty() const { return occupied_ == 0; }
+
+    // Return -1 when no slot is occupied
+    int64_t highest() const;
+    int64_t lowest() const;
+    // Nearest occupied slot strictly above/below slot, or -1
+    int64_t nextAbove(size_t slot) const;
+    int64_t nextBelow(size_t slot) const;
+
+private:
+    std::vector<uint64_t> words_;
+    std::vector<uint64_t> summary_;
+    size_t occupied_ = 0;
+};
+
+// Contiguous array of price levels indexed by integer tick, centered on the
+// first price it sees and grown (re-centered) when a price falls outside the
+// current window. Bids and asks share the same slots: a non-crossed book never
+// has both sides resting at one tick, so each side only needs its own bitmap.
+// The window never grows past maxLevels; prices beyond it rest in a sparse
+// per-side overflow map, and an empty window re-centers on the next price.
+class PriceLadder {
+public:
+    using Level = PriceLevel;
+
+    static constexpr size_t DEFAULT_MAX_LEVELS = 1 << 16;
+
+    explicit PriceLadder(size_t initialLevels = 4096, size_t maxLevels = DEFAULT_MAX_LEVELS);
+
+    // Returns the level for a tick, growing the window or falling back to
+    // the side's overflow map as needed
+    Level& levelAt(int64_t tick, OrderSide side);
+    // Returns nullptr if no level exists for the tick
+    Level* findLevel(int64_t tick);
+    const Level* findLevel(int64_t tick) const;
+
+    void markOccupied(int64_t tick, OrderSide side);
+    void markEmpty(int64_t tick, OrderSide side);
+    bool hasOrders(OrderSide side) const;
+
+    // Best level per side; only valid when hasOrders(side)
+    int64_t bestBidTick() const;
+    int64_t bestAskTick() const;
+    // Steps from tick to the next occupied level further from the touch
+    // (lower for bids, higher for asks); returns false when there is none
+    bool nextLevel(OrderSide side, int64_t tick, int64_t& next) const;
+
+    size_t capacity() const { return levels_.size(); }
+    size_t overflowLevels() const { return overflowBids_.size() + overflowAsks_.size(); }
+
+private:
+    using Overflow = std::map<int64_t, Level>;
+
+    void grow(int64_t tick);
+    void rebase(int64_t newBase, size_t newSize);
+    bool inWindow(int64_t tick) const {
+        return tick >= baseTick_ && tick < baseTick_ + static_cast<int64_t>(levels_.size());
+    }
+    size_t slotOf(int64_t tick) const { return static_cast<size_t>(tick - baseTick_); }
+    Overflow& overflowFor(OrderSide side) { return side == OrderSide::BUY ? overflowBids_ : overflowAsks_; }
+
+    std::vector<Level> levels_;
+    LevelBitmap bidBits_;
+    LevelBitmap askBits_;
+    Overflow overflowBids_;
+    Overflow overflowAsks_;
+    size_t maxLevels_;
+    int64_t baseTick_ = 0;
+    bool anchored_ = false;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include "Order.h"
+#include "NodePool.h"
+#include <cstdint>
+#include <map>
+#include <utility>
+
+// FIFO queue of resting orders at one price, linked through the intrusive
+// prevInLevel/nextInLevel hooks on Order. Push, front and unlink are O(1),
+// so cancelling from the middle of a deep level never scans it. totalQty is
+// the sum of remainingQty over the queue and displayedQty the sum of what
+// each order shows (iceberg reserves excluded); the owning book calls
+// reduce() whenever it shrinks a queued order in place.
+struct PriceLevel {
+    Order* head = nullptr;
+    Order* tail = nullptr;
+    uint32_t orderCount = 0;
+    uint64_t totalQty = 0;
+    uint64_t displayedQty = 0;
+
+    bool empty() const { return head == nullptr; }
+    Order* front() const { return head; }
+
+    void pushBack(Order* order) {
+        order->prevInLevel = tail;
+        order->nextInLevel = nullptr;
+        if (tail) tail->nextInLevel = order;
+        else head = order;
+        tail = order;
+        orderCount++;
+        totalQty += order->remainingQty;
+        displayedQty += order->shownQty();
+    }
+
+    void remove(Order* order) {
+        if (order->prevInLevel) order->prevInLevel->nextInLevel = order->nextInLevel;
+        else head = order->nextInLevel;
+        if (order->nextInLevel) order->nextInLevel->prevInLevel = order->prevInLevel;
+        else tail = order->prevInLevel;
+        order->prevInLevel = nullptr;
+        order->nextInLevel = nullptr;
+        orderCount--;
+        totalQty -= order->remainingQty;
+        displayedQty -= order->shownQty();
+    }
+
+    void reduce(uint32_t qty, uint32_t shown) {
+        totalQty -= qty;
+        displayedQty -= shown;
+    }
+
+    // Requeues an iceberg whose visible slice is used up at the back with a
+    // fresh slice: two O(1) relinks, no allocation
+    void replenish(Order* order) {
+        remove(order);
+        order->showNextSlice();
+        pushBack(order);
+    }
+};
+
+// Price -> level map whose nodes come from the owning book's NodePool
+template<typename Compare>
+using LevelMap = std::map<double, PriceLevel, Compare,
+                          NodeAllocator<std::pair<const double, PriceLevel>>>;
+
+// Block size that fits a LevelMap node: the value plus the tree's three
+// links and colour
+constexpr size_t LEVEL_NODE_SIZE = sizeof(std::pair<const double, PriceLevel>) + 4 * sizeof(void*);
@@ -0,0 +1,207 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free ring buffers for handing messages to a single consumer.
+// Capacities are rounded up to a power of two. Producer and consumer indices
+// sit on their own cache lines so the two sides never false-share.
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+inline size_t roundUpPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// Single producer, single consumer. Each side keeps a cached copy of the
+// other side's index and only re-reads the shared atomic when the cache says
+// the ring is full (producer) or empty (consumer).
+template<typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(size_t capacity)
+        : capacity_(roundUpPowerOfTwo(capacity < 2 ? 2 : capacity)),
+          mask_(capacity_ - 1),
+          buffer_(new T[capacity_]) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer side; returns false when the ring is full
+    bool tryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ >= capacity_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ >= capacity_) return false;
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side; pushes as many as fit and publishes them with a
+    // single tail update. Returns the number pushed.
+    size_t tryPushBatch(const T* values, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t free = capacity_ - (tail - cachedHead_);
+        if (free < count) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            free = capacity_ - (tail - cachedHead_);
+        }
+        size_t n = count < free ? count : free;
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[(tail + i) & mask_] = values[i];
+        }
+        if (n) tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Producer side; slots that a push is guaranteed to get. Only the
+    // consumer can change the answer, and only by freeing more.
+    size_t freeSlots() {
+        cachedHead_ = head_.load(std::memory_order_acquire);
+        return capacity_ - (tail_.load(std::memory_order_relaxed) - cachedHead_);
+    }
+
+    // Consumer side; returns false when the ring is empty
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        out = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; drains up to maxCount with a single head update
+    size_t tryPopBatch(T* out, size_t maxCount) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        size_t available = cachedTail_ - head;
+        size_t n = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = buffer_[(head + i) & mask_];
+        }
+        if (n) head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> buffer_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;     // Producer-owned
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;     // Consumer-owned
+};
+
+// Multiple producers, single consumer. Each slot carries a sequence number
+// (Vyukov's bounded queue): producers claim a position with a CAS on the
+// tail and publish the slot by bumping its sequence, so a slow producer
+// never lets the consumer read a half-written value.
+template<typename T>
+class MpscRingBuffer {
+public:
+    explicit MpscRingBuffer(size_t capacity)
+        : capacity_(roundUpPowerOfTwo(capacity < 2 ? 2 : capacity)),
+          mask_(capacity_ - 1),
+          slots_(new Slot[capacity_]) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    // Any producer thread; returns false when the ring is full
+    bool tryPush(const T& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = value;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer thread; returns false when the ring is empty
+    bool tryPop(T& out) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        out = slot.value;
+        slot.sequence.store(pos + capacity_, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer thread; drains published slots up to maxCount and
+    // stops at the first slot a producer has claimed but not yet written
+    size_t tryPopBatch(T* out, size_t maxCount) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        size_t n = 0;
+        while (n < maxCount) {
+            Slot& slot = slots_[(pos + n) & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + n + 1) break;
+            out[n] = slot.value;
+            slot.sequence.store(pos + n + capacity_, std::memory_order_release);
+            n++;
+        }
+        if (n) head_.store(pos + n, std::memory_order_release);
+        return n;
+    }
+
+    bool empty() const {
+        size_t pos = head_.load(std::memory_order_acquire);
+        return slots_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    size_t size() const {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+};
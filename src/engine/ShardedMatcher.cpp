@@ -0,0 +1,99 @@
+#include "ShardedMatcher.h"
+#include <algorithm>
+#include <stdexcept>
+
+ShardedMatcher::ShardedMatcher(BookRegistry& books, Logger& logger, size_t shardCount,
+                               MatcherConfig config) {
+    shardCount = std::max<size_t>(shardCount, 1);
+    if (config.journal && shardCount > 1) {
+        throw std::invalid_argument("A journal has one writer; give each shard its own matcher");
+    }
+    config.ingress = IngressMode::MPSC_RING;
+    int firstCpu = config.cpu;
+    for (size_t i = 0; i < shardCount; ++i) {
+        if (firstCpu >= 0) config.cpu = firstCpu + static_cast<int>(i);
+        shards_.push_back(std::make_unique<Matcher>(books, logger, config));
+    }
+}
+
+void ShardedMatcher::start() {
+    for (auto& shard : shards_) shard->start();
+}
+
+void ShardedMatcher::stop() {
+    for (auto& shard : shards_) shard->stop();
+}
+
+bool ShardedMatcher::submitOrder(const Order& order) {
+    CompactOrder compact;
+    if (!CompactOrder::fromOrder(order, compact)) {
+        refusedOrders_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    submitOrder(compact);
+    return true;
+}
+
+void ShardedMatcher::submitOrder(const CompactOrder& order) {
+    shards_[shardFor(order.symbolId)]->submitOrder(order);
+}
+
+bool ShardedMatcher::trySubmitOrder(const CompactOrder& order) {
+    return shards_[shardFor(order.symbolId)]->trySubmitOrder(order);
+}
+
+size_t ShardedMatcher::submitBatch(const std::vector<Order>& orders) {
+    std::vector<std::vector<CompactOrder>> perShard(shards_.size());
+    size_t count = 0;
+    for (const auto& order : orders) {
+        CompactOrder compact;
+        if (!CompactOrder::fromOrder(order, compact)) {
+            refusedOrders_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        perShard[shardFor(compact.symbolId)].push_back(compact);
+        count++;
+    }
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        if (!perShard[i].empty()) shards_[i]->submitBatch(perShard[i].data(), perShard[i].size());
+    }
+    return count;
+}
+
+size_t ShardedMatcher::shardFor(uint32_t symbolId) const {
+    // Fibonacci hashing spreads the dense interned ids evenly
+    uint64_t h = static_cast<uint64_t>(symbolId) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>((h >> 32) % shards_.size());
+}
+
+size_t ShardedMatcher::getShardCount() const {
+    return shards_.size();
+}
+
+uint64_t ShardedMatcher::getProcessedOrders() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) total += shard->getProcessedOrders();
+    return total;
+}
+
+uint64_t ShardedMatcher::getProcessedOrders(size_t shard) const {
+    return shard < shards_.size() ? shards_[shard]->getProcessedOrders() : 0;
+}
+
+uint64_t ShardedMatcher::getRefusedOrders() const {
+    return refusedOrders_.load();
+}
+
+bool ShardedMatcher::isHalted() const {
+    return std::any_of(shards_.begin(), shards_.end(), [](const auto& shard) { return shard->isHalted(); });
+}
+
+LatencySnapshot ShardedMatcher::getQueueWait() const {
+    LatencySnapshot total;
+    for (const auto& shard : shards_) total.merge(shard->getQueueWait());
+    return total;
+}
+
+LatencySnapshot ShardedMatcher::getQueueWait(size_t shard) const {
+    return shard < shards_.size() ? shards_[shard]->getQueueWait() : LatencySnapshot();
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "Matcher.h"
+#include <vector>
+
+// Runs one Matcher worker per shard over a shared BookRegistry. Symbols are
+// hash-partitioned across shards, so every book is only ever touched by its
+// shard's thread and its lock is never contended by other matchers. Each
+// shard's ingress is an MPSC ring, so any number of threads may submit.
+class ShardedMatcher {
+public:
+    // config.cpu, when set, pins shard i to cpu + i
+    ShardedMatcher(BookRegistry& books, Logger& logger, size_t shardCount,
+                   MatcherConfig config = MatcherConfig());
+    void start();
+    void stop();
+    // Refuses the orders Matcher::submitOrder refuses
+    bool submitOrder(const Order& order);
+    void submitOrder(const CompactOrder& order);
+    bool trySubmitOrder(const CompactOrder& order);
+    // Splits the batch per shard and submits each part in one call, skipping
+    // refused orders; returns how many were submitted
+    size_t submitBatch(const std::vector<Order>& orders);
+
+    size_t shardFor(uint32_t symbolId) const;
+    size_t getShardCount() const;
+    uint64_t getProcessedOrders() const;
+    uint64_t getProcessedOrders(size_t shard) const;
+    uint64_t getRefusedOrders() const;
+    // True once any shard has halted on a journal failure
+    bool isHalted() const;
+    // Queue wait merged across shards, or of one shard
+    LatencySnapshot getQueueWait() const;
+    LatencySnapshot getQueueWait(size_t shard) const;
+
+private:
+    std::vector<std::unique_ptr<Matcher>> shards_;
+    std::atomic<uint64_t> refusedOrders_{0};
+};
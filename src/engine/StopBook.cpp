@@ -0,0 +1,70 @@
+#include "StopBook.h"
+
+StopBook::StopBook(NodePool* nodes)
+    : buyStops_(LevelMap<std::less<double>>::allocator_type(nodes)),
+      sellStops_(LevelMap<std::greater<double>>::allocator_type(nodes)) {}
+
+PriceLevel* StopBook::add(Order* order) {
+    PriceLevel* level = order->side == OrderSide::BUY ? &buyStops_[order->stopPrice]
+                                                      : &sellStops_[order->stopPrice];
+    level->pushBack(order);
+    count_++;
+    return level;
+}
+
+void StopBook::remove(Order* order) {
+    if (order->side == OrderSide::BUY) {
+        auto it = buyStops_.find(order->stopPrice);
+        it->second.remove(order);
+        if (it->second.empty()) buyStops_.erase(it);
+    } else {
+        auto it = sellStops_.find(order->stopPrice);
+        it->second.remove(order);
+        if (it->second.empty()) sellStops_.erase(it);
+    }
+    count_--;
+}
+
+PriceLevel& StopBook::levelOf(const Order& order) {
+    return order.side == OrderSide::BUY ? buyStops_.find(order.stopPrice)->second
+                                        : sellStops_.find(order.stopPrice)->second;
+}
+
+void StopBook::trigger(double price, PriceLevel& out) {
+    while (!buyStops_.empty() && buyStops_.begin()->first <= price) {
+        moveLevel(buyStops_.begin()->second, out);
+        buyStops_.erase(buyStops_.begin());
+    }
+    while (!sellStops_.empty() && sellStops_.begin()->first >= price) {
+        moveLevel(sellStops_.begin()->second, out);
+        sellStops_.erase(sellStops_.begin());
+    }
+}
+
+void StopBook::forEach(const std::function<void(const Order&)>& visit) const {
+    for (const auto& entry : buyStops_) {
+        for (const Order* order = entry.second.front(); order; order = order->nextInLevel) visit(*order);
+    }
+    for (const auto& entry : sellStops_) {
+        for (const Order* order = entry.second.front(); order; order = order->nextInLevel) visit(*order);
+    }
+}
+
+bool StopBook::isTriggered(const Order& order, double lastPrice) {
+    if (lastPrice <= 0.0) return false;
+    return order.side == OrderSide::BUY ? lastPrice >= order.stopPrice
+                                        : lastPrice <= order.stopPrice;
+}
+
+void StopBook::activate(Order& order) {
+    order.type = order.type == OrderType::STOP ? OrderType::MARKET : OrderType::LIMIT;
+}
+
+void StopBook::moveLevel(PriceLevel& level, PriceLevel& out) {
+    while (!level.empty()) {
+        Order* order = level.front();
+        level.remove(order);
+        out.pushBack(order);
+        count_--;
+    }
+}
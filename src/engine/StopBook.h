@@ -0,0 +1,46 @@
+#pragma once
+#include "PriceLevel.h"
+#include <cstddef>
+#include <functional>
+
+// Pending STOP and STOP_LIMIT orders, one map per side ordered by trigger
+// price: buy stops lowest first, sell stops highest first. A trade at price
+// p triggers a prefix of each map, so releasing k stops costs O(k + log n)
+// and stops that do not fire are never visited. Stops sharing a trigger
+// price fire in arrival order. Not thread-safe: the owning book guards it.
+class StopBook {
+public:
+    // Trigger-price nodes come from nodes when given, else the heap
+    explicit StopBook(NodePool* nodes = nullptr);
+
+    // Returns the queue the order joined
+    PriceLevel* add(Order* order);
+    void remove(Order* order);
+    PriceLevel& levelOf(const Order& order);
+    // Moves every stop triggered by a trade at price to the back of out,
+    // buy stops before sell stops, each in trigger order
+    void trigger(double price, PriceLevel& out);
+    // Visits buy stops then sell stops, each in trigger order; re-adding
+    // them in that order rebuilds the same queues
+    void forEach(const std::function<void(const Order&)>& visit) const;
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    static bool isStop(const Order& order) {
+        return order.type == OrderType::STOP || order.type == OrderType::STOP_LIMIT;
+    }
+    // Buy stops fire at or above their stop price, sell stops at or below.
+    // Nothing fires before the first trade.
+    static bool isTriggered(const Order& order, double lastPrice);
+    // Turns a fired stop into the order it stands for: STOP becomes MARKET,
+    // STOP_LIMIT becomes LIMIT at its limit price
+    static void activate(Order& order);
+
+private:
+    void moveLevel(PriceLevel& level, PriceLevel& out);
+
+    LevelMap<std::less<double>> buyStops_;
+    LevelMap<std::greater<double>> sellStops_;
+    size_t count_ = 0;
+};
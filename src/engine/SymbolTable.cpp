@@ -0,0 +1,75 @@
+#include "SymbolTable.h"
+#include "Order.h"
+#include <mutex>
+#include <stdexcept>
+
+SymbolTable::SymbolTable() : entries_(new Entry[MAX_SYMBOLS]) {}
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+uint32_t SymbolTable::intern(const std::string& symbol) {
+    if (symbol.empty()) return 0;
+    if (symbol.size() > MAX_SYMBOL_LENGTH) {
+        throw std::length_error("Symbol longer than " + std::to_string(MAX_SYMBOL_LENGTH) + " bytes: " + symbol);
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        auto it = ids_.find(symbol);
+        if (it != ids_.end()) return it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    auto it = ids_.find(symbol);
+    if (it != ids_.end()) return it->second;
+
+    uint32_t id = count_.load(std::memory_order_relaxed);
+    if (id >= MAX_SYMBOLS) {
+        throw std::length_error("Symbol table full, cannot intern: " + symbol);
+    }
+    entries_[id].name = symbol;
+    ids_.emplace(symbol, id);
+    // Publish the entry to lock-free readers only once it is fully written
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+uint32_t SymbolTable::find(const std::string& symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    auto it = ids_.find(symbol);
+    return it == ids_.end() ? 0 : it->second;
+}
+
+const std::string& SymbolTable::name(uint32_t id) const {
+    if (id >= count_.load(std::memory_order_acquire)) return entries_[0].name;
+    return entries_[id].name;
+}
+
+double SymbolTable::getTickSize(uint32_t id) const {
+    if (id >= count_.load(std::memory_order_acquire)) return DEFAULT_TICK_SIZE;
+    return entries_[id].tickSize.load(std::memory_order_relaxed);
+}
+
+void SymbolTable::setTickSize(uint32_t id, double tickSize) {
+    if (id == 0 || id >= count_.load(std::memory_order_acquire) || tickSize <= 0.0) return;
+    entries_[id].tickSize.store(tickSize, std::memory_order_relaxed);
+}
+
+uint32_t SymbolTable::size() const {
+    return count_.load(std::memory_order_acquire) - 1;
+}
+
+uint32_t SymbolCache::intern(std::string_view symbol) {
+    if (symbol.empty()) return 0;
+    uint32_t hash = 2166136261u;
+    for (char c : symbol) hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    Entry& entry = entries_[hash % SIZE];
+    if (entry.id != 0 && entry.name == symbol) return entry.id;
+
+    auto& symbols = SymbolTable::instance();
+    uint32_t id = symbols.intern(std::string(symbol));
+    entry.name = symbols.name(id);
+    entry.id = id;
+    return id;
+}
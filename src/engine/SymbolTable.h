@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Process-wide symbol interning. Each distinct symbol gets a small dense id
+// (0 is reserved for "no symbol"), so hot-path code compares integers instead
+// of strings. Entries are never removed; name() and getTickSize() are
+// lock-free because the entry array is preallocated and never moves.
+class SymbolTable {
+public:
+    static constexpr uint32_t MAX_SYMBOLS = 16384;
+    static constexpr double DEFAULT_TICK_SIZE = 0.01;
+
+    static SymbolTable& instance();
+
+    // Returns the existing id or assigns a new one; empty symbols map to 0.
+    // Throws std::length_error for symbols longer than MAX_SYMBOL_LENGTH
+    // and once MAX_SYMBOLS ids are in use.
+    uint32_t intern(const std::string& symbol);
+    // Returns 0 for unknown symbols
+    uint32_t find(const std::string& symbol) const;
+    const std::string& name(uint32_t id) const;
+
+    double getTickSize(uint32_t id) const;
+    void setTickSize(uint32_t id, double tickSize);
+    uint32_t size() const;
+
+private:
+    SymbolTable();
+
+    struct Entry {
+        std::string name;
+        std::atomic<double> tickSize{DEFAULT_TICK_SIZE};
+    };
+
+    std::unique_ptr<Entry[]> entries_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::atomic<uint32_t> count_{1};
+    mutable std::shared_mutex mtx_;
+};
+
+// Direct-mapped cache in front of SymbolTable for decoders that see the same
+// few symbols over and over: hits never build a std::string or take the
+// table's lock. Not thread-safe; keep one per decoding thread.
+class SymbolCache {
+public:
+    static constexpr size_t SIZE = 256;
+
+    // Same contract as SymbolTable::intern
+    uint32_t intern(std::string_view symbol);
+
+private:
+    struct Entry {
+        std::string_view name;      // Points into SymbolTable storage
+        uint32_t id = 0;
+    };
+
+    Entry entries_[SIZE];
+};
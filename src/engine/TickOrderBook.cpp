@@ -0,0 +1,344 @@
+#include "TickOrderBook.h"
+#include "CompactOrder.h"
+#include "Utils.h"
+#include <algorithm>
+
+TickOrderBook::TickOrderBook(double tickSize, size_t initialLevels,
+                             size_t poolCapacity, PoolMode poolMode)
+    : tickSize_(tickSize), ladder_(initialLevels), stopNodes_(LEVEL_NODE_SIZE, poolCapacity),
+      orderMap_(poolCapacity), pool_(poolCapacity, poolMode), stops_(&stopNodes_) {}
+
+bool TickOrderBook::addOrder(const Order& order) {
+    if (order.type == OrderType::CANCEL) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        bool found = cancelResting(order.orderId);
+        publishTop();
+        return found;
+    }
+    if (order.type == OrderType::MODIFY) {
+        return modifyOrder(order.orderId, order.price, order.quantity);
+    }
+    if (!order.isValid()) return false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (orderMap_.contains(order.orderId)) return false;
+    bool accepted = admit(pool_.acquire(order));
+    publishTop();
+    return accepted;
+}
+
+bool TickOrderBook::admit(Order* pooled) {
+    if (!pooled) return false;
+    if (StopBook::isStop(*pooled)) {
+        if (!StopBook::isTriggered(*pooled, lastTradePrice_)) {
+            stops_.add(pooled);
+            orderMap_.insert(pooled->orderId, pooled);
+            return true;
+        }
+        StopBook::activate(*pooled);
+    }
+    int64_t tick = tickOf(pooled->price, pooled->side);
+    if (pooled->timeInForce == TimeInForce::FOK && !canFill(*pooled, tick)) {
+        pool_.release(pooled);
+        return true;
+    }
+    match(*pooled, tick);
+    if (pooled->remainingQty > 0 && pooled->canRest()) {
+        if (pooled->isIceberg()) pooled->showNextSlice();
+        auto& level = ladder_.levelAt(tick, pooled->side);
+        level.pushBack(pooled);
+        ladder_.markOccupied(tick, pooled->side);
+        orderMap_.insert(pooled->orderId, pooled);
+        publishLevel(pooled->side, tick, level);
+    } else {
+        pool_.release(pooled);
+    }
+    releaseStops();
+    return true;
+}
+
+// Same cascade rules as OrderBook::releaseStops
+void TickOrderBook::releaseStops() {
+    if (releasingStops_) return;
+    releasingStops_ = true;
+    while (!triggeredStops_.empty()) {
+        Order* order = triggeredStops_.front();
+        triggeredStops_.remove(order);
+        orderMap_.erase(order->orderId);
+        StopBook::activate(*order);
+        admit(order);
+    }
+    releasingStops_ = false;
+}
+
+bool TickOrderBook::addOrder(OrderPtr order) {
+    return order ? addOrder(*order) : false;
+}
+
+void TickOrderBook::cancelOrder(uint64_t orderId) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    cancelResting(orderId);
+    publishTop();
+}
+
+bool TickOrderBook::cancelResting(uint64_t orderId) {
+    Order** resting = orderMap_.find(orderId);
+    if (!resting) return false;
+    unlink(*resting);
+    return true;
+}
+
+void TickOrderBook::reduceOrder(uint64_t orderId, uint32_t qty) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Order** resting = orderMap_.find(orderId);
+    if (!resting) return;
+    auto& order = **resting;
+    uint32_t cut = std::min(qty, order.remainingQty);
+    uint32_t shown = order.shownQty();
+    order.remainingQty -= cut;
+    order.visibleQty = std::min(order.visibleQty, order.remainingQty);
+    auto& level = levelOf(order);
+    level.reduce(cut, shown - order.shownQty());
+    if (order.remainingQty == 0) {
+        unlink(&order);
+    } else if (!StopBook::isStop(order)) {
+        publishLevel(order.side, tickOf(order.price, order.side), level);
+    }
+    publishTop();
+}
+
+bool TickOrderBook::modifyOrder(uint64_t orderId, double price, uint32_t quantity) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool found = modifyResting(orderId, price, quantity);
+    publishTop();
+    return found;
+}
+
+bool TickOrderBook::modifyResting(uint64_t orderId, double price, uint32_t quantity) {
+    Order** resting = orderMap_.find(orderId);
+    if (!resting) return false;
+    Order* order = *resting;
+    uint32_t filled = order->quantity - order->remainingQty;
+    if (quantity <= filled) {
+        unlink(order);
+        return true;
+    }
+    uint32_t remaining = quantity - filled;
+    order->lastModified = std::chrono::system_clock::now();
+    if (tickOf(price, order->side) == tickOf(order->price, order->side) &&
+        remaining <= order->remainingQty) {
+        uint32_t cut = order->remainingQty - remaining;
+        uint32_t shown = order->shownQty();
+        order->quantity = quantity;
+        order->remainingQty = remaining;
+        order->visibleQty = std::min(order->visibleQty, remaining);
+        auto& level = levelOf(*order);
+        level.reduce(cut, shown - order->shownQty());
+        if (!StopBook::isStop(*order)) {
+            publishLevel(order->side, tickOf(order->price, order->side), level);
+        }
+        return true;
+    }
+    detach(order);
+    order->price = price;
+    order->quantity = quantity;
+    order->remainingQty = remaining;
+    return admit(order);
+}
+
+void TickOrderBook::unlink(Order* order) {
+    pool_.release(detach(order));
+}
+
+Order* TickOrderBook::detach(Order* order) {
+    if (StopBook::isStop(*order)) {
+        stops_.remove(order);
+    } else {
+        int64_t tick = tickOf(order->price, order->side);
+        auto& level = *ladder_.findLevel(tick);
+        level.remove(order);
+        publishLevel(order->side, tick, level);
+        if (level.empty()) ladder_.markEmpty(tick, order->side);
+    }
+    orderMap_.erase(order->orderId);
+    return order;
+}
+
+// Off-grid limits round away from the touch, as CompactOrder::fromOrder
+// does, so an order never trades or rests past its own price
+int64_t TickOrderBook::tickOf(double price, OrderSide side) const {
+    return CompactOrder::limitTicks(price, tickSize_, side);
+}
+
+PriceLevel& TickOrderBook::levelOf(const Order& order) {
+    if (StopBook::isStop(order)) return stops_.levelOf(order);
+    return *ladder_.findLevel(tickOf(order.price, order.side));
+}
+
+void TickOrderBook::setTradeCallback(TradeCallback cb) {
+    tradeCb_ = cb;
+}
+
+void TickOrderBook::publishTop() {
+    double bidPrice = 0.0, askPrice = 0.0;
+    uint64_t bidQty = 0, askQty = 0;
+    if (ladder_.hasOrders(OrderSide::BUY)) {
+        int64_t tick = ladder_.bestBidTick();
+        bidPrice = Utils::ticksToPrice(tick, tickSize_);
+        bidQty = ladder_.findLevel(tick)->displayedQty;
+    }
+    if (ladder_.hasOrders(OrderSide::SELL)) {
+        int64_t tick = ladder_.bestAskTick();
+        askPrice = Utils::ticksToPrice(tick, tickSize_);
+        askQty = ladder_.findLevel(tick)->displayedQty;
+    }
+    top_.publish(bidPrice, bidQty, askPrice, askQty);
+}
+
+double TickOrderBook::getBestBid() const {
+    return top_.read().bidPrice;
+}
+
+double TickOrderBook::getBestAsk() const {
+    return top_.read().askPrice;
+}
+
+TopOfBook TickOrderBook::getTopOfBook() const {
+    return top_.read();
+}
+
+void TickOrderBook::setDepthFeed(DepthFeed* feed) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    depth_.setFeed(feed);
+}
+
+DepthSnapshot TickOrderBook::getDepthSnapshot(size_t depth) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    DepthSnapshot snapshot;
+    snapshot.sequence = depth_.sequence();
+    for (OrderSide side : {OrderSide::BUY, OrderSide::SELL}) {
+        auto& out = side == OrderSide::BUY ? snapshot.bids : snapshot.asks;
+        if (depth == 0 || !ladder_.hasOrders(side)) continue;
+        int64_t tick = side == OrderSide::BUY ? ladder_.bestBidTick() : ladder_.bestAskTick();
+        do {
+            const auto& level = *ladder_.findLevel(tick);
+            out.push_back({Utils::ticksToPrice(tick, tickSize_), level.displayedQty, level.orderCount});
+        } while (out.size() < depth && ladder_.nextLevel(side, tick, tick));
+    }
+    return snapshot;
+}
+
+uint64_t TickOrderBook::getDroppedDepthUpdates() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return depth_.dropped();
+}
+
+void TickOrderBook::setExecutionFeed(ExecutionFeed* feed) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    executions_.setFeed(feed);
+}
+
+uint64_t TickOrderBook::getDroppedExecutionReports() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return executions_.dropped();
+}
+
+uint64_t TickOrderBook::getTotalTrades() const {
+    return totalTrades_.load();
+}
+
+size_t TickOrderBook::getPendingStops() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stops_.size();
+}
+
+double TickOrderBook::getTickSize() const {
+    return tickSize_;
+}
+
+OrderPool::Stats TickOrderBook::getPoolStats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return pool_.getStats();
+}
+
+void TickOrderBook::match(Order& order, int64_t tick) {
+    if (order.side == OrderSide::BUY) {
+        // Match buy order against asks (sell orders)
+        while (order.remainingQty > 0 && ladder_.hasOrders(OrderSide::SELL)) {
+            int64_t askTick = ladder_.bestAskTick();
+            if (order.type != OrderType::MARKET && tick < askTick) {
+                break; // Buy price too low to match
+            }
+            double price = Utils::ticksToPrice(askTick, tickSize_);
+            auto& level = *ladder_.findLevel(askTick);
+            while (order.remainingQty > 0 && !level.empty()) {
+                Order* matchOrder = level.front();
+                uint32_t fillQty = std::min(order.remainingQty, matchOrder->shownQty());
+                executeTrade(order, *matchOrder, price, fillQty, OrderSide::BUY);
+                fillResting(level, matchOrder, fillQty);
+            }
+            publishLevel(OrderSide::SELL, askTick, level);
+            if (level.empty()) ladder_.markEmpty(askTick, OrderSide::SELL);
+        }
+    } else {
+        // Match sell order against bids (buy orders)
+        while (order.remainingQty > 0 && ladder_.hasOrders(OrderSide::BUY)) {
+            int64_t bidTick = ladder_.bestBidTick();
+            if (order.type != OrderType::MARKET && tick > bidTick) {
+                break; // Sell price too high to match
+            }
+            double price = Utils::ticksToPrice(bidTick, tickSize_);
+            auto& level = *ladder_.findLevel(bidTick);
+            while (order.remainingQty > 0 && !level.empty()) {
+                Order* matchOrder = level.front();
+                uint32_t fillQty = std::min(order.remainingQty, matchOrder->shownQty());
+                executeTrade(*matchOrder, order, price, fillQty, OrderSide::SELL);
+                fillResting(level, matchOrder, fillQty);
+            }
+            publishLevel(OrderSide::BUY, bidTick, level);
+            if (level.empty()) ladder_.markEmpty(bidTick, OrderSide::BUY);
+        }
+    }
+}
+
+void TickOrderBook::fillResting(PriceLevel& level, Order* resting, uint32_t qty) {
+    level.reduce(qty, qty);
+    if (resting->isIceberg()) resting->visibleQty -= qty;
+    if (resting->remainingQty == 0) {
+        level.remove(resting);
+        orderMap_.erase(resting->orderId);
+        pool_.release(resting);
+    } else if (resting->isIceberg() && resting->visibleQty == 0) {
+        level.replenish(resting);
+    }
+}
+
+// Same walk as OrderBook::canFill, stepping between occupied ladder levels
+bool TickOrderBook::canFill(const Order& order, int64_t tick) const {
+    OrderSide contra = order.side == OrderSide::BUY ? OrderSide::SELL : OrderSide::BUY;
+    if (!ladder_.hasOrders(contra)) return false;
+    int64_t levelTick = contra == OrderSide::SELL ? ladder_.bestAskTick() : ladder_.bestBidTick();
+    uint64_t available = 0;
+    do {
+        if (order.type != OrderType::MARKET &&
+            (order.side == OrderSide::BUY ? tick < levelTick : tick > levelTick)) break;
+        available += ladder_.findLevel(levelTick)->totalQty;
+        if (available >= order.remainingQty) return true;
+    } while (ladder_.nextLevel(contra, levelTick, levelTick));
+    return false;
+}
+
+void TickOrderBook::executeTrade(Order& buy, Order& sell, double price, uint32_t qty, OrderSide aggressor) {
+    buy.remainingQty -= qty;
+    sell.remainingQty -= qty;
+    uint64_t tradeId = totalTrades_.fetch_add(1) + 1;
+    lastTradePrice_ = price;
+    if (!stops_.empty()) stops_.trigger(price, triggeredStops_);
+    if (executions_.enabled()) {
+        executions_.publish(tradeId, buy.orderId, sell.orderId, price, qty, aggressor);
+    }
+    if (tradeCb_) tradeCb_(buy, sell, price, qty);
+}
+
+void TickOrderBook::publishLevel(OrderSide side, int64_t tick, const PriceLevel& level) {
+    if (depth_.enabled()) depth_.publish(side, Utils::ticksToPrice(tick, tickSize_), level);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "OrderBook.h"
+#include "OrderIdMap.h"
+#include "PriceLadder.h"
+#include "StopBook.h"
+
+// Order book backend keyed by integer ticks instead of raw doubles. Levels
+// live in a contiguous PriceLadder whose occupancy bitmaps give the best
+// bid/ask without a tree walk. Prices are rounded to the book's tick size
+// (buys down, sells up) so ones that differ only by floating-point noise share
+// a level. That rounding only applies to orders added to the book directly:
+// the Matcher refuses off-tick prices before they reach a book.
+class TickOrderBook {
+public:
+    using OrderPtr = OrderBook::OrderPtr;
+    using TradeCallback = OrderBook::TradeCallback;
+
+    explicit TickOrderBook(double tickSize = 0.01, size_t initialLevels = 4096,
+                           size_t poolCapacity = OrderPool::DEFAULT_CAPACITY,
+                           PoolMode poolMode = PoolMode::GROWABLE);
+    bool addOrder(const Order& order);
+    bool addOrder(OrderPtr order);
+    void cancelOrder(uint64_t orderId);
+    void reduceOrder(uint64_t orderId, uint32_t qty);
+    // Same contract as OrderBook::modifyOrder
+    bool modifyOrder(uint64_t orderId, double price, uint32_t quantity);
+    void setTradeCallback(TradeCallback cb);
+    // Same contracts as the OrderBook depth feed and snapshot
+    void setDepthFeed(DepthFeed* feed);
+    DepthSnapshot getDepthSnapshot(size_t depth) const;
+    uint64_t getDroppedDepthUpdates() const;
+    // Same contract as OrderBook::setExecutionFeed
+    void setExecutionFeed(ExecutionFeed* feed);
+    uint64_t getDroppedExecutionReports() const;
+    // Lock-free, as in OrderBook
+    double getBestBid() const;
+    double getBestAsk() const;
+    TopOfBook getTopOfBook() const;
+    uint64_t getTotalTrades() const;
+    size_t getPendingStops() const;
+    double getTickSize() const;
+    OrderPool::Stats getPoolStats() const;
+
+private:
+    double tickSize_;
+    PriceLadder ladder_;
+    NodePool stopNodes_;
+    OrderIdMap<Order*> orderMap_;
+    OrderPool pool_;
+    mutable std::mutex mtx_;
+    TradeCallback tradeCb_;
+    std::atomic<uint64_t> totalTrades_{0};
+    StopBook stops_;
+    PriceLevel triggeredStops_;
+    double lastTradePrice_ = 0.0;
+    bool releasingStops_ = false;
+    DepthPublisher depth_;
+    ExecutionPublisher executions_;
+    SeqlockTopOfBook top_;
+    bool cancelResting(uint64_t orderId);
+    bool modifyResting(uint64_t orderId, double price, uint32_t quantity);
+    void publishTop();
+    bool admit(Order* pooled);
+    void releaseStops();
+    bool canFill(const Order& order, int64_t tick) const;
+    int64_t tickOf(double price, OrderSide side) const;
+    PriceLevel& levelOf(const Order& order);
+    void match(Order& order, int64_t tick);
+    void fillResting(PriceLevel& level, Order* resting, uint32_t qty);
+    void unlink(Order* order);
+    Order* detach(Order* order);
+    void executeTrade(Order& buy, Order& sell, double price, uint32_t qty, OrderSide aggressor);
+    void publishLevel(OrderSide side, int64_t tick, const PriceLevel& level);
+};
@@ -1,43 +1,72 @@
-#pragma once
-#include <string>
-#include <chrono>
-#include <vector>
-#include <cmath>
-
-namespace Utils {
-    // Timestamp utilities
-    inline long getTimestamp() {
-        return std::chrono::system_clock::now().time_since_epoch().count();
-    }
-    
-    std::string formatTimestamp(const std::chrono::system_clock::time_point& timePoint);
-    uint64_t getMicrosecondsSinceEpoch();
-    uint64_t getNanosecondsSinceEpoch();
-    
-    // Formatting utilities
-    std::string formatPrice(double price);
-    std::string formatQuantity(uint32_t quantity);
-    std::string formatBytes(uint64_t bytes);
-    std::string formatDuration(std::chrono::milliseconds duration);
-    
-    // Financial utilities
-    double roundToTickSize(double price, double tickSize);
-    bool isValidPrice(double price);
-    bool isValidQuantity(uint32_t quantity);
-    double calculateNotionalValue(double price, uint32_t quantity);
-    double calculateWeightedAveragePrice(const std::vector<std::pair<double, uint32_t>>& fills);
-    bool isWithinPercentage(double value1, double value2, double percentage);
-    
-    // String utilities
-    std::string toUpperCase(const std::string& str);
-    std::string toLowerCase(const std::string& str);
-    std::string trim(const std::string& str);
-    std::vector<std::string> split(const std::string& str, char delimiter);
-    
-    // Random data generation
-    std::string generateOrderId();
-    std::string getRandomSymbol();
-    double getRandomPrice(double min = 90.0, double max = 110.0);
-    uint32_t getRandomQuantity(uint32_t min = 1, uint32_t max = 1000);
-    bool coinFlip();
-}
+#pragma once
+#include <string>
+#include <chrono>
+#include <vector>
+#include <cmath>
+
+namespace Utils {
+    // Timestamp utilities
+    inline long getTimestamp() {
+        return std::chrono::system_clock::now().time_since_epoch().count();
+    }
+    
+    std::string formatTimestamp(const std::chrono::system_clock::time_point& timePoint);
+    uint64_t getMicrosecondsSinceEpoch();
+    uint64_t getNanosecondsSinceEpoch();
+    
+    // Formatting utilities
+    std::string formatPrice(double price);
+    std::string formatQuantity(uint32_t quantity);
+    std::string formatBytes(uint64_t bytes);
+    std::string formatDuration(std::chrono::milliseconds duration);
+    
+    // Financial utilities
+    double roundToTickSize(double price, double tickSize);
+    int64_t priceToTicks(double price, double tickSize);
+    // Directed roundings for off-tick prices. Within a millionth of a tick
+    // counts as on it, so binary noise like 100.01 / 0.01 is not rounded away.
+    int64_t priceToTicksDown(double price, double tickSize);
+    int64_t priceToTicksUp(double price, double tickSize);
+    bool isOnTick(double price, double tickSize);
+    double ticksToPrice(int64_t ticks, double tickSize);
+    bool isValidPrice(double price);
+    bool isValidQuantity(uint32_t quantity);
+    double calculateNotionalValue(double price, uint32_t quantity);
+    double calculateWeightedAveragePrice(const std::vector<std::pair<double, uint32_t>>& fills);
+    bool isWithinPercentage(double value1, double value2, double percentage);
+    
+    // String utilities
+    std::string toUpperCase(const std::string& str);
+    std::string toLowerCase(const std::string& str);
+    std::string trim(const std::string& str);
+    std::vector<std::string> split(const std::string& str, char delimiter);
+    
+    // Threading utilities
+    bool pinCurrentThreadToCpu(int cpu);
+    // SCHED_FIFO at priority (1-99); needs CAP_SYS_NICE or a matching RLIMIT_RTPRIO
+    bool setCurrentThreadRealtime(int priority);
+    // mlockall of current and future mappings, so they are resident and never
+    // fault. Refused (returns false) unless RLIMIT_MEMLOCK is unlimited or the
+    // process is root, because past the limit MCL_FUTURE would make later
+    // allocations fail.
+    bool lockProcessMemory();
+    // NUMA node of the CPU the calling thread runs on, or -1 if unknown
+    int getCurrentNumaNode();
+    unsigned getCpuCount();
+
+    // Spin-wait hint: lets the sibling hyperthread run and saves power
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+    
+    // Random data generation
+    std::string generateOrderId();
+    std::string getRandomSymbol();
+    double getRandomPrice(double min = 90.0, double max = 110.0);
+    uint32_t getRandomQuantity(uint32_t min = 1, uint32_t max = 1000);
+    bool coinFlip();
+}
@@ -0,0 +1,223 @@
+#include "AsyncLogWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> nextWriterId{1};
+
+struct ThreadRing {
+    uint64_t writerId;
+    LogProducer* ring;
+    std::weak_ptr<LogProducer> owner;   // Outlives neither the writer nor the thread
+    uint16_t producer;                  // Index into the writer's producers_
+};
+
+// Hands this thread's rings back when it exits. The weak_ptr skips writers
+// already destroyed, and writer ids are never reused, so stale entries can
+// never be matched again.
+struct ThreadRings {
+    std::vector<ThreadRing> entries;
+
+    ~ThreadRings() {
+        for (auto& entry : entries) {
+            if (auto producer = entry.owner.lock()) {
+                producer->state.store(LogProducer::RETIRED, std::memory_order_release);
+            }
+        }
+    }
+};
+
+thread_local ThreadRings threadRings;
+
+uint64_t wallClockNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+}
+
+AsyncLogWriter::AsyncLogWriter(std::ofstream& file, LogMode mode, const AsyncLogConfig& config)
+    : file_(file), mode_(mode), config_(config),
+      id_(nextWriterId.fetch_add(1, std::memory_order_relaxed)),
+      overflow_(config.bufferRecords) {
+    if (mode_ == LogMode::ASYNC_BINARY) {
+        file_.seekp(0, std::ios::end);
+        if (file_.tellp() == 0) {
+            LogFileHeader header{};
+            std::memcpy(header.magic, LOG_FILE_MAGIC, sizeof(header.magic));
+            header.version = LOG_FILE_VERSION;
+            header.recordSize = sizeof(LogRecord);
+            file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file_.flush();
+        }
+    }
+    pending_.reserve(config_.flushBytes + 4096);
+    lastFlush_ = std::chrono::steady_clock::now();
+    running_.store(true);
+    worker_ = std::thread(&AsyncLogWriter::run, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    shutdown();
+}
+
+bool AsyncLogWriter::enqueue(LogRecord& record) {
+    uint16_t producer = 0;
+    if (Ring* ring = ringForThisThread(producer)) return push(*ring, producer, record);
+    // Every ring is held by a live thread: share the overflow ring
+    std::lock_guard<std::mutex> lock(overflowMtx_);
+    return push(overflow_.ring, OVERFLOW_PRODUCER, record);
+}
+
+bool AsyncLogWriter::enqueueMessage(const std::string& message) {
+    uint16_t producer = 0;
+    if (Ring* ring = ringForThisThread(producer)) return pushMessage(*ring, producer, message);
+    // Holding the lock for every chunk keeps the chain contiguous
+    std::lock_guard<std::mutex> lock(overflowMtx_);
+    return pushMessage(overflow_.ring, OVERFLOW_PRODUCER, message);
+}
+
+bool AsyncLogWriter::push(Ring& ring, uint16_t producer, LogRecord& record) {
+    record.timestampNs = wallClockNs();
+    record.producer = producer;
+    if (!ring.tryPush(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool AsyncLogWriter::pushMessage(Ring& ring, uint16_t producer, const std::string& message) {
+    size_t chunks = std::max<size_t>(1, (message.size() + LOG_TEXT_CAPACITY - 1) / LOG_TEXT_CAPACITY);
+    // All chunks or none: a chain missing its tail would splice into the
+    // next message from this producer
+    if (ring.freeSlots() < chunks) {
+        dropped_.fetch_add(chunks, std::memory_order_relaxed);
+        return false;
+    }
+    LogRecord record{};
+    record.event = LogEvent::MESSAGE;
+    record.producer = producer;
+    record.timestampNs = wallClockNs();
+    size_t offset = 0;
+    // Chunks share one timestamp so the decoder prints a single line
+    do {
+        size_t n = std::min(message.size() - offset, LOG_TEXT_CAPACITY);
+        std::memcpy(record.text, message.data() + offset, n);
+        record.length = static_cast<uint16_t>(n);
+        offset += n;
+        record.flags = offset < message.size() ? LOG_CONTINUES : 0;
+        ring.tryPush(record);
+    } while (offset < message.size());
+    return true;
+}
+
+void AsyncLogWriter::shutdown() {
+    if (!running_.exchange(false)) return;
+    if (worker_.joinable()) worker_.join();
+}
+
+uint64_t AsyncLogWriter::getDroppedRecords() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+size_t AsyncLogWriter::getProducerCount() const {
+    return producerCount_.load(std::memory_order_acquire);
+}
+
+AsyncLogWriter::Ring* AsyncLogWriter::ringForThisThread(uint16_t& producer) {
+    for (const auto& entry : threadRings.entries) {
+        if (entry.writerId == id_) {
+            producer = entry.producer;
+            return &entry.ring->ring;
+        }
+    }
+    return registerThread(producer);
+}
+
+// Slow path, once per thread: reuse a ring an exited thread left drained,
+// else allocate one. A thread that finds every slot live gets nullptr on
+// each call, so it keeps retrying here until a slot frees up.
+AsyncLogWriter::Ring* AsyncLogWriter::registerThread(uint16_t& producer) {
+    std::lock_guard<std::mutex> lock(registerMtx_);
+    auto& entries = threadRings.entries;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const ThreadRing& entry) { return entry.owner.expired(); }),
+                  entries.end());
+    size_t count = producerCount_.load(std::memory_order_relaxed);
+    size_t slot = 0;
+    while (slot < count &&
+           producers_[slot]->state.load(std::memory_order_acquire) != LogProducer::FREE) {
+        ++slot;
+    }
+    if (slot == count) {
+        if (count == MAX_PRODUCERS) return nullptr;
+        // Separate control block, so a stale weak_ptr does not pin the ring
+        producers_[slot].reset(new LogProducer(config_.bufferRecords));
+        producerCount_.store(count + 1, std::memory_order_release);
+    } else {
+        producers_[slot]->state.store(LogProducer::ACTIVE, std::memory_order_relaxed);
+    }
+    producer = static_cast<uint16_t>(slot);
+    entries.push_back({id_, producers_[slot].get(), producers_[slot], producer});
+    return &producers_[slot]->ring;
+}
+
+void AsyncLogWriter::run() {
+    auto idleSleep = std::min<std::chrono::microseconds>(
+        std::chrono::microseconds(500), config_.flushInterval);
+    while (running_.load(std::memory_order_acquire)) {
+        size_t drained = drain();
+        auto now = std::chrono::steady_clock::now();
+        if (pending_.size() >= config_.flushBytes ||
+            (!pending_.empty() && now - lastFlush_ >= config_.flushInterval)) {
+            flush();
+        }
+        if (drained == 0) std::this_thread::sleep_for(idleSleep);
+    }
+    // Producers are done by now; pick up everything they left behind
+    while (drain() > 0) {}
+    flush();
+}
+
+// One pass takes at most one batch from each ring, so a thread that keeps
+// its ring full cannot starve the others, and output is flushed as it
+// accumulates rather than after the pass
+size_t AsyncLogWriter::drain() {
+    size_t total = 0;
+    size_t count = producerCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) total += drainRing(*producers_[i]);
+    total += drainRing(overflow_);
+    return total;
+}
+
+size_t AsyncLogWriter::drainRing(LogProducer& producer) {
+    LogRecord batch[256];
+    int state = producer.state.load(std::memory_order_acquire);
+    if (state == LogProducer::FREE) return 0;
+    size_t n = producer.ring.tryPopBatch(batch, 256);
+    if (mode_ == LogMode::ASYNC_BINARY) {
+        pending_.append(reinterpret_cast<const char*>(batch), n * sizeof(LogRecord));
+    } else {
+        for (size_t j = 0; j < n; ++j) formatter_.append(pending_, batch[j]);
+    }
+    if (pending_.size() >= config_.flushBytes) flush();
+    // Retired before the pop and empty after it: the thread is gone and
+    // everything it pushed has been written, so the ring can be reused
+    if (state == LogProducer::RETIRED && producer.ring.empty()) {
+        producer.state.store(LogProducer::FREE, std::memory_order_release);
+    }
+    return n;
+}
+
+void AsyncLogWriter::flush() {
+    if (!pending_.empty()) {
+        file_.write(pending_.data(), static_cast<std::streamsize>(pending_.size()));
+        file_.flush();
+        pending_.clear();
+    }
+    lastFlush_ = std::chrono::steady_clock::now();
+}
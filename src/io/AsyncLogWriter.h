@@ -0,0 +1,99 @@
+#pragma once
+#include "LogRecord.h"
+#include "engine/RingBuffer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+enum class LogMode {
+    SYNC,           // Format and flush on the calling thread (original behaviour)
+    ASYNC_TEXT,     // Background thread formats records into the usual text lines
+    ASYNC_BINARY    // Background thread writes raw LogRecords; see obme-logdecode
+};
+
+struct AsyncLogConfig {
+    size_t bufferRecords = 8192;    // Per producer thread
+    size_t flushBytes = 64 * 1024;  // Group flush once this much output is pending
+    std::chrono::milliseconds flushInterval{50};    // ...or once this much time has passed
+};
+
+// One producing thread's ring. The thread marks it RETIRED when it exits;
+// the writer drains it and marks it FREE for the next new thread to take.
+struct LogProducer {
+    enum State : int { ACTIVE, RETIRED, FREE };
+
+    explicit LogProducer(size_t capacity) : ring(capacity) {}
+
+    SpscRingBuffer<LogRecord> ring;
+    std::atomic<int> state{ACTIVE};
+};
+
+// Each producing thread gets its own SPSC ring the first time it logs, so
+// enqueueing is a thread-local lookup, a clock read and a ring push. Rings of
+// exited threads are recycled once drained. At most MAX_PRODUCERS threads
+// hold a ring at once; beyond that, threads share one overflow ring under a
+// mutex. A single background thread drains the rings round-robin and writes
+// the file in large chunks. Records that do not fit in a full ring are
+// dropped and counted rather than stalling the hot thread.
+class AsyncLogWriter {
+public:
+    static constexpr size_t MAX_PRODUCERS = 256;
+
+    AsyncLogWriter(std::ofstream& file, LogMode mode, const AsyncLogConfig& config);
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    // Stamps the record and hands it to the writer; false if it was dropped
+    bool enqueue(LogRecord& record);
+    bool enqueueMessage(const std::string& message);
+    // Drains everything enqueued so far and writes it out; then stops the thread
+    void shutdown();
+
+    uint64_t getDroppedRecords() const;
+    // Rings allocated so far, at most MAX_PRODUCERS; recycling keeps it at
+    // the peak number of threads logging at once
+    size_t getProducerCount() const;
+
+private:
+    using Ring = SpscRingBuffer<LogRecord>;
+
+    // Tags the overflow ring's records
+    static constexpr uint16_t OVERFLOW_PRODUCER = MAX_PRODUCERS;
+
+    // Sets producer to the ring's index, which tags every record it carries;
+    // nullptr when every ring is held by a live thread
+    Ring* ringForThisThread(uint16_t& producer);
+    Ring* registerThread(uint16_t& producer);
+    bool push(Ring& ring, uint16_t producer, LogRecord& record);
+    bool pushMessage(Ring& ring, uint16_t producer, const std::string& message);
+    void run();
+    size_t drain();
+    size_t drainRing(LogProducer& producer);
+    void flush();
+
+    std::ofstream& file_;
+    LogMode mode_;
+    AsyncLogConfig config_;
+    uint64_t id_;
+
+    std::array<std::shared_ptr<LogProducer>, MAX_PRODUCERS> producers_;
+    std::atomic<size_t> producerCount_{0};
+    std::mutex registerMtx_;
+    LogProducer overflow_;
+    std::mutex overflowMtx_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> dropped_{0};
+    std::thread worker_;
+
+    // Writer thread only
+    LogRecordFormatter formatter_;
+    std::string pending_;
+    std::chrono::steady_clock::time_point lastFlush_;
+};
@@ -0,0 +1,403 @@
+#include "BulkDecoder.h"
+#include "ParseUtils.h"
+#include "../engine/Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OBME_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+using namespace ParseUtils;
+
+namespace {
+
+// Characters the line walker needs to see: line ends, field delimiters and
+// JSON punctuation
+struct StructuralTable {
+    uint8_t hit[256] = {};
+    constexpr StructuralTable() {
+        for (unsigned char c : {'\n', ',', '|', '"', ':', '{', '}'}) hit[c] = 1;
+    }
+};
+
+constexpr StructuralTable STRUCTURAL;
+
+// Branch-free: every byte is written, only structural ones advance count
+size_t indexScalar(const char* data, size_t start, size_t length, uint32_t* out) {
+    size_t count = 0;
+    for (size_t i = start; i < length; ++i) {
+        out[count] = static_cast<uint32_t>(i);
+        count += STRUCTURAL.hit[static_cast<unsigned char>(data[i])];
+    }
+    return count;
+}
+
+#ifdef OBME_X86_SIMD
+
+__attribute__((target("sse2")))
+size_t indexSse2(const char* data, size_t length, uint32_t* out) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i pipe = _mm_set1_epi8('|');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i openBrace = _mm_set1_epi8('{');
+    const __m128i closeBrace = _mm_set1_epi8('}');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, comma)),
+                         _mm_or_si128(_mm_cmpeq_epi8(chunk, pipe), _mm_cmpeq_epi8(chunk, quote))),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, openBrace)),
+                         _mm_cmpeq_epi8(chunk, closeBrace)));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        while (mask) {
+            out[count++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+    return count + indexScalar(data, i, length, out + count);
+}
+
+__attribute__((target("avx2")))
+size_t indexAvx2(const char* data, size_t length, uint32_t* out) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i pipe = _mm256_set1_epi8('|');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i openBrace = _mm256_set1_epi8('{');
+    const __m256i closeBrace = _mm256_set1_epi8('}');
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, newline), _mm256_cmpeq_epi8(chunk, comma)),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, pipe), _mm256_cmpeq_epi8(chunk, quote))),
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, openBrace)),
+                            _mm256_cmpeq_epi8(chunk, closeBrace)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        while (mask) {
+            out[count++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+    return count + indexScalar(data, i, length, out + count);
+}
+
+#endif
+
+// One decoded line, committed to the batch only if every field is good
+struct Row {
+    uint64_t orderId = 0;
+    uint64_t clientId = 0;
+    std::string_view symbol;
+    OrderType type = OrderType::LIMIT;
+    OrderSide side = OrderSide::BUY;
+    double price = 0.0;
+    uint32_t quantity = 0;
+    uint32_t remainingQty = 0;
+    double stopPrice = 0.0;
+    TimeInForce timeInForce = TimeInForce::GTC;
+    uint32_t displayQty = 0;
+};
+
+}
+
+void OrderBatch::clear() {
+    orderIds.clear();
+    clientIds.clear();
+    symbolIds.clear();
+    types.clear();
+    sides.clear();
+    prices.clear();
+    quantities.clear();
+    remainingQtys.clear();
+    stopPrices.clear();
+    timeInForces.clear();
+    displayQtys.clear();
+    errors.clear();
+}
+
+void OrderBatch::reserve(size_t count) {
+    orderIds.reserve(count);
+    clientIds.reserve(count);
+    symbolIds.reserve(count);
+    types.reserve(count);
+    sides.reserve(count);
+    prices.reserve(count);
+    quantities.reserve(count);
+    remainingQtys.reserve(count);
+    stopPrices.reserve(count);
+    timeInForces.reserve(count);
+    displayQtys.reserve(count);
+}
+
+CompactOrder OrderBatch::toCompactOrder(size_t i) const {
+    double tickSize = SymbolTable::instance().getTickSize(symbolIds[i]);
+    CompactOrder compact;
+    compact.orderId = orderIds[i];
+    compact.clientId = clientIds[i];
+    compact.symbolId = symbolIds[i];
+    compact.priceTicks = CompactOrder::limitTicks(prices[i], tickSize, sides[i]);
+    compact.stopTicks = CompactOrder::stopTicksFor(stopPrices[i], tickSize, sides[i]);
+    compact.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    compact.quantity = quantities[i];
+    compact.remainingQty = remainingQtys[i];
+    compact.type = types[i];
+    compact.side = sides[i];
+    compact.timeInForce = timeInForces[i];
+    compact.displayQty = displayQtys[i];
+    return compact;
+}
+
+void OrderBatch::toCompactOrders(std::vector<CompactOrder>& out) const {
+    out.resize(size());
+    for (size_t i = 0; i < size(); ++i) out[i] = toCompactOrder(i);
+}
+
+Order OrderBatch::toOrder(size_t i) const {
+    Order order(orderIds[i], clientIds[i], SymbolTable::instance().name(symbolIds[i]),
+                types[i], sides[i], prices[i], quantities[i], stopPrices[i]);
+    order.remainingQty = remainingQtys[i];
+    order.timeInForce = timeInForces[i];
+    order.displayQty = displayQtys[i];
+    return order;
+}
+
+BulkDecoder::BulkDecoder() : isa_(detectIsa()) {}
+
+BulkDecoder::BulkDecoder(Isa isa) : isa_(std::min(isa, detectIsa())) {}
+
+BulkDecoder::Isa BulkDecoder::getIsa() const {
+    return isa_;
+}
+
+BulkDecoder::Isa BulkDecoder::detectIsa() {
+#ifdef OBME_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+    if (__builtin_cpu_supports("sse2")) return Isa::SSE2;
+#endif
+    return Isa::SCALAR;
+}
+
+const char* BulkDecoder::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+size_t BulkDecoder::decode(std::string_view data, OrderBatch& batch, bool final) {
+    size_t length = data.size();
+    if (!final) {
+        size_t lastNewline = data.rfind('\n');
+        length = lastNewline == std::string_view::npos ? 0 : lastNewline + 1;
+    }
+
+    size_t pos = 0;
+    while (pos < length) {
+        // Blocks end on a line boundary so no line straddles two indexes
+        size_t blockEnd = std::min(pos + BLOCK_SIZE, length);
+        if (blockEnd < length) {
+            size_t cut = data.rfind('\n', blockEnd - 1);
+            if (cut == std::string_view::npos || cut < pos) cut = data.find('\n', blockEnd);
+            blockEnd = cut == std::string_view::npos || cut >= length ? length : cut + 1;
+        }
+
+        const char* block = data.data() + pos;
+        size_t blockLength = blockEnd - pos;
+        buildIndex(block, blockLength);
+
+        size_t k = 0;
+        size_t lineStart = 0;
+        while (lineStart < blockLength) {
+            size_t lineFirst = k;
+            while (k < indexSize_ && block[index_[k]] != '\n') k++;
+            size_t lineEnd = k < indexSize_ ? index_[k] : blockLength;
+            decodeLine(block, lineStart, lineEnd, lineFirst, k, pos, batch);
+            k++;
+            lineStart = lineEnd + 1;
+        }
+        pos = blockEnd;
+    }
+    return length;
+}
+
+void BulkDecoder::buildIndex(const char* data, size_t length) {
+    if (index_.size() < length + 1) index_.resize(std::max(length + 1, BLOCK_SIZE + 1));
+    uint32_t* out = index_.data();
+    switch (isa_) {
+#ifdef OBME_X86_SIMD
+        case Isa::AVX2: indexSize_ = indexAvx2(data, length, out); break;
+        case Isa::SSE2: indexSize_ = indexSse2(data, length, out); break;
+#endif
+        default: indexSize_ = indexScalar(data, 0, length, out); break;
+    }
+}
+
+// index_[first, last) are the structural characters inside the line
+void BulkDecoder::decodeLine(const char* data, size_t lineStart, size_t lineEnd,
+                             size_t first, size_t last, size_t baseOffset, OrderBatch& batch) {
+    std::string_view line = trimView(std::string_view(data + lineStart, lineEnd - lineStart));
+    if (line.empty()) return;
+
+    ParseError error;
+    if (line.front() == '{' && line.back() == '}') {
+        error = decodeJson(data, first, last, batch);
+    } else {
+        char delimiter = 0;
+        for (size_t k = first; k < last && delimiter != ','; ++k) {
+            char c = data[index_[k]];
+            if (c == ',' || c == '|') delimiter = c;
+        }
+        if (delimiter == ',') error = decodeDelimited(data, lineStart, lineEnd, first, last, ',', 9, batch);
+        else if (delimiter == '|') error = decodeDelimited(data, lineStart, lineEnd, first, last, '|', 6, batch);
+        else error = ParseError::UNKNOWN_FORMAT;
+    }
+    if (error != ParseError::OK) batch.errors.push_back({baseOffset + lineStart, error});
+}
+
+namespace {
+
+// Symbols too long to intern are refused before interning
+uint32_t internSymbol(SymbolCache& symbols, std::string_view symbol) {
+    return symbol.size() > MAX_SYMBOL_LENGTH ? 0 : symbols.intern(symbol);
+}
+
+ParseError commitRow(const Row& row, bool hasRemaining, OrderBatch& batch, uint32_t symbolId) {
+    if (row.orderId == 0 || row.quantity == 0 || symbolId == 0) return ParseError::INVALID_ORDER;
+    if (!CompactOrder::pricesOnTick(row.type, row.price, row.stopPrice,
+                                    SymbolTable::instance().getTickSize(symbolId))) {
+        return ParseError::OFF_TICK;
+    }
+    batch.orderIds.push_back(row.orderId);
+    batch.clientIds.push_back(row.clientId);
+    batch.symbolIds.push_back(symbolId);
+    batch.types.push_back(row.type);
+    batch.sides.push_back(row.side);
+    batch.prices.push_back(row.price);
+    batch.quantities.push_back(row.quantity);
+    batch.remainingQtys.push_back(hasRemaining ? row.remainingQty : row.quantity);
+    batch.stopPrices.push_back(row.stopPrice);
+    batch.timeInForces.push_back(row.timeInForce);
+    batch.displayQtys.push_back(row.displayQty);
+    return ParseError::OK;
+}
+
+}
+
+ParseError BulkDecoder::decodeJson(const char* data, size_t first, size_t last, OrderBatch& batch) {
+    const uint32_t* idx = index_.data();
+    auto at = [&](size_t k) { return data[idx[k]]; };
+    // A quote is escaped by an odd run of backslashes before it, so "ab\\"
+    // still ends at its last quote. k is the entry after the opening quote.
+    auto closingQuote = [&](size_t k) {
+        size_t open = idx[k - 1];
+        for (; k < last; ++k) {
+            if (at(k) != '"') continue;
+            size_t run = idx[k];
+            while (run - 1 > open && data[run - 1] == '\\') run--;
+            if ((idx[k] - run) % 2 == 0) break;
+        }
+        return k;
+    };
+    auto view = [&](size_t from, size_t to) { return std::string_view(data + from, to - from); };
+
+    Row row;
+    bool hasSymbol = false, hasType = false, hasSide = false, hasRemaining = false;
+    size_t k = first;
+    if (k == last || at(k) != '{') return ParseError::MALFORMED;
+    k++;
+
+    while (true) {
+        if (k == last) return ParseError::MALFORMED;
+        if (at(k) == '}') break;
+        if (at(k) != '"') return ParseError::MALFORMED;
+        size_t keyClose = closingQuote(k + 1);
+        if (keyClose == last) return ParseError::MALFORMED;
+        std::string_view key = view(idx[k] + 1, idx[keyClose]);
+        k = keyClose + 1;
+
+        if (k == last || at(k) != ':') return ParseError::MALFORMED;
+        size_t colon = idx[k];
+        k++;
+        if (k == last) return ParseError::MALFORMED;
+
+        std::string_view value;
+        if (at(k) == '"') {
+            size_t valueClose = closingQuote(k + 1);
+            if (valueClose == last) return ParseError::MALFORMED;
+            value = view(idx[k] + 1, idx[valueClose]);
+            k = valueClose + 1;
+        } else {
+            value = trimView(view(colon + 1, idx[k]));
+        }
+
+        bool ok = true;
+        if (key == "orderId") ok = parseNumber(value, row.orderId);
+        else if (key == "clientId") ok = parseNumber(value, row.clientId);
+        else if (key == "symbol") { row.symbol = value; hasSymbol = true; }
+        else if (key == "type") { if (!parseOrderType(value, row.type)) return ParseError::BAD_TYPE; hasType = true; }
+        else if (key == "side") { if (!parseOrderSide(value, row.side)) return ParseError::BAD_SIDE; hasSide = true; }
+        else if (key == "price") ok = parsePrice(value, row.price);
+        else if (key == "quantity") ok = parseNumber(value, row.quantity);
+        else if (key == "remainingQty") { ok = parseNumber(value, row.remainingQty); hasRemaining = true; }
+        else if (key == "stopPrice") ok = parsePrice(value, row.stopPrice);
+        else if (key == "displayQty") ok = parseNumber(value, row.displayQty);
+        else if (key == "timeInForce") { if (!parseTimeInForce(value, row.timeInForce)) return ParseError::BAD_TYPE; }
+        if (!ok) return ParseError::BAD_NUMBER;
+
+        if (k == last) return ParseError::MALFORMED;
+        if (at(k) == ',') {
+            k++;
+            continue;
+        }
+        if (at(k) == '}') break;
+        return ParseError::MALFORMED;
+    }
+
+    if (!hasSymbol || !hasType || !hasSide) return ParseError::MISSING_FIELD;
+    return commitRow(row, hasRemaining, batch, internSymbol(symbols_, row.symbol));
+}
+
+// Same field order as OrderParser: orderId, symbol, type, side, price,
+// quantity, then optionally clientId, remainingQty, stopPrice
+ParseError BulkDecoder::decodeDelimited(const char* data, size_t lineStart, size_t lineEnd,
+                                        size_t first, size_t last, char delimiter, size_t maxFields,
+                                        OrderBatch& batch) {
+    std::string_view fields[9];
+    size_t count = 0;
+    size_t fieldStart = lineStart;
+    for (size_t k = first; k < last && count < maxFields; ++k) {
+        size_t p = index_[k];
+        if (data[p] != delimiter) continue;
+        fields[count++] = trimView(std::string_view(data + fieldStart, p - fieldStart));
+        fieldStart = p + 1;
+    }
+    if (count < maxFields) {
+        fields[count++] = trimView(std::string_view(data + fieldStart, lineEnd - fieldStart));
+    }
+    if (count < 6) return ParseError::MISSING_FIELD;
+
+    Row row;
+    if (!parseNumber(fields[0], row.orderId)) return ParseError::BAD_NUMBER;
+    row.symbol = fields[1];
+    if (!parseOrderType(fields[2], row.type)) return ParseError::BAD_TYPE;
+    if (!parseOrderSide(fields[3], row.side)) return ParseError::BAD_SIDE;
+    if (!parsePrice(fields[4], row.price)) return ParseError::BAD_NUMBER;
+    if (!parseNumber(fields[5], row.quantity)) return ParseError::BAD_NUMBER;
+    if (count > 6 && !parseNumber(fields[6], row.clientId)) return ParseError::BAD_NUMBER;
+    bool hasRemaining = count > 7;
+    if (hasRemaining && !parseNumber(fields[7], row.remainingQty)) return ParseError::BAD_NUMBER;
+    if (count > 8 && !parsePrice(fields[8], row.stopPrice)) return ParseError::BAD_NUMBER;
+    return commitRow(row, hasRemaining, batch, internSymbol(symbols_, row.symbol));
+}
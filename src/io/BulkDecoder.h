@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "OrderParser.h"
+#include "../engine/CompactOrder.h"
+#include "../engine/SymbolTable.h"
+
+// Decoded orders stored column by column. Row i of every column belongs to
+// the same order; lines that failed to decode are listed in errors instead.
+struct OrderBatch {
+    struct Error {
+        size_t offset;      // Byte offset of the line in the decoded buffer
+        ParseError error;
+    };
+
+    std::vector<uint64_t> orderIds;
+    std::vector<uint64_t> clientIds;
+    std::vector<uint32_t> symbolIds;
+    std::vector<OrderType> types;
+    std::vector<OrderSide> sides;
+    std::vector<double> prices;
+    std::vector<uint32_t> quantities;
+    std::vector<uint32_t> remainingQtys;
+    std::vector<double> stopPrices;
+    std::vector<TimeInForce> timeInForces;
+    std::vector<uint32_t> displayQtys;
+    std::vector<Error> errors;
+
+    size_t size() const { return orderIds.size(); }
+    bool empty() const { return orderIds.empty(); }
+    void clear();
+    void reserve(size_t count);
+
+    // Converts prices to ticks and stamps the current time. decode() has
+    // refused off-tick rows, as the Matcher would, so no price is rounded.
+    CompactOrder toCompactOrder(size_t i) const;
+    void toCompactOrders(std::vector<CompactOrder>& out) const;
+    Order toOrder(size_t i) const;
+};
+
+// Decodes buffers of newline-delimited orders in any format OrderParser
+// accepts (JSON objects, CSV, pipe-delimited; the format may change from
+// line to line). A first pass finds every structural character with SIMD
+// compares; a second pass walks that index line by line, so field bytes are
+// only touched when a number or name is converted. Field semantics match
+// OrderParser's string_view fast path.
+class BulkDecoder {
+public:
+    enum class Isa { SCALAR, SSE2, AVX2 };
+
+    // Picks the widest instruction set the CPU supports
+    BulkDecoder();
+    // Uses isa, or the best supported one below it
+    explicit BulkDecoder(Isa isa);
+
+    // Appends every decoded line of data to batch. Unless final is set, a
+    // trailing line without '\n' is left alone so the caller can prepend it
+    // to the next chunk. Returns the number of bytes consumed.
+    size_t decode(std::string_view data, OrderBatch& batch, bool final = true);
+
+    Isa getIsa() const;
+    static Isa detectIsa();
+    static const char* isaName(Isa isa);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    void buildIndex(const char* data, size_t length);
+    void decodeLine(const char* data, size_t lineStart, size_t lineEnd,
+                    size_t first, size_t last, size_t baseOffset, OrderBatch& batch);
+    ParseError decodeJson(const char* data, size_t first, size_t last, OrderBatch& batch);
+    ParseError decodeDelimited(const char* data, size_t lineStart, size_t lineEnd,
+                               size_t first, size_t last, char delimiter, size_t maxFields,
+                               OrderBatch& batch);
+
+    Isa isa_;
+    std::vector<uint32_t> index_;   // Offsets of structural characters in the current block
+    size_t indexSize_ = 0;
+    SymbolCache symbols_;
+};
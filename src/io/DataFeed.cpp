@@ -1,215 +1,377 @@
-#include "DataFeed.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <thread>
-
-DataFeed::DataFeed() : connected_(false), running_(false) {}
-
-DataFeed::~DataFeed() {
-    disconnect();
-}
-
-bool DataFeed::connect(const std::string& source) {
-    if (connected_) {
-        std::cout << "Already connected to data source" << std::endl;
-        return true;
-    }
-    
-    source_ = source;
-    
-    // Simulate connection process
-    std::cout << "Connecting to data source: " << source << std::endl;
-    
-    // Check if source is a file
-    if (source.find(".json") != std::string::npos || 
-        source.find(".csv") != std::string::npos ||
-        source.find(".txt") != std::string::npos) {
-        
-        std::ifstream file(source);
-        if (!file.is_open()) {
-            std::cout << "Failed to open file: " << source << std::endl;
-            return false;
-        }
-        file.close();
-        
-        feedType_ = FeedType::FILE;
-        std::cout << "Connected to file data feed: " << source << std::endl;
-    }
-    else if (source.find("tcp://") == 0 || source.find("ws://") == 0) {
-        // Simulate network connection
-        feedType_ = FeedType::NETWORK;
-        std::cout << "Connected to network data feed: " << source << std::endl;
-    }
-    else if (source == "simulation" || source == "random") {
-        feedType_ = FeedType::SIMULATION;
-        std::cout << "Connected to simulation data feed" << std::endl;
-    }
-    else {
-        std::cout << "Unknown data source format: " << source << std::endl;
-        return false;
-    }
-    
-    connected_ = true;
-    return true;
-}
-
-void DataFeed::disconnect() {
-    if (!connected_) return;
-    
-    stop();
-    connected_ = false;
-    std::cout << "Disconnected from data source: " << source_ << std::endl;
-}
-
-void DataFeed::start() {
-    if (!connected_) {
-        std::cout << "Cannot start: not connected to data source" << std::endl;
-        return;
-    }
-    
-    if (running_) {
-        std::cout << "Data feed already running" << std::endl;
-        return;
-    }
-    
-    running_ = true;
-    worker_ = std::thread(&DataFeed::feedWorker, this);
-    std::cout << "Data feed started" << std::endl;
-}
-
-void DataFeed::stop() {
-    if (!running_) return;
-    
-    running_ = false;
-    if (worker_.joinable()) {
-        worker_.join();
-    }
-    std::cout << "Data feed stopped" << std::endl;
-}
-
-void DataFeed::setDataHandler(DataHandler handler) {
-    dataHandler_ = handler;
-}
-
-void DataFeed::feedWorker() {
-    switch (feedType_) {
-        case FeedType::FILE:
-            processFileData();
-            break;
-        case FeedType::NETWORK:
-            processNetworkData();
-            break;
-        case FeedType::SIMULATION:
-            processSimulationData();
-            break;
-    }
-}
-
-void DataFeed::processFileData() {
-    std::ifstream file(source_);
-    if (!file.is_open()) {
-        std::cout << "Error: Could not open file " << source_ << std::endl;
-        return;
-    }
-    
-    std::string line;
-    int lineCount = 0;
-    
-    while (running_ && std::getline(file, line)) {
-        if (!line.empty() && dataHandler_) {
-            dataHandler_(line);
-        }
-        
-        lineCount++;
-        if (lineCount % 1000 == 0) {
-            std::cout << "Processed " << lineCount << " lines from file" << std::endl;
-        }
-        
-        // Small delay to simulate real-time data feed
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-    }
-    
-    file.close();
-    std::cout << "Finished processing file data. Total lines: " << lineCount << std::endl;
-}
-
-void DataFeed::processNetworkData() {
-    // Simulate network data reception
-    int messageCount = 0;
-    
-    while (running_) {
-        // Simulate receiving network messages
-        if (dataHandler_) {
-            std::string simulatedMessage = generateSimulatedNetworkMessage(messageCount);
-            dataHandler_(simulatedMessage);
-        }
-        
-        messageCount++;
-        if (messageCount % 100 == 0) {
-            std::cout << "Received " << messageCount << " network messages" << std::endl;
-        }
-        
-        // Simulate network latency
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-}
-
-void DataFeed::processSimulationData() {
-    int dataCount = 0;
-    std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
-    
-    while (running_) {
-        if (dataHandler_) {
-            std::string simulatedData = generateSimulatedMarketData(rng, dataCount);
-            dataHandler_(simulatedData);
-        }
-        
-        dataCount++;
-        if (dataCount % 50 == 0) {
-            std::cout << "Generated " << dataCount << " simulated data points" << std::endl;
-        }
-        
-        // Simulate market data frequency
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-    }
-}
-
-std::string DataFeed::generateSimulatedNetworkMessage(int messageId) {
-    std::ostringstream oss;
-    oss << "{\"messageId\":" << messageId 
-        << ",\"type\":\"market_data\""
-        << ",\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-               std::chrono::system_clock::now().time_since_epoch()).count()
-        << "}";
-    return oss.str();
-}
-
-std::string DataFeed::generateSimulatedMarketData(std::mt19937& rng, int dataId) {
-    std::uniform_real_distribution<> priceDist(99.0, 101.0);
-    std::uniform_int_distribution<> qtyDist(1, 1000);
-    std::uniform_int_distribution<> sideDist(0, 1);
-    
-    std::ostringstream oss;
-    oss << "{\"dataId\":" << dataId
-        << ",\"symbol\":\"AAPL\""
-        << ",\"price\":" << std::fixed << std::setprecision(2) << priceDist(rng)
-        << ",\"quantity\":" << qtyDist(rng)
-        << ",\"side\":\"" << (sideDist(rng) ? "BUY" : "SELL") << "\""
-        << ",\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-               std::chrono::system_clock::now().time_since_epoch()).count()
-        << "}";
-    return oss.str();
-}
-
-bool DataFeed::isConnected() const {
-    return connected_;
-}
-
-bool DataFeed::isRunning() const {
-    return running_;
-}
-
-std::string DataFeed::getSource() const {
-    return source_;
-}
+#include "DataFeed.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+DataFeed::DataFeed()
+    : connected_(false), running_(false), replayMode_(ReplayMode::AS_FAST_AS_POSSIBLE),
+      replayRate_(1.0), timestampExtractor_(&DataFeed::extractJsonTimestamp),
+      processedLines_(0) {}
+
+DataFeed::~DataFeed() {
+    disconnect();
+}
+
+bool DataFeed::connect(const std::string& source) {
+    if (connected_) {
+        std::cout << "Already connected to data source" << std::endl;
+        return true;
+    }
+    
+    source_ = source;
+    
+    // Simulate connection process
+    std::cout << "Connecting to data source: " << source << std::endl;
+    
+    if (source.size() > 4 && source.compare(source.size() - 4, 4, ".bin") == 0) {
+        std::ifstream file(source, std::ios::binary);
+        if (!file.is_open()) {
+            std::cout << "Failed to open file: " << source << std::endl;
+            return false;
+        }
+        file.close();
+        
+        feedType_ = FeedType::BINARY_FILE;
+        std::cout << "Connected to binary file data feed: " << source << std::endl;
+    }
+    // Check if source is a file
+    else if (source.find(".json") != std::string::npos || 
+        source.find(".csv") != std::string::npos ||
+        source.find(".txt") != std::string::npos) {
+        
+        std::ifstream file(source);
+        if (!file.is_open()) {
+            std::cout << "Failed to open file: " << source << std::endl;
+            return false;
+        }
+        file.close();
+        
+        feedType_ = FeedType::FILE;
+        std::cout << "Connected to file data feed: " << source << std::endl;
+    }
+    else if (source.find("tcp://") == 0 || source.find("ws://") == 0) {
+        // Simulate network connection
+        feedType_ = FeedType::NETWORK;
+        std::cout << "Connected to network data feed: " << source << std::endl;
+    }
+    else if (source == "simulation" || source == "random") {
+        feedType_ = FeedType::SIMULATION;
+        std::cout << "Connected to simulation data feed" << std::endl;
+    }
+    else {
+        std::cout << "Unknown data source format: " << source << std::endl;
+        return false;
+    }
+    
+    connected_ = true;
+    return true;
+}
+
+void DataFeed::disconnect() {
+    if (!connected_) return;
+    
+    stop();
+    connected_ = false;
+    std::cout << "Disconnected from data source: " << source_ << std::endl;
+}
+
+void DataFeed::start() {
+    if (!connected_) {
+        std::cout << "Cannot start: not connected to data source" << std::endl;
+        return;
+    }
+    
+    if (running_) {
+        std::cout << "Data feed already running" << std::endl;
+        return;
+    }
+    
+    running_ = true;
+    processedLines_ = 0;
+    worker_ = std::thread(&DataFeed::feedWorker, this);
+    std::cout << "Data feed started" << std::endl;
+}
+
+void DataFeed::stop() {
+    if (!running_) return;
+    
+    running_ = false;
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    std::cout << "Data feed stopped" << std::endl;
+}
+
+void DataFeed::wait() {
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    running_ = false;
+}
+
+void DataFeed::setDataHandler(DataHandler handler) {
+    dataHandler_ = handler;
+}
+
+void DataFeed::setLineHandler(LineHandler handler) {
+    lineHandler_ = handler;
+}
+
+void DataFeed::setWireHandler(WireHandler handler) {
+    wireHandler_ = handler;
+}
+
+void DataFeed::setReplayMode(ReplayMode mode, double rate) {
+    replayMode_ = mode;
+    replayRate_ = rate > 0 ? rate : 1.0;
+}
+
+void DataFeed::setTimestampExtractor(TimestampExtractor extractor) {
+    timestampExtractor_ = extractor;
+}
+
+bool DataFeed::extractJsonTimestamp(std::string_view line, int64_t& timestampNs) {
+    static constexpr std::string_view key = "\"timestamp\"";
+    size_t pos = line.find(key);
+    if (pos == std::string_view::npos) return false;
+    pos = line.find(':', pos + key.size());
+    if (pos == std::string_view::npos) return false;
+    const char* first = line.data() + pos + 1;
+    const char* last = line.data() + line.size();
+    while (first < last && (*first == ' ' || *first == '\t')) first++;
+
+    // Integers are parsed exactly; fractional values go through double
+    int64_t whole = 0;
+    auto result = std::from_chars(first, last, whole);
+    if (result.ec != std::errc()) return false;
+    if (result.ptr < last && (*result.ptr == '.' || *result.ptr == 'e' || *result.ptr == 'E')) {
+        char buf[64];
+        size_t len = std::min<size_t>(last - first, sizeof(buf) - 1);
+        std::memcpy(buf, first, len);
+        buf[len] = '\0';
+        double value = std::strtod(buf, nullptr);
+        double scale = value < 1e11 ? 1e9 : value < 1e14 ? 1e6 : value < 1e17 ? 1e3 : 1.0;
+        timestampNs = static_cast<int64_t>(std::llround(value * scale));
+        return true;
+    }
+    int64_t scale = whole < 100000000000LL ? 1000000000LL
+                  : whole < 100000000000000LL ? 1000000LL
+                  : whole < 100000000000000000LL ? 1000LL : 1LL;
+    timestampNs = whole * scale;
+    return true;
+}
+
+void DataFeed::feedWorker() {
+    switch (feedType_) {
+        case FeedType::FILE:
+            processFileData();
+            break;
+        case FeedType::BINARY_FILE:
+            processBinaryFileData();
+            break;
+        case FeedType::NETWORK:
+            processNetworkData();
+            break;
+        case FeedType::SIMULATION:
+            processSimulationData();
+            break;
+    }
+}
+
+void DataFeed::processFileData() {
+    MappedFile file;
+    try {
+        file.open(source_);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return;
+    }
+    
+    std::string_view data = file.view();
+    std::string line;
+    uint64_t lineCount = 0;
+    bool paced = replayMode_ == ReplayMode::TIMESTAMP_PACED && timestampExtractor_;
+    ReplayPacer pacer;
+    
+    size_t pos = 0;
+    while (running_ && pos < data.size()) {
+        const void* nl = std::memchr(data.data() + pos, '\n', data.size() - pos);
+        size_t end = nl ? static_cast<size_t>(static_cast<const char*>(nl) - data.data()) : data.size();
+        std::string_view view = data.substr(pos, end - pos);
+        pos = end + 1;
+        if (!view.empty() && view.back() == '\r') view.remove_suffix(1);
+        
+        if (!view.empty()) {
+            int64_t timestampNs;
+            if (paced && timestampExtractor_(view, timestampNs)) {
+                waitUntilDue(timestampNs, pacer);
+            }
+            if (lineHandler_) {
+                lineHandler_(view);
+            } else if (dataHandler_) {
+                line.assign(view.data(), view.size());
+                dataHandler_(line);
+            }
+        }
+        
+        lineCount++;
+        processedLines_.store(lineCount, std::memory_order_relaxed);
+        if (lineCount % 1000000 == 0) {
+            std::cout << "Processed " << lineCount << " lines from file" << std::endl;
+        }
+    }
+    
+    std::cout << "Finished processing file data. Total lines: " << lineCount << std::endl;
+}
+
+void DataFeed::processBinaryFileData() {
+    MappedFile file;
+    try {
+        file.open(source_);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return;
+    }
+    
+    std::string_view data = file.view();
+    size_t start = WireDecoder::checkFileHeader(data);
+    if (start == 0) {
+        std::cout << "Error: " << source_ << " is not a supported binary order file" << std::endl;
+        return;
+    }
+    
+    WireDecoder decoder(data.substr(start));
+    WireMessage message;
+    WireStatus status;
+    uint64_t messageCount = 0;
+    bool paced = replayMode_ == ReplayMode::TIMESTAMP_PACED;
+    ReplayPacer pacer;
+    
+    while (running_ && (status = decoder.next(message)) == WireStatus::OK) {
+        if (paced && message.timestampNs() != 0) {
+            waitUntilDue(static_cast<int64_t>(message.timestampNs()), pacer);
+        }
+        if (wireHandler_) {
+            wireHandler_(message);
+        }
+        
+        messageCount++;
+        processedLines_.store(messageCount, std::memory_order_relaxed);
+        if (messageCount % 1000000 == 0) {
+            std::cout << "Processed " << messageCount << " messages from file" << std::endl;
+        }
+    }
+    
+    if (running_ && status != WireStatus::END) {
+        std::cout << "Error: corrupt binary message at byte " << start + decoder.offset() << std::endl;
+    }
+    std::cout << "Finished processing binary file data. Total messages: " << messageCount << std::endl;
+}
+
+// The first timestamped record anchors replay; later ones are released when
+// their distance from it, scaled by the replay rate, has elapsed
+void DataFeed::waitUntilDue(int64_t timestampNs, ReplayPacer& pacer) {
+    if (!pacer.anchored) {
+        pacer.firstTimestampNs = timestampNs;
+        pacer.start = std::chrono::steady_clock::now();
+        pacer.anchored = true;
+    }
+    auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+        (timestampNs - pacer.firstTimestampNs) / replayRate_));
+    // Sleep in slices so stop() is not held up by long gaps
+    auto due = pacer.start + offset;
+    while (running_ && std::chrono::steady_clock::now() < due) {
+        std::this_thread::sleep_until(std::min(due,
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+    }
+}
+
+void DataFeed::processNetworkData() {
+    // Simulate network data reception
+    int messageCount = 0;
+    
+    while (running_) {
+        // Simulate receiving network messages
+        if (dataHandler_) {
+            std::string simulatedMessage = generateSimulatedNetworkMessage(messageCount);
+            dataHandler_(simulatedMessage);
+        }
+        
+        messageCount++;
+        if (messageCount % 100 == 0) {
+            std::cout << "Received " << messageCount << " network messages" << std::endl;
+        }
+        
+        // Simulate network latency
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void DataFeed::processSimulationData() {
+    int dataCount = 0;
+    std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+    
+    while (running_) {
+        if (dataHandler_) {
+            std::string simulatedData = generateSimulatedMarketData(rng, dataCount);
+            dataHandler_(simulatedData);
+        }
+        
+        dataCount++;
+        if (dataCount % 50 == 0) {
+            std::cout << "Generated " << dataCount << " simulated data points" << std::endl;
+        }
+        
+        // Simulate market data frequency
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+std::string DataFeed::generateSimulatedNetworkMessage(int messageId) {
+    std::ostringstream oss;
+    oss << "{\"messageId\":" << messageId 
+        << ",\"type\":\"market_data\""
+        << ",\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count()
+        << "}";
+    return oss.str();
+}
+
+std::string DataFeed::generateSimulatedMarketData(std::mt19937& rng, int dataId) {
+    std::uniform_real_distribution<> priceDist(99.0, 101.0);
+    std::uniform_int_distribution<> qtyDist(1, 1000);
+    std::uniform_int_distribution<> sideDist(0, 1);
+    
+    std::ostringstream oss;
+    oss << "{\"dataId\":" << dataId
+        << ",\"symbol\":\"AAPL\""
+        << ",\"price\":" << std::fixed << std::setprecision(2) << priceDist(rng)
+        << ",\"quantity\":" << qtyDist(rng)
+        << ",\"side\":\"" << (sideDist(rng) ? "BUY" : "SELL") << "\""
+        << ",\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count()
+        << "}";
+    return oss.str();
+}
+
+bool DataFeed::isConnected() const {
+    return connected_;
+}
+
+bool DataFeed::isRunning() const {
+    return running_;
+}
+
+std::string DataFeed::getSource() const {
+    return source_;
+}
+
+uint64_t DataFeed::getProcessedLines() const {
+    return processedLines_.load(std::memory_order_relaxed);
+}
@@ -1,54 +1,101 @@
-#pragma once
-#include <string>
-#include <functional>
-#include <thread>
-#include <atomic>
-#include <random>
-#include <chrono>
-#include <iomanip>
-
-enum class FeedType {
-    FILE,
-    NETWORK, 
-    SIMULATION
-};
-
-using DataHandler = std::function<void(const std::string&)>;
-
-class DataFeed {
-public:
-    DataFeed();
-    ~DataFeed();
-    
-    // Connection management
-    bool connect(const std::string& source);
-    void disconnect();
-    
-    // Data streaming
-    void start();
-    void stop();
-    
-    // Configuration
-    void setDataHandler(DataHandler handler);
-    
-    // Status
-    bool isConnected() const;
-    bool isRunning() const;
-    std::string getSource() const;
-
-private:
-    void feedWorker();
-    void processFileData();
-    void processNetworkData();
-    void processSimulationData();
-    
-    std::string generateSimulatedNetworkMessage(int messageId);
-    std::string generateSimulatedMarketData(std::mt19937& rng, int dataId);
-    
-    std::string source_;
-    FeedType feedType_;
-    std::atomic<bool> connected_;
-    std::atomic<bool> running_;
-    std::thread worker_;
-    DataHandler dataHandler_;
-};
+#pragma once
+#include <string>
+#include <string_view>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include "WireFormat.h"
+
+enum class FeedType {
+    FILE,
+    BINARY_FILE,    // WireFormat messages, replayed without parsing
+    NETWORK, 
+    SIMULATION
+};
+
+// File replay speed. TIMESTAMP_PACED releases each line when its embedded
+// timestamp falls due relative to the first one, scaled by the replay rate;
+// lines without a timestamp are released immediately.
+enum class ReplayMode {
+    AS_FAST_AS_POSSIBLE,
+    TIMESTAMP_PACED
+};
+
+using DataHandler = std::function<void(const std::string&)>;
+// Receives slices of the mapped file; the view is only valid during the call
+using LineHandler = std::function<void(std::string_view)>;
+// Receives each message of a binary feed
+using WireHandler = std::function<void(const WireMessage&)>;
+// Pulls a record's timestamp in nanoseconds; returns false if it has none
+using TimestampExtractor = std::function<bool(std::string_view, int64_t&)>;
+
+class DataFeed {
+public:
+    DataFeed();
+    ~DataFeed();
+    
+    // Connection management
+    bool connect(const std::string& source);
+    void disconnect();
+    
+    // Data streaming
+    void start();
+    void stop();
+    
+    // Blocks until a file feed has delivered every line
+    void wait();
+    
+    // Configuration
+    void setDataHandler(DataHandler handler);
+    // Preferred for file feeds: lines are passed without copying. Takes
+    // precedence over the DataHandler when both are set.
+    void setLineHandler(LineHandler handler);
+    void setWireHandler(WireHandler handler);
+    // rate scales paced replay, e.g. 10.0 replays ten times faster
+    void setReplayMode(ReplayMode mode, double rate = 1.0);
+    void setTimestampExtractor(TimestampExtractor extractor);
+    
+    // Reads a JSON "timestamp" field; seconds, ms, us or ns are told apart
+    // by magnitude
+    static bool extractJsonTimestamp(std::string_view line, int64_t& timestampNs);
+    
+    // Status
+    bool isConnected() const;
+    bool isRunning() const;
+    std::string getSource() const;
+    // Lines for text feeds, messages for binary ones
+    uint64_t getProcessedLines() const;
+
+private:
+    void feedWorker();
+    void processFileData();
+    void processBinaryFileData();
+    
+    struct ReplayPacer {
+        bool anchored = false;
+        int64_t firstTimestampNs = 0;
+        std::chrono::steady_clock::time_point start;
+    };
+    void waitUntilDue(int64_t timestampNs, ReplayPacer& pacer);
+    void processNetworkData();
+    void processSimulationData();
+    
+    std::string generateSimulatedNetworkMessage(int messageId);
+    std::string generateSimulatedMarketData(std::mt19937& rng, int dataId);
+    
+    std::string source_;
+    FeedType feedType_;
+    std::atomic<bool> connected_;
+    std::atomic<bool> running_;
+    std::thread worker_;
+    DataHandler dataHandler_;
+    LineHandler lineHandler_;
+    WireHandler wireHandler_;
+    ReplayMode replayMode_;
+    double replayRate_;
+    TimestampExtractor timestampExtractor_;
+    std::atomic<uint64_t> processedLines_;
+};
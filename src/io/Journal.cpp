@@ -0,0 +1,417 @@
+#include "Journal.h"
+#include "../engine/SymbolTable.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OBME_HAVE_POSIX_IO 1
+#endif
+
+namespace {
+
+constexpr size_t REPLAY_BATCH = 1024;
+
+JournalFileHeader makeHeader(uint64_t baseSequence) {
+    JournalFileHeader header{};
+    std::memcpy(header.magic, JOURNAL_FILE_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.recordSize = sizeof(JournalRecord);
+    header.baseSequence = baseSequence;
+    return header;
+}
+
+#ifdef OBME_HAVE_POSIX_IO
+void writeAll(int fd, const void* data, size_t size, size_t offset, const std::string& path) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written < 0) throw std::runtime_error("Failed to write journal: " + path);
+        bytes += written;
+        offset += static_cast<size_t>(written);
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void syncData(int fd, const std::string& path) {
+#ifdef __linux__
+    int result = ::fdatasync(fd);
+#else
+    int result = ::fsync(fd);
+#endif
+    if (result != 0) throw std::runtime_error("Failed to sync journal: " + path);
+}
+
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+}
+
+// Base sequences of the closed segments path.<base>, oldest first
+std::vector<uint64_t> segmentBases(const std::string& path) {
+    std::vector<uint64_t> bases;
+    size_t slash = path.find_last_of('/');
+    std::string prefix = (slash == std::string::npos ? path : path.substr(slash + 1)) + ".";
+    DIR* dir = ::opendir(directoryOf(path).c_str());
+    if (!dir) return bases;
+    while (dirent* entry = ::readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+        std::string suffix = name.substr(prefix.size());
+        if (suffix.find_first_not_of("0123456789") != std::string::npos) continue;
+        bases.push_back(std::stoull(suffix));
+    }
+    ::closedir(dir);
+    std::sort(bases.begin(), bases.end());
+    return bases;
+}
+
+// Makes a rename into the journal's directory durable
+void syncDirectory(const std::string& path) {
+    std::string dir = directoryOf(path);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Failed to open journal directory: " + dir);
+    int result = ::fsync(fd);
+    ::close(fd);
+    if (result != 0) throw std::runtime_error("Failed to sync journal directory: " + dir);
+}
+#endif
+
+}
+
+// Cheap enough to check on every replayed record and sensitive to the torn
+// or zeroed tails a crash leaves behind
+uint32_t journalChecksum(const JournalRecord& record) {
+    uint64_t words[sizeof(JournalRecord) / 8];
+    std::memcpy(words, &record, sizeof(words));
+    words[0] &= 0xffffffffULL;      // type without the checksum itself
+    uint64_t hash = 0x9e3779b97f4a7c15ULL;
+    for (uint64_t word : words) {
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 29;
+    }
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+JournalWriter::JournalWriter(const std::string& path, JournalConfig config)
+    : path_(path), config_(config) {
+#ifdef OBME_HAVE_POSIX_IO
+    if (config_.preallocateBytes < sizeof(JournalRecord)) config_.preallocateBytes = sizeof(JournalRecord);
+    closedBases_ = segmentBases(path);
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || st.st_size == 0) {
+        // A new journal, or a crash between rotate's rename and the new file
+        if (!closedBases_.empty()) {
+            JournalReader reader(path + "." + std::to_string(closedBases_.back()));
+            reader.skipToEnd();
+            sequence_ = baseSequence_ = reader.getLastSequence();
+        }
+        openFresh();
+        return;
+    }
+    size_t resumeAt;
+    {
+        JournalReader reader(path);
+        reader.skipToEnd();
+        resumeAt = reader.getEndOffset();
+        sequence_ = reader.getLastSequence();
+        baseSequence_ = reader.getBaseSequence();
+    }
+    fd_ = ::open(path.c_str(), O_RDWR, 0644);
+    if (fd_ < 0) throw std::runtime_error("Failed to open journal: " + path);
+    // Drop whatever follows the intact records (a torn write, or stale
+    // records past it) so it can never be mistaken for new ones
+    if (::ftruncate(fd_, static_cast<off_t>(resumeAt)) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to truncate journal: " + path);
+    }
+    capacity_ = resumeAt;
+    offset_ = resumeAt;
+    reserve(sizeof(JournalRecord));
+    syncData(fd_, path_);
+#else
+    (void)config;
+    throw std::runtime_error("Journaling needs POSIX file I/O: " + path);
+#endif
+}
+
+JournalWriter::~JournalWriter() {
+#ifdef OBME_HAVE_POSIX_IO
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+uint64_t JournalWriter::append(const CompactOrder* orders, size_t count) {
+    if (count == 0) return sequence_;
+    // Reject the whole batch before any state changes
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t symbolId = orders[i].symbolId;
+        if (symbolId < knownSymbols_.size() && knownSymbols_[symbolId]) continue;
+        const std::string& name = SymbolTable::instance().name(symbolId);
+        if (name.size() >= JOURNAL_SYMBOL_SIZE) {
+            throw std::invalid_argument("Symbol too long for the journal: " + name);
+        }
+    }
+    pending_.clear();
+    uint64_t sequence = sequence_;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t symbolId = orders[i].symbolId;
+        if (symbolId >= knownSymbols_.size() || !knownSymbols_[symbolId]) addSymbol(symbolId);
+        JournalRecord record;
+        record.type = JournalRecordType::ORDER;
+        record.sequence = ++sequence;
+        std::memcpy(record.payload, &orders[i], sizeof(record.payload));
+        record.checksum = journalChecksum(record);
+        pending_.push_back(record);
+    }
+#ifdef OBME_HAVE_POSIX_IO
+    size_t bytes = pending_.size() * sizeof(JournalRecord);
+    reserve(bytes);
+    writeAll(fd_, pending_.data(), bytes, offset_, path_);
+    offset_ += bytes;
+    if (config_.sync) {
+        syncData(fd_, path_);
+        syncCount_++;
+    }
+#endif
+    sequence_ = sequence;
+    return sequence_;
+}
+
+void JournalWriter::addSymbol(uint32_t symbolId) {
+    if (symbolId >= knownSymbols_.size()) knownSymbols_.resize(symbolId + 1, false);
+    knownSymbols_[symbolId] = true;
+    if (symbolId == 0) return;      // No symbol; nothing to bind
+    const std::string& name = SymbolTable::instance().name(symbolId);
+    JournalSymbol symbol{};
+    symbol.symbolId = symbolId;
+    symbol.tickSize = SymbolTable::instance().getTickSize(symbolId);
+    std::memcpy(symbol.name, name.data(), name.size());
+    JournalRecord record;
+    record.type = JournalRecordType::SYMBOL;
+    record.sequence = 0;
+    std::memcpy(record.payload, &symbol, sizeof(record.payload));
+    record.checksum = journalChecksum(record);
+    pending_.push_back(record);
+}
+
+void JournalWriter::rotate() {
+#ifdef OBME_HAVE_POSIX_IO
+    if (sequence_ == baseSequence_) return;     // Nothing to close
+    std::string segment = path_ + "." + std::to_string(baseSequence_);
+    if (::rename(path_.c_str(), segment.c_str()) != 0) {
+        throw std::runtime_error("Failed to rotate journal: " + path_);
+    }
+    ::close(fd_);
+    fd_ = -1;
+    closedBases_.push_back(baseSequence_);
+    baseSequence_ = sequence_;
+    openFresh();
+    syncDirectory(path_);
+#endif
+}
+
+void JournalWriter::dropThrough(uint64_t sequence) {
+#ifdef OBME_HAVE_POSIX_IO
+    // A closed segment ends where the next one (or the active file) begins
+    size_t dropped = 0;
+    while (dropped < closedBases_.size()) {
+        uint64_t end = dropped + 1 < closedBases_.size() ? closedBases_[dropped + 1] : baseSequence_;
+        if (end > sequence) break;
+        std::string segment = path_ + "." + std::to_string(closedBases_[dropped]);
+        // Already gone if an earlier call failed part way
+        if (::unlink(segment.c_str()) != 0 && errno != ENOENT) {
+            throw std::runtime_error("Failed to delete journal segment: " + segment);
+        }
+        dropped++;
+    }
+    closedBases_.erase(closedBases_.begin(), closedBases_.begin() + static_cast<std::ptrdiff_t>(dropped));
+    if (dropped) syncDirectory(path_);
+#else
+    (void)sequence;
+#endif
+}
+
+// Starts the active file at baseSequence_; the new file binds its own symbols
+void JournalWriter::openFresh() {
+#ifdef OBME_HAVE_POSIX_IO
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) throw std::runtime_error("Failed to open journal: " + path_);
+    offset_ = 0;
+    capacity_ = 0;
+    knownSymbols_.clear();
+    JournalFileHeader header = makeHeader(baseSequence_);
+    reserve(sizeof(header) + sizeof(JournalRecord));
+    writeAll(fd_, &header, sizeof(header), 0, path_);
+    offset_ = sizeof(header);
+    syncData(fd_, path_);
+#endif
+}
+
+std::vector<std::string> JournalWriter::listFiles(const std::string& path) {
+    std::vector<std::string> files;
+#ifdef OBME_HAVE_POSIX_IO
+    for (uint64_t base : segmentBases(path)) files.push_back(path + "." + std::to_string(base));
+#endif
+    files.push_back(path);
+    return files;
+}
+
+// Grows the file in preallocated steps so appends stay inside allocated,
+// already zeroed blocks
+void JournalWriter::reserve(size_t bytes) {
+#ifdef OBME_HAVE_POSIX_IO
+    if (offset_ + bytes <= capacity_) return;
+    size_t target = std::max(capacity_ + config_.preallocateBytes, offset_ + bytes);
+#ifdef __linux__
+    int result = ::posix_fallocate(fd_, static_cast<off_t>(capacity_),
+                                   static_cast<off_t>(target - capacity_));
+#else
+    int result = ::ftruncate(fd_, static_cast<off_t>(target));
+#endif
+    if (result != 0) throw std::runtime_error("Failed to preallocate journal: " + path_);
+    capacity_ = target;
+#else
+    (void)bytes;
+#endif
+}
+
+uint64_t JournalWriter::getLastSequence() const {
+    return sequence_;
+}
+
+size_t JournalWriter::getSegmentCount() const {
+    return closedBases_.size();
+}
+
+uint64_t JournalWriter::getBaseSequence() const {
+    return baseSequence_;
+}
+
+uint64_t JournalWriter::getSyncCount() const {
+    return syncCount_;
+}
+
+const std::string& JournalWriter::getPath() const {
+    return path_;
+}
+
+JournalReader::JournalReader(const std::string& path) : path_(path), file_(path) {
+    std::string_view data = file_.view();
+    JournalFileHeader header;
+    if (data.size() < sizeof(header)) throw std::runtime_error("Not a journal: " + path);
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, JOURNAL_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != JOURNAL_VERSION || header.recordSize != sizeof(JournalRecord)) {
+        throw std::runtime_error("Not a journal: " + path);
+    }
+    offset_ = sizeof(header);
+    sequence_ = baseSequence_ = header.baseSequence;
+    symbolMap_.push_back(0);
+}
+
+bool JournalReader::next(CompactOrder& out) {
+    JournalRecord record;
+    while (readRecord(record)) {
+        if (record.type == JournalRecordType::SYMBOL) {
+            bindSymbol(record);
+            continue;
+        }
+        std::memcpy(&out, record.payload, sizeof(out));
+        out.symbolId = out.symbolId < symbolMap_.size() ? symbolMap_[out.symbolId] : 0;
+        return true;
+    }
+    return false;
+}
+
+void JournalReader::skipToEnd() {
+    JournalRecord record;
+    while (readRecord(record)) {}
+}
+
+bool JournalReader::skipThrough(uint64_t sequence) {
+    if (sequence < sequence_) {
+        throw std::runtime_error("Journal starts after sequence " + std::to_string(sequence) + ": " + path_);
+    }
+    JournalRecord record;
+    while (sequence_ < sequence && readRecord(record)) {
+        if (record.type == JournalRecordType::SYMBOL) bindSymbol(record);
+    }
+    return sequence_ >= sequence;
+}
+
+size_t JournalReader::replay(OrderBook& book) {
+    return replayBatches([&](const CompactOrder* orders, size_t count) {
+        book.addOrders(orders, count);
+    });
+}
+
+// Same per-symbol grouping as Matcher::applyBatch
+size_t JournalReader::replay(BookRegistry& books) {
+    return replayBatches([&](const CompactOrder* orders, size_t count) {
+        size_t start = 0;
+        while (start < count) {
+            uint32_t symbolId = orders[start].symbolId;
+            size_t end = start + 1;
+            while (end < count && orders[end].symbolId == symbolId) end++;
+            books.getBook(symbolId).addOrders(orders + start, end - start);
+            start = end;
+        }
+    });
+}
+
+uint64_t JournalReader::getLastSequence() const {
+    return sequence_;
+}
+
+uint64_t JournalReader::getBaseSequence() const {
+    return baseSequence_;
+}
+
+size_t JournalReader::getEndOffset() const {
+    return offset_;
+}
+
+template<typename Apply>
+size_t JournalReader::replayBatches(Apply apply) {
+    std::vector<CompactOrder> batch(REPLAY_BATCH);
+    size_t total = 0;
+    size_t count;
+    do {
+        count = 0;
+        while (count < batch.size() && next(batch[count])) count++;
+        if (count) apply(batch.data(), count);
+        total += count;
+    } while (count == batch.size());
+    return total;
+}
+
+// Stops at unwritten space, a bad checksum or a sequence gap
+bool JournalReader::readRecord(JournalRecord& out) {
+    std::string_view data = file_.view();
+    if (data.size() - offset_ < sizeof(JournalRecord)) return false;
+    std::memcpy(&out, data.data() + offset_, sizeof(out));
+    if (out.type != JournalRecordType::ORDER && out.type != JournalRecordType::SYMBOL) return false;
+    if (out.checksum != journalChecksum(out)) return false;
+    if (out.type == JournalRecordType::ORDER) {
+        if (out.sequence != sequence_ + 1) return false;
+        sequence_ = out.sequence;
+    }
+    offset_ += sizeof(JournalRecord);
+    return true;
+}
+
+void JournalReader::bindSymbol(const JournalRecord& record) {
+    JournalSymbol symbol;
+    std::memcpy(&symbol, record.payload, sizeof(symbol));
+    std::string name(symbol.name, strnlen(symbol.name, sizeof(symbol.name)));
+    uint32_t localId = SymbolTable::instance().intern(name);
+    SymbolTable::instance().setTickSize(localId, symbol.tickSize);
+    if (symbol.symbolId >= symbolMap_.size()) symbolMap_.resize(symbol.symbolId + 1, 0);
+    symbolMap_[symbol.symbolId] = localId;
+}
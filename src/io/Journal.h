@@ -0,0 +1,171 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MappedFile.h"
+#include "../engine/BookRegistry.h"
+#include "../engine/CompactOrder.h"
+#include "../engine/OrderBook.h"
+
+// Append-only, sequenced record of every message the matcher applies, so a
+// crashed engine can be rebuilt by replaying it into fresh books.
+//
+// A journal file is a JournalFileHeader followed by fixed-size records. ORDER
+// records hold the CompactOrder exactly as the matcher saw it, numbered from
+// 1 with no gaps. Symbol ids are only meaningful inside one process, so the
+// first time an id appears a SYMBOL record binds it to its name and tick
+// size; the reader re-interns the name and remaps later orders. The file is
+// preallocated with zeros, so the first record whose type is zero, whose
+// checksum fails or whose sequence skips marks the end of the intact journal.
+// When a snapshot starts the file is closed as a segment and numbering
+// carries on in a fresh file whose header's baseSequence is the last message
+// before it; segments are deleted once a snapshot covers them.
+
+constexpr char JOURNAL_FILE_MAGIC[8] = {'O', 'B', 'M', 'E', 'J', 'R', 'N', 'L'};
+constexpr uint16_t JOURNAL_VERSION = 2;
+constexpr size_t JOURNAL_SYMBOL_SIZE = 48;
+
+enum class JournalRecordType : uint32_t {
+    NONE = 0,       // Preallocated space not yet written
+    ORDER = 1,
+    SYMBOL = 2,
+    BOOK = 3,       // Snapshot files only
+    RESTING = 4     // Snapshot files only
+};
+
+struct JournalFileHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t reserved;
+    uint64_t baseSequence;      // The first record is baseSequence + 1
+    uint64_t reserved2;
+};
+
+struct JournalRecord {
+    JournalRecordType type;
+    uint32_t checksum;          // Over every other byte of the record
+    uint64_t sequence;          // ORDER only; zero for SYMBOL
+    unsigned char payload[64];  // CompactOrder or JournalSymbol
+};
+
+struct JournalSymbol {
+    uint32_t symbolId;          // Id in the writing process
+    uint32_t reserved;
+    double tickSize;
+    char name[JOURNAL_SYMBOL_SIZE];     // NUL padded
+};
+
+static_assert(MAX_SYMBOL_LENGTH < JOURNAL_SYMBOL_SIZE, "Every internable symbol must fit a record");
+static_assert(sizeof(JournalFileHeader) == 32, "JournalFileHeader layout changed");
+static_assert(sizeof(JournalRecord) == 80, "JournalRecord layout changed");
+static_assert(sizeof(CompactOrder) == sizeof(JournalRecord::payload), "CompactOrder must fill a record");
+static_assert(sizeof(JournalSymbol) == sizeof(JournalRecord::payload), "JournalSymbol must fill a record");
+static_assert(std::is_trivially_copyable<JournalRecord>::value, "Journal records must be trivially copyable");
+
+// Word-wise multiply/xor-shift mix over every byte but the checksum field;
+// also frames snapshot records
+uint32_t journalChecksum(const JournalRecord& record);
+
+struct JournalConfig {
+    size_t preallocateBytes = 64 * 1024 * 1024;     // Also the step the file grows by
+    bool sync = true;           // fdatasync once per appended batch
+};
+
+// Writes a journal through a preallocated file. Because the file's size only
+// changes when a preallocated step fills up, fdatasync normally has no
+// metadata to flush. Not thread-safe: one writer per matcher thread.
+class JournalWriter {
+public:
+    // Creates the file, or reopens an existing journal and continues after
+    // its last intact record. Throws std::runtime_error on I/O errors.
+    explicit JournalWriter(const std::string& path, JournalConfig config = JournalConfig());
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // Numbers the orders, writes them with one pwrite and, when configured,
+    // makes them durable with one fdatasync before returning. Returns the
+    // sequence of the last order. Symbols longer than JOURNAL_SYMBOL_SIZE - 1
+    // throw std::invalid_argument.
+    uint64_t append(const CompactOrder* orders, size_t count);
+    // Closes the current file as the segment path.<its base sequence> and
+    // carries on in a fresh file at path, so a snapshot taken at
+    // getLastSequence() needs nothing from the closed segments. Cheap: a
+    // rename and a new preallocated file, no copying.
+    void rotate();
+    // Deletes the closed segments holding only messages up to sequence,
+    // once a snapshot covers them
+    void dropThrough(uint64_t sequence);
+    // Closed segments oldest first, then the active file: what recovery
+    // replays, in that order
+    static std::vector<std::string> listFiles(const std::string& path);
+
+    uint64_t getLastSequence() const;
+    // Of the active file
+    uint64_t getBaseSequence() const;
+    size_t getSegmentCount() const;
+    uint64_t getSyncCount() const;
+    const std::string& getPath() const;
+
+private:
+    void addSymbol(uint32_t symbolId);
+    void openFresh();
+    void reserve(size_t bytes);
+
+    std::string path_;
+    JournalConfig config_;
+    int fd_ = -1;
+    size_t offset_ = 0;         // Where the next record goes
+    size_t capacity_ = 0;       // Bytes preallocated so far
+    uint64_t sequence_ = 0;
+    uint64_t baseSequence_ = 0;
+    uint64_t syncCount_ = 0;
+    std::vector<JournalRecord> pending_;
+    std::vector<bool> knownSymbols_;    // Indexed by symbol id
+    std::vector<uint64_t> closedBases_; // Base sequences of closed segments
+};
+
+// Reads the intact prefix of a journal. Recovery replays it through
+// OrderBook::addOrders exactly as Matcher applies batches, so the rebuilt
+// books produce the same trades in the same order.
+class JournalReader {
+public:
+    // Throws std::runtime_error if the file is missing or not a journal
+    explicit JournalReader(const std::string& path);
+
+    // Next order, with its symbol id remapped into this process; false at
+    // the end of the intact records
+    bool next(CompactOrder& out);
+    // Validates the rest of the journal without applying or remapping it
+    void skipToEnd();
+    // Skips the messages up to and including sequence, binding symbols on
+    // the way, so replay can pick up after a snapshot taken at sequence.
+    // Returns false if the file ends first. Throws std::runtime_error if it
+    // starts after sequence: the messages in between are missing.
+    bool skipThrough(uint64_t sequence);
+    // Apply every remaining order and return how many were applied
+    size_t replay(OrderBook& book);
+    size_t replay(BookRegistry& books);
+
+    uint64_t getLastSequence() const;
+    uint64_t getBaseSequence() const;
+    // Header plus intact records; a writer resumes here
+    size_t getEndOffset() const;
+
+private:
+    template<typename Apply>
+    size_t replayBatches(Apply apply);
+    bool readRecord(JournalRecord& out);
+    void bindSymbol(const JournalRecord& record);
+
+    std::string path_;
+    MappedFile file_;
+    size_t offset_ = 0;
+    uint64_t sequence_ = 0;
+    uint64_t baseSequence_ = 0;
+    std::vector<uint32_t> symbolMap_;   // Journal symbol id -> local id
+};
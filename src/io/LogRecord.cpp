@@ -0,0 +1,97 @@
+#include "LogRecord.h"
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+LogRecord makeOrderBatchRecord(uint64_t count, uint64_t firstId, uint64_t lastId) {
+    LogRecord record{};
+    record.event = LogEvent::ORDER_BATCH;
+    record.args[0] = count;
+    record.args[1] = firstId;
+    record.args[2] = lastId;
+    return record;
+}
+
+LogRecord makeTradeRecord(uint64_t buyId, uint64_t sellId, double price, uint32_t qty) {
+    LogRecord record{};
+    record.event = LogEvent::TRADE;
+    record.args[0] = buyId;
+    record.args[1] = sellId;
+    std::memcpy(&record.args[2], &price, sizeof(price));
+    record.args[3] = qty;
+    return record;
+}
+
+std::string formatOrderBatch(uint64_t count, uint64_t firstId, uint64_t lastId) {
+    return "Orders processed: count=" + std::to_string(count) +
+           ", first=" + std::to_string(firstId) +
+           ", last=" + std::to_string(lastId);
+}
+
+std::string formatTrade(uint64_t buyId, uint64_t sellId, double price, uint32_t qty) {
+    return "TRADE: buy=" + std::to_string(buyId) + ",sell=" + std::to_string(sellId) +
+           ",price=" + std::to_string(price) + ",qty=" + std::to_string(qty);
+}
+
+void LogRecordFormatter::append(std::string& out, const LogRecord& record) {
+    switch (record.event) {
+        case LogEvent::MESSAGE: {
+            if (record.producer >= pendingMessages_.size()) {
+                pendingMessages_.resize(record.producer + 1);
+            }
+            std::string& pending = pendingMessages_[record.producer];
+            pending.append(record.text, std::min<size_t>(record.length, LOG_TEXT_CAPACITY));
+            if (record.flags & LOG_CONTINUES) return;
+            out += prefixFor(record.timestampNs);
+            out += pending;
+            pending.clear();
+            break;
+        }
+        case LogEvent::ORDER_BATCH:
+            out += prefixFor(record.timestampNs);
+            out += formatOrderBatch(record.args[0], record.args[1], record.args[2]);
+            break;
+        case LogEvent::TRADE: {
+            double price;
+            std::memcpy(&price, &record.args[2], sizeof(price));
+            out += prefixFor(record.timestampNs);
+            out += formatTrade(record.args[0], record.args[1], price,
+                               static_cast<uint32_t>(record.args[3]));
+            break;
+        }
+        default:
+            out += prefixFor(record.timestampNs);
+            out += "Unknown log event " + std::to_string(static_cast<uint16_t>(record.event));
+            break;
+    }
+    out += '\n';
+}
+
+// Formatting localtime is the expensive part, so only redo it when the
+// second changes and patch the milliseconds in place otherwise
+const std::string& LogRecordFormatter::prefixFor(uint64_t timestampNs) {
+    uint64_t second = timestampNs / 1000000000ULL;
+    uint64_t millis = (timestampNs / 1000000ULL) % 1000;
+    if (second != prefixSecond_) {
+        std::time_t time_t = static_cast<std::time_t>(second);
+        // localtime_r: the writer thread formats while producers may be
+        // formatting their own SYNC timestamps
+        std::tm local{};
+        localtime_r(&time_t, &local);
+        std::ostringstream oss;
+        oss << "[" << std::put_time(&local, "%Y-%m-%d %H:%M:%S") << ".000] ";
+        prefix_ = oss.str();
+        prefixSecond_ = second;
+        prefixMillis_ = UINT64_MAX;
+    }
+    if (millis != prefixMillis_) {
+        size_t pos = prefix_.size() - 5;
+        prefix_[pos] = static_cast<char>('0' + millis / 100);
+        prefix_[pos + 1] = static_cast<char>('0' + (millis / 10) % 10);
+        prefix_[pos + 2] = static_cast<char>('0' + millis % 10);
+        prefixMillis_ = millis;
+    }
+    return prefix_;
+}
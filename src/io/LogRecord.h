@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fixed-size binary log record written by hot threads in the async logging
+// modes. Numeric events carry their fields in args; free-form messages are
+// split across as many MESSAGE records as needed, chained with LOG_CONTINUES.
+enum class LogEvent : uint16_t {
+    MESSAGE = 0,
+    ORDER_BATCH = 1,    // args: count, first orderId, last orderId
+    TRADE = 2           // args: buy orderId, sell orderId, price (double bits), qty
+};
+
+constexpr uint16_t LOG_CONTINUES = 0x1;
+constexpr size_t LOG_TEXT_CAPACITY = 48;
+
+struct LogRecord {
+    uint64_t timestampNs;   // Wall clock, nanoseconds since the epoch
+    LogEvent event;
+    uint16_t flags;
+    uint16_t length;        // MESSAGE: bytes of text used
+    uint16_t producer;      // Writing thread's ring; keys LOG_CONTINUES chains
+    union {
+        uint64_t args[6];
+        char text[LOG_TEXT_CAPACITY];
+    };
+};
+
+static_assert(sizeof(LogRecord) == 64, "LogRecord must stay one cache line");
+
+// Binary log files start with this header followed by raw LogRecords
+struct LogFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+constexpr char LOG_FILE_MAGIC[8] = {'O', 'B', 'M', 'E', 'L', 'O', 'G', '1'};
+constexpr uint32_t LOG_FILE_VERSION = 1;
+
+LogRecord makeOrderBatchRecord(uint64_t count, uint64_t firstId, uint64_t lastId);
+LogRecord makeTradeRecord(uint64_t buyId, uint64_t sellId, double price, uint32_t qty);
+
+// Event text without the timestamp prefix, identical to the synchronous logger
+std::string formatOrderBatch(uint64_t count, uint64_t firstId, uint64_t lastId);
+std::string formatTrade(uint64_t buyId, uint64_t sellId, double price, uint32_t qty);
+
+// Turns records back into "[timestamp] event" lines. MESSAGE records that
+// continue are buffered per producer until their last chunk arrives, so
+// chains from different threads may interleave freely.
+class LogRecordFormatter {
+public:
+    void append(std::string& out, const LogRecord& record);
+
+private:
+    const std::string& prefixFor(uint64_t timestampNs);
+
+    std::vector<std::string> pendingMessages_;    // Indexed by producer
+    std::string prefix_;
+    uint64_t prefixSecond_ = UINT64_MAX;
+    uint64_t prefixMillis_ = UINT64_MAX;
+};
@@ -1,41 +1,103 @@
-#include "Logger.h"
-#include <iomanip>
-#include <sstream>
-
-Logger::Logger(const std::string& filename) {
-    file_.open(filename, std::ios::out | std::ios::app);
-    if (!file_.is_open()) {
-        throw std::runtime_error("Failed to open log file: " + filename);
-    }
-    
-    // Log initialization
-    log("Logger initialized - " + filename);
-}
-
-Logger::~Logger() {
-    if (file_.is_open()) {
-        log("Logger shutting down");
-        file_.close();
-    }
-}
-
-void Logger::log(const std::string& event) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::ostringstream oss;
-    oss << "[" << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    oss << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
-    oss << event << std::endl;
-    
-    file_ << oss.str();
-    file_.flush();
-}
-
-void Logger::logTrade(const std::string& tradeInfo) {
-    log("TRADE: " + tradeInfo);
-}
+#include "Logger.h"
+#include <iomanip>
+#include <sstream>
+
+Logger::Logger(const std::string& filename, LogMode mode, AsyncLogConfig asyncConfig)
+    : mode_(mode) {
+    auto openMode = std::ios::out | std::ios::app;
+    if (mode_ == LogMode::ASYNC_BINARY) openMode |= std::ios::binary;
+    file_.open(filename, openMode);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Failed to open log file: " + filename);
+    }
+    if (mode_ != LogMode::SYNC) {
+        async_ = std::make_unique<AsyncLogWriter>(file_, mode_, asyncConfig);
+    }
+    
+    // Log initialization
+    log("Logger initialized - " + filename);
+}
+
+Logger::~Logger() {
+    if (file_.is_open()) {
+        log("Logger shutting down");
+        if (async_) async_->shutdown();
+        file_.close();
+    }
+}
+
+void Logger::log(const std::string& event) {
+    if (async_) {
+        async_->enqueueMessage(event);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    
+    std::ostringstream oss;
+    oss << timestampPrefix() << event << std::endl;
+    
+    file_ << oss.str();
+    file_.flush();
+}
+
+void Logger::logBatch(const std::vector<std::string>& events) {
+    if (events.empty()) return;
+    if (async_) {
+        for (const auto& event : events) async_->enqueueMessage(event);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    
+    std::string prefix = timestampPrefix();
+    std::string out;
+    for (const auto& event : events) {
+        out += prefix;
+        out += event;
+        out += '\n';
+    }
+    
+    file_ << out;
+    file_.flush();
+}
+
+std::string Logger::timestampPrefix() const {
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now.time_since_epoch()) % 1000;
+    
+    std::ostringstream oss;
+    oss << "[" << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    oss << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
+    return oss.str();
+}
+
+void Logger::logTrade(const std::string& tradeInfo) {
+    log("TRADE: " + tradeInfo);
+}
+
+void Logger::logTrade(uint64_t buyId, uint64_t sellId, double price, uint32_t qty) {
+    if (async_) {
+        LogRecord record = makeTradeRecord(buyId, sellId, price, qty);
+        async_->enqueue(record);
+        return;
+    }
+    log(formatTrade(buyId, sellId, price, qty));
+}
+
+void Logger::logOrderBatch(uint64_t count, uint64_t firstId, uint64_t lastId) {
+    if (async_) {
+        LogRecord record = makeOrderBatchRecord(count, firstId, lastId);
+        async_->enqueue(record);
+        return;
+    }
+    log(formatOrderBatch(count, firstId, lastId));
+}
+
+LogMode Logger::getMode() const {
+    return mode_;
+}
+
+uint64_t Logger::getDroppedRecords() const {
+    return async_ ? async_->getDroppedRecords() : 0;
+}
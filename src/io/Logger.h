@@ -1,16 +1,35 @@
-#pragma once
-#include <string>
-#include <fstream>
-#include <mutex>
-#include <chrono>
-
-class Logger {
-public:
-    Logger(const std::string& filename);
-    ~Logger();
-    void log(const std::string& event);
-    void logTrade(const std::string& tradeInfo);
-private:
-    std::ofstream file_;
-    std::mutex mtx_;
-};
+#pragma once
+#include "AsyncLogWriter.h"
+#include <string>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <vector>
+
+class Logger {
+public:
+    Logger(const std::string& filename, LogMode mode = LogMode::SYNC,
+           AsyncLogConfig asyncConfig = AsyncLogConfig());
+    ~Logger();
+    void log(const std::string& event);
+    void logTrade(const std::string& tradeInfo);
+    // Writes all events with one timestamp, one lock and one flush
+    void logBatch(const std::vector<std::string>& events);
+
+    // Structured events for hot paths. In the async modes these enqueue a
+    // fixed-size record without formatting; in SYNC mode they write the same
+    // text line that the async formatter would produce.
+    void logTrade(uint64_t buyId, uint64_t sellId, double price, uint32_t qty);
+    void logOrderBatch(uint64_t count, uint64_t firstId, uint64_t lastId);
+
+    LogMode getMode() const;
+    // Records dropped because a producer's buffer was full (async modes only)
+    uint64_t getDroppedRecords() const;
+private:
+    std::string timestampPrefix() const;
+    std::ofstream file_;
+    std::mutex mtx_;
+    LogMode mode_;
+    std::unique_ptr<AsyncLogWriter> async_;
+};
@@ -0,0 +1,104 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OBME_HAVE_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+    open(path);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        fallback_ = std::move(other.fallback_);
+        data_ = other.mapped_ ? other.data_ : fallback_.data();
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        open_ = other.open_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+        other.open_ = false;
+    }
+    return *this;
+}
+
+void MappedFile::open(const std::string& path) {
+    close();
+#ifdef OBME_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    // Zero-length mappings are invalid; an empty file is just an empty view
+    if (size_ > 0) {
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            throw std::runtime_error("Failed to map file: " + path);
+        }
+        madvise(addr, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(addr);
+        mapped_ = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    fallback_ = oss.str();
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+    open_ = true;
+}
+
+void MappedFile::close() {
+#ifdef OBME_HAVE_MMAP
+    if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+    fallback_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    open_ = false;
+}
+
+bool MappedFile::isOpen() const {
+    return open_;
+}
+
+std::string_view MappedFile::view() const {
+    return std::string_view(data_, size_);
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
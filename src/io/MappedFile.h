@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only view of a whole file. On POSIX systems the file is mmapped so
+// callers can slice it without copying; elsewhere it falls back to reading
+// the file into memory once.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    void open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    std::string_view view() const;
+    size_t size() const;
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    bool open_ = false;
+    std::string fallback_;
+};
@@ -1,266 +1,446 @@
-#include "OrderParser.h"
-#include <sstream>
-#include <iostream>
-#include <stdexcept>
-#include <algorithm>
-
-OrderParser::OrderParser() {}
-
-Order OrderParser::parse(const std::string& input) {
-    if (input.empty()) {
-        throw std::invalid_argument("Empty input string");
-    }
-    
-    // Try to parse as JSON first
-    if (input.front() == '{' && input.back() == '}') {
-        return parseJson(input);
-    }
-    
-    // Try to parse as CSV
-    if (input.find(',') != std::string::npos) {
-        return parseCsv(input);
-    }
-    
-    // Try to parse as pipe-delimited
-    if (input.find('|') != std::string::npos) {
-        return parsePipeDelimited(input);
-    }
-    
-    throw std::invalid_argument("Unrecognized input format");
-}
-
-Order OrderParser::parseJson(const std::string& json) {
-    Order order;
-    
-    try {
-        // Simple JSON parsing (not using external library)
-        // This is a basic implementation - in production, use a proper JSON library
-        
-        order.orderId = extractJsonValue<uint64_t>(json, "orderId");
-        order.clientId = extractJsonValue<uint64_t>(json, "clientId", 0);
-        order.symbol = extractJsonString(json, "symbol");
-        
-        std::string typeStr = extractJsonString(json, "type");
-        order.type = stringToOrderType(typeStr);
-        
-        std::string sideStr = extractJsonString(json, "side");
-        order.side = stringToOrderSide(sideStr);
-        
-        order.price = extractJsonValue<double>(json, "price", 0.0);
-        order.quantity = extractJsonValue<uint32_t>(json, "quantity");
-        order.remainingQty = extractJsonValue<uint32_t>(json, "remainingQty", order.quantity);
-        order.stopPrice = extractJsonValue<double>(json, "stopPrice", 0.0);
-        
-        // Set timestamps
-        order.timestamp = std::chrono::system_clock::now();
-        order.lastModified = order.timestamp;
-        
-    } catch (const std::exception& e) {
-        throw std::invalid_argument("JSON parsing error: " + std::string(e.what()));
-    }
-    
-    if (!order.isValid()) {
-        throw std::invalid_argument("Parsed order is invalid");
-    }
-    
-    return order;
-}
-
-Order OrderParser::parseCsv(const std::string& csv) {
-    std::vector<std::string> tokens = split(csv, ',');
-    
-    if (tokens.size() < 6) {
-        throw std::invalid_argument("CSV format requires at least 6 fields: orderId,symbol,type,side,price,quantity");
-    }
-    
-    Order order;
-    
-    try {
-        order.orderId = std::stoull(trim(tokens[0]));
-        order.symbol = trim(tokens[1]);
-        order.type = stringToOrderType(trim(tokens[2]));
-        order.side = stringToOrderSide(trim(tokens[3]));
-        order.price = std::stod(trim(tokens[4]));
-        order.quantity = std::stoul(trim(tokens[5]));
-        
-        // Optional fields
-        if (tokens.size() > 6) order.clientId = std::stoull(trim(tokens[6]));
-        if (tokens.size() > 7) order.remainingQty = std::stoul(trim(tokens[7]));
-        else order.remainingQty = order.quantity;
-        if (tokens.size() > 8) order.stopPrice = std::stod(trim(tokens[8]));
-        
-        order.timestamp = std::chrono::system_clock::now();
-        order.lastModified = order.timestamp;
-        
-    } catch (const std::exception& e) {
-        throw std::invalid_argument("CSV parsing error: " + std::string(e.what()));
-    }
-    
-    if (!order.isValid()) {
-        throw std::invalid_argument("Parsed order is invalid");
-    }
-    
-    return order;
-}
-
-Order OrderParser::parsePipeDelimited(const std::string& input) {
-    std::vector<std::string> tokens = split(input, '|');
-    
-    if (tokens.size() < 6) {
-        throw std::invalid_argument("Pipe-delimited format requires at least 6 fields");
-    }
-    
-    Order order;
-    
-    try {
-        order.orderId = std::stoull(trim(tokens[0]));
-        order.symbol = trim(tokens[1]);
-        order.type = stringToOrderType(trim(tokens[2]));
-        order.side = stringToOrderSide(trim(tokens[3]));
-        order.price = std::stod(trim(tokens[4]));
-        order.quantity = std::stoul(trim(tokens[5]));
-        order.remainingQty = order.quantity;
-        
-        order.timestamp = std::chrono::system_clock::now();
-        order.lastModified = order.timestamp;
-        
-    } catch (const std::exception& e) {
-        throw std::invalid_argument("Pipe-delimited parsing error: " + std::string(e.what()));
-    }
-    
-    if (!order.isValid()) {
-        throw std::invalid_argument("Parsed order is invalid");
-    }
-    
-    return order;
-}
-
-OrderType OrderParser::stringToOrderType(const std::string& str) {
-    std::string upper = toUpper(str);
-    
-    if (upper == "MARKET") return OrderType::MARKET;
-    if (upper == "LIMIT") return OrderType::LIMIT;
-    if (upper == "STOP") return OrderType::STOP;
-    if (upper == "STOP_LIMIT") return OrderType::STOP_LIMIT;
-    if (upper == "CANCEL") return OrderType::CANCEL;
-    if (upper == "MODIFY") return OrderType::MODIFY;
-    
-    throw std::invalid_argument("Unknown order type: " + str);
-}
-
-OrderSide OrderParser::stringToOrderSide(const std::string& str) {
-    std::string upper = toUpper(str);
-    
-    if (upper == "BUY") return OrderSide::BUY;
-    if (upper == "SELL") return OrderSide::SELL;
-    
-    throw std::invalid_argument("Unknown order side: " + str);
-}
-
-std::vector<std::string> OrderParser::split(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(token);
-    }
-    
-    return tokens;
-}
-
-std::string OrderParser::trim(const std::string& str) {
-    size_t start = str.find_first_not_of(" \t\n\r");
-    if (start == std::string::npos) return "";
-    
-    size_t end = str.find_last_not_of(" \t\n\r");
-    return str.substr(start, end - start + 1);
-}
-
-std::string OrderParser::toUpper(const std::string& str) {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
-    return result;
-}
-
-std::string OrderParser::extractJsonString(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    
-    if (keyPos == std::string::npos) {
-        throw std::invalid_argument("Key not found: " + key);
-    }
-    
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) {
-        throw std::invalid_argument("Invalid JSON format for key: " + key);
-    }
-    
-    size_t valueStart = json.find('"', colonPos);
-    if (valueStart == std::string::npos) {
-        throw std::invalid_argument("String value not found for key: " + key);
-    }
-    
-    size_t valueEnd = json.find('"', valueStart + 1);
-    if (valueEnd == std::string::npos) {
-        throw std::invalid_argument("Unterminated string value for key: " + key);
-    }
-    
-    return json.substr(valueStart + 1, valueEnd - valueStart - 1);
-}
-
-template<typename T>
-T OrderParser::extractJsonValue(const std::string& json, const std::string& key, T defaultValue) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    
-    if (keyPos == std::string::npos) {
-        return defaultValue;
-    }
-    
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) {
-        return defaultValue;
-    }
-    
-    size_t valueStart = colonPos + 1;
-    while (valueStart < json.length() && std::isspace(json[valueStart])) {
-        valueStart++;
-    }
-    
-    size_t valueEnd = valueStart;
-    while (valueEnd < json.length() && 
-           json[valueEnd] != ',' && 
-           json[valueEnd] != '}' && 
-           !std::isspace(json[valueEnd])) {
-        valueEnd++;
-    }
-    
-    if (valueStart >= valueEnd) {
-        return defaultValue;
-    }
-    
-    std::string valueStr = json.substr(valueStart, valueEnd - valueStart);
-    
-    try {
-        if constexpr (std::is_same_v<T, uint64_t>) {
-            return std::stoull(valueStr);
-        } else if constexpr (std::is_same_v<T, uint32_t>) {
-            return std::stoul(valueStr);
-        } else if constexpr (std::is_same_v<T, double>) {
-            return std::stod(valueStr);
-        } else if constexpr (std::is_same_v<T, int>) {
-            return std::stoi(valueStr);
-        }
-    } catch (const std::exception&) {
-        return defaultValue;
-    }
-    
-    return defaultValue;
-}
-
-// Explicit template instantiations
-template uint64_t OrderParser::extractJsonValue<uint64_t>(const std::string&, const std::string&, uint64_t);
-template uint32_t OrderParser::extractJsonValue<uint32_t>(const std::string&, const std::string&, uint32_t);
-template double OrderParser::extractJsonValue<double>(const std::string&, const std::string&, double);
-template int OrderParser::extractJsonValue<int>(const std::string&, const std::string&, int);
+#include "OrderParser.h"
+#include "ParseUtils.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+using namespace ParseUtils;
+
+void resetOrder(Order& out) {
+    out.orderId = 0;
+    out.clientId = 0;
+    out.symbol.clear();
+    out.type = OrderType::LIMIT;
+    out.side = OrderSide::BUY;
+    out.price = 0.0;
+    out.quantity = 0;
+    out.remainingQty = 0;
+    out.stopPrice = 0.0;
+    out.timeInForce = TimeInForce::GTC;
+    out.displayQty = 0;
+}
+
+ParseError finishOrder(Order& out) {
+    out.timestamp = std::chrono::system_clock::now();
+    out.lastModified = out.timestamp;
+    return out.isValid() ? ParseError::OK : ParseError::INVALID_ORDER;
+}
+
+}
+
+const char* parseErrorToString(ParseError error) {
+    switch (error) {
+        case ParseError::OK: return "OK";
+        case ParseError::EMPTY_INPUT: return "EMPTY_INPUT";
+        case ParseError::UNKNOWN_FORMAT: return "UNKNOWN_FORMAT";
+        case ParseError::MALFORMED: return "MALFORMED";
+        case ParseError::MISSING_FIELD: return "MISSING_FIELD";
+        case ParseError::BAD_NUMBER: return "BAD_NUMBER";
+        case ParseError::BAD_TYPE: return "BAD_TYPE";
+        case ParseError::BAD_SIDE: return "BAD_SIDE";
+        case ParseError::INVALID_ORDER: return "INVALID_ORDER";
+        case ParseError::OFF_TICK: return "OFF_TICK";
+        default: return "UNKNOWN";
+    }
+}
+
+OrderParser::OrderParser() {}
+
+Order OrderParser::parse(const std::string& input) {
+    if (input.empty()) {
+        throw std::invalid_argument("Empty input string");
+    }
+    
+    // Try to parse as JSON first
+    if (input.front() == '{' && input.back() == '}') {
+        return parseJson(input);
+    }
+    
+    // Try to parse as CSV
+    if (input.find(',') != std::string::npos) {
+        return parseCsv(input);
+    }
+    
+    // Try to parse as pipe-delimited
+    if (input.find('|') != std::string::npos) {
+        return parsePipeDelimited(input);
+    }
+    
+    throw std::invalid_argument("Unrecognized input format");
+}
+
+Order OrderParser::parseJson(const std::string& json) {
+    Order order;
+    
+    try {
+        // Simple JSON parsing (not using external library)
+        // This is a basic implementation - in production, use a proper JSON library
+        
+        order.orderId = extractJsonValue<uint64_t>(json, "orderId");
+        order.clientId = extractJsonValue<uint64_t>(json, "clientId", 0);
+        order.symbol = extractJsonString(json, "symbol");
+        
+        std::string typeStr = extractJsonString(json, "type");
+        order.type = stringToOrderType(typeStr);
+        
+        std::string sideStr = extractJsonString(json, "side");
+        order.side = stringToOrderSide(sideStr);
+        
+        order.price = extractJsonValue<double>(json, "price", 0.0);
+        order.quantity = extractJsonValue<uint32_t>(json, "quantity");
+        order.remainingQty = extractJsonValue<uint32_t>(json, "remainingQty", order.quantity);
+        order.stopPrice = extractJsonValue<double>(json, "stopPrice", 0.0);
+        order.displayQty = extractJsonValue<uint32_t>(json, "displayQty", 0);
+        
+        if (json.find("\"timeInForce\"") != std::string::npos) {
+            order.timeInForce = stringToTimeInForce(extractJsonString(json, "timeInForce"));
+        }
+        
+        // Set timestamps
+        order.timestamp = std::chrono::system_clock::now();
+        order.lastModified = order.timestamp;
+        
+    } catch (const std::exception& e) {
+        throw std::invalid_argument("JSON parsing error: " + std::string(e.what()));
+    }
+    
+    if (!order.isValid()) {
+        throw std::invalid_argument("Parsed order is invalid");
+    }
+    
+    return order;
+}
+
+Order OrderParser::parseCsv(const std::string& csv) {
+    std::vector<std::string> tokens = split(csv, ',');
+    
+    if (tokens.size() < 6) {
+        throw std::invalid_argument("CSV format requires at least 6 fields: orderId,symbol,type,side,price,quantity");
+    }
+    
+    Order order;
+    
+    try {
+        order.orderId = std::stoull(trim(tokens[0]));
+        order.symbol = trim(tokens[1]);
+        order.type = stringToOrderType(trim(tokens[2]));
+        order.side = stringToOrderSide(trim(tokens[3]));
+        order.price = std::stod(trim(tokens[4]));
+        order.quantity = std::stoul(trim(tokens[5]));
+        
+        // Optional fields
+        if (tokens.size() > 6) order.clientId = std::stoull(trim(tokens[6]));
+        if (tokens.size() > 7) order.remainingQty = std::stoul(trim(tokens[7]));
+        else order.remainingQty = order.quantity;
+        if (tokens.size() > 8) order.stopPrice = std::stod(trim(tokens[8]));
+        
+        order.timestamp = std::chrono::system_clock::now();
+        order.lastModified = order.timestamp;
+        
+    } catch (const std::exception& e) {
+        throw std::invalid_argument("CSV parsing error: " + std::string(e.what()));
+    }
+    
+    if (!order.isValid()) {
+        throw std::invalid_argument("Parsed order is invalid");
+    }
+    
+    return order;
+}
+
+Order OrderParser::parsePipeDelimited(const std::string& input) {
+    std::vector<std::string> tokens = split(input, '|');
+    
+    if (tokens.size() < 6) {
+        throw std::invalid_argument("Pipe-delimited format requires at least 6 fields");
+    }
+    
+    Order order;
+    
+    try {
+        order.orderId = std::stoull(trim(tokens[0]));
+        order.symbol = trim(tokens[1]);
+        order.type = stringToOrderType(trim(tokens[2]));
+        order.side = stringToOrderSide(trim(tokens[3]));
+        order.price = std::stod(trim(tokens[4]));
+        order.quantity = std::stoul(trim(tokens[5]));
+        order.remainingQty = order.quantity;
+        
+        order.timestamp = std::chrono::system_clock::now();
+        order.lastModified = order.timestamp;
+        
+    } catch (const std::exception& e) {
+        throw std::invalid_argument("Pipe-delimited parsing error: " + std::string(e.what()));
+    }
+    
+    if (!order.isValid()) {
+        throw std::invalid_argument("Parsed order is invalid");
+    }
+    
+    return order;
+}
+
+ParseError OrderParser::parse(std::string_view input, Order& out) {
+    std::string_view trimmed = trimView(input);
+    if (trimmed.empty()) return ParseError::EMPTY_INPUT;
+    
+    if (trimmed.front() == '{' && trimmed.back() == '}') return parseJson(trimmed, out);
+    if (trimmed.find(',') != std::string_view::npos) return parseCsv(trimmed, out);
+    if (trimmed.find('|') != std::string_view::npos) return parsePipeDelimited(trimmed, out);
+    return ParseError::UNKNOWN_FORMAT;
+}
+
+// Walks the object's key/value pairs once and dispatches on the key. Nested
+// objects and escapes inside strings are not interpreted; order messages
+// never need them.
+ParseError OrderParser::parseJson(std::string_view json, Order& out) {
+    resetOrder(out);
+    bool hasSymbol = false, hasType = false, hasSide = false, hasRemaining = false;
+    
+    size_t pos = 0;
+    size_t size = json.size();
+    auto skipSpace = [&] { while (pos < size && isSpace(json[pos])) pos++; };
+    
+    skipSpace();
+    if (pos == size || json[pos] != '{') return ParseError::MALFORMED;
+    pos++;
+    
+    while (true) {
+        skipSpace();
+        if (pos < size && json[pos] == '}') break;
+        if (pos == size || json[pos] != '"') return ParseError::MALFORMED;
+        size_t keyEnd = json.find('"', pos + 1);
+        if (keyEnd == std::string_view::npos) return ParseError::MALFORMED;
+        std::string_view key = json.substr(pos + 1, keyEnd - pos - 1);
+        pos = keyEnd + 1;
+        
+        skipSpace();
+        if (pos == size || json[pos] != ':') return ParseError::MALFORMED;
+        pos++;
+        skipSpace();
+        if (pos == size) return ParseError::MALFORMED;
+        
+        std::string_view value;
+        bool isString = json[pos] == '"';
+        if (isString) {
+            size_t end = pos + 1;
+            while (end < size && json[end] != '"') end += json[end] == '\\' ? 2 : 1;
+            if (end >= size) return ParseError::MALFORMED;
+            value = json.substr(pos + 1, end - pos - 1);
+            pos = end + 1;
+        } else {
+            size_t end = pos;
+            while (end < size && json[end] != ',' && json[end] != '}' && !isSpace(json[end])) end++;
+            value = json.substr(pos, end - pos);
+            pos = end;
+        }
+        
+        bool ok = true;
+        if (key == "orderId") ok = parseNumber(value, out.orderId);
+        else if (key == "clientId") ok = parseNumber(value, out.clientId);
+        else if (key == "symbol") { out.symbol.assign(value.data(), value.size()); hasSymbol = true; }
+        else if (key == "type") { if (!parseOrderType(value, out.type)) return ParseError::BAD_TYPE; hasType = true; }
+        else if (key == "side") { if (!parseOrderSide(value, out.side)) return ParseError::BAD_SIDE; hasSide = true; }
+        else if (key == "price") ok = parsePrice(value, out.price);
+        else if (key == "quantity") ok = parseNumber(value, out.quantity);
+        else if (key == "remainingQty") { ok = parseNumber(value, out.remainingQty); hasRemaining = true; }
+        else if (key == "stopPrice") ok = parsePrice(value, out.stopPrice);
+        else if (key == "displayQty") ok = parseNumber(value, out.displayQty);
+        else if (key == "timeInForce") { if (!parseTimeInForce(value, out.timeInForce)) return ParseError::BAD_TYPE; }
+        if (!ok) return ParseError::BAD_NUMBER;
+        
+        skipSpace();
+        if (pos < size && json[pos] == ',') {
+            pos++;
+            continue;
+        }
+        if (pos < size && json[pos] == '}') break;
+        return ParseError::MALFORMED;
+    }
+    
+    if (!hasSymbol || !hasType || !hasSide) return ParseError::MISSING_FIELD;
+    if (!hasRemaining) out.remainingQty = out.quantity;
+    return finishOrder(out);
+}
+
+ParseError OrderParser::parseCsv(std::string_view csv, Order& out) {
+    return parseDelimited(csv, ',', 9, out);
+}
+
+ParseError OrderParser::parsePipeDelimited(std::string_view input, Order& out) {
+    return parseDelimited(input, '|', 6, out);
+}
+
+// Field order: orderId, symbol, type, side, price, quantity, then optionally
+// clientId, remainingQty, stopPrice. Fields past maxFields are ignored.
+ParseError OrderParser::parseDelimited(std::string_view input, char delimiter, size_t maxFields, Order& out) {
+    std::string_view fields[9];
+    size_t count = 0;
+    size_t pos = 0;
+    while (count < maxFields && pos <= input.size()) {
+        size_t end = input.find(delimiter, pos);
+        if (end == std::string_view::npos) end = input.size();
+        fields[count++] = trimView(input.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    if (count < 6) return ParseError::MISSING_FIELD;
+    
+    resetOrder(out);
+    if (!parseNumber(fields[0], out.orderId)) return ParseError::BAD_NUMBER;
+    out.symbol.assign(fields[1].data(), fields[1].size());
+    if (!parseOrderType(fields[2], out.type)) return ParseError::BAD_TYPE;
+    if (!parseOrderSide(fields[3], out.side)) return ParseError::BAD_SIDE;
+    if (!parsePrice(fields[4], out.price)) return ParseError::BAD_NUMBER;
+    if (!parseNumber(fields[5], out.quantity)) return ParseError::BAD_NUMBER;
+    if (count > 6 && !parseNumber(fields[6], out.clientId)) return ParseError::BAD_NUMBER;
+    if (count > 7) {
+        if (!parseNumber(fields[7], out.remainingQty)) return ParseError::BAD_NUMBER;
+    } else {
+        out.remainingQty = out.quantity;
+    }
+    if (count > 8 && !parsePrice(fields[8], out.stopPrice)) return ParseError::BAD_NUMBER;
+    return finishOrder(out);
+}
+
+OrderType OrderParser::stringToOrderType(const std::string& str) {
+    std::string upper = toUpper(str);
+    
+    if (upper == "MARKET") return OrderType::MARKET;
+    if (upper == "LIMIT") return OrderType::LIMIT;
+    if (upper == "STOP") return OrderType::STOP;
+    if (upper == "STOP_LIMIT") return OrderType::STOP_LIMIT;
+    if (upper == "CANCEL") return OrderType::CANCEL;
+    if (upper == "MODIFY") return OrderType::MODIFY;
+    
+    throw std::invalid_argument("Unknown order type: " + str);
+}
+
+TimeInForce OrderParser::stringToTimeInForce(const std::string& str) {
+    std::string upper = toUpper(str);
+    
+    if (upper == "GTC") return TimeInForce::GTC;
+    if (upper == "IOC") return TimeInForce::IOC;
+    if (upper == "FOK") return TimeInForce::FOK;
+    
+    throw std::invalid_argument("Unknown time in force: " + str);
+}
+
+OrderSide OrderParser::stringToOrderSide(const std::string& str) {
+    std::string upper = toUpper(str);
+    
+    if (upper == "BUY") return OrderSide::BUY;
+    if (upper == "SELL") return OrderSide::SELL;
+    
+    throw std::invalid_argument("Unknown order side: " + str);
+}
+
+std::vector<std::string> OrderParser::split(const std::string& str, char delimiter) {
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    
+    while (std::getline(ss, token, delimiter)) {
+        tokens.push_back(token);
+    }
+    
+    return tokens;
+}
+
+std::string OrderParser::trim(const std::string& str) {
+    size_t start = str.find_first_not_of(" \t\n\r");
+    if (start == std::string::npos) return "";
+    
+    size_t end = str.find_last_not_of(" \t\n\r");
+    return str.substr(start, end - start + 1);
+}
+
+std::string OrderParser::toUpper(const std::string& str) {
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+    return result;
+}
+
+std::string OrderParser::extractJsonString(const std::string& json, const std::string& key) {
+    std::string searchKey = "\"" + key + "\"";
+    size_t keyPos = json.find(searchKey);
+    
+    if (keyPos == std::string::npos) {
+        throw std::invalid_argument("Key not found: " + key);
+    }
+    
+    size_t colonPos = json.find(':', keyPos);
+    if (colonPos == std::string::npos) {
+        throw std::invalid_argument("Invalid JSON format for key: " + key);
+    }
+    
+    size_t valueStart = json.find('"', colonPos);
+    if (valueStart == std::string::npos) {
+        throw std::invalid_argument("String value not found for key: " + key);
+    }
+    
+    size_t valueEnd = json.find('"', valueStart + 1);
+    if (valueEnd == std::string::npos) {
+        throw std::invalid_argument("Unterminated string value for key: " + key);
+    }
+    
+    return json.substr(valueStart + 1, valueEnd - valueStart - 1);
+}
+
+template<typename T>
+T OrderParser::extractJsonValue(const std::string& json, const std::string& key, T defaultValue) {
+    std::string searchKey = "\"" + key + "\"";
+    size_t keyPos = json.find(searchKey);
+    
+    if (keyPos == std::string::npos) {
+        return defaultValue;
+    }
+    
+    size_t colonPos = json.find(':', keyPos);
+    if (colonPos == std::string::npos) {
+        return defaultValue;
+    }
+    
+    size_t valueStart = colonPos + 1;
+    while (valueStart < json.length() && std::isspace(json[valueStart])) {
+        valueStart++;
+    }
+    
+    size_t valueEnd = valueStart;
+    while (valueEnd < json.length() && 
+           json[valueEnd] != ',' && 
+           json[valueEnd] != '}' && 
+           !std::isspace(json[valueEnd])) {
+        valueEnd++;
+    }
+    
+    if (valueStart >= valueEnd) {
+        return defaultValue;
+    }
+    
+    std::string valueStr = json.substr(valueStart, valueEnd - valueStart);
+    
+    try {
+        if constexpr (std::is_same_v<T, uint64_t>) {
+            return std::stoull(valueStr);
+        } else if constexpr (std::is_same_v<T, uint32_t>) {
+            return std::stoul(valueStr);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return std::stod(valueStr);
+        } else if constexpr (std::is_same_v<T, int>) {
+            return std::stoi(valueStr);
+        }
+    } catch (const std::exception&) {
+        return defaultValue;
+    }
+    
+    return defaultValue;
+}
+
+// Explicit template instantiations
+template uint64_t OrderParser::extractJsonValue<uint64_t>(const std::string&, const std::string&, uint64_t);
+template uint32_t OrderParser::extractJsonValue<uint32_t>(const std::string&, const std::string&, uint32_t);
+template double OrderParser::extractJsonValue<double>(const std::string&, const std::string&, double);
+template int OrderParser::extractJsonValue<int>(const std::string&, const std::string&, int);
@@ -1,32 +1,61 @@
-#pragma once
-#include <string>
-#include <vector>
-#include "../engine/Order.h"
-
-class OrderParser {
-public:
-    OrderParser();
-    
-    // Main parsing function
-    Order parse(const std::string& input);
-    
-    // Format-specific parsers
-    Order parseJson(const std::string& json);
-    Order parseCsv(const std::string& csv);
-    Order parsePipeDelimited(const std::string& input);
-
-private:
-    // Utility functions
-    OrderType stringToOrderType(const std::string& str);
-    OrderSide stringToOrderSide(const std::string& str);
-    
-    std::vector<std::string> split(const std::string& str, char delimiter);
-    std::string trim(const std::string& str);
-    std::string toUpper(const std::string& str);
-    
-    // JSON parsing helpers
-    std::string extractJsonString(const std::string& json, const std::string& key);
-    
-    template<typename T>
-    T extractJsonValue(const std::string& json, const std::string& key, T defaultValue = T{});
-};
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../engine/Order.h"
+
+enum class ParseError : uint8_t {
+    OK,
+    EMPTY_INPUT,
+    UNKNOWN_FORMAT,
+    MALFORMED,          // Structural problem, e.g. unterminated JSON string
+    MISSING_FIELD,
+    BAD_NUMBER,
+    BAD_TYPE,
+    BAD_SIDE,
+    INVALID_ORDER,      // Parsed cleanly but fails Order::isValid()
+    OFF_TICK            // Price off the symbol's tick grid (BulkDecoder only)
+};
+
+const char* parseErrorToString(ParseError error);
+
+class OrderParser {
+public:
+    OrderParser();
+    
+    // Main parsing function
+    Order parse(const std::string& input);
+    
+    // Format-specific parsers
+    Order parseJson(const std::string& json);
+    Order parseCsv(const std::string& csv);
+    Order parsePipeDelimited(const std::string& input);
+    
+    // Fast path: single pass over the input, numbers via std::from_chars, no
+    // exceptions. Every field of out is overwritten on success; on error out
+    // is left partially written. Reusing the same Order across calls keeps
+    // this free of heap allocations (the symbol reuses its storage).
+    ParseError parse(std::string_view input, Order& out);
+    ParseError parseJson(std::string_view json, Order& out);
+    ParseError parseCsv(std::string_view csv, Order& out);
+    ParseError parsePipeDelimited(std::string_view input, Order& out);
+
+private:
+    // Utility functions
+    OrderType stringToOrderType(const std::string& str);
+    OrderSide stringToOrderSide(const std::string& str);
+    TimeInForce stringToTimeInForce(const std::string& str);
+    
+    ParseError parseDelimited(std::string_view input, char delimiter, size_t maxFields, Order& out);
+    
+    std::vector<std::string> split(const std::string& str, char delimiter);
+    std::string trim(const std::string& str);
+    std::string toUpper(const std::string& str);
+    
+    // JSON parsing helpers
+    std::string extractJsonString(const std::string& json, const std::string& key);
+    
+    template<typename T>
+    T extractJsonValue(const std::string& json, const std::string& key, T defaultValue = T{});
+};
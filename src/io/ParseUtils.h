@@ -0,0 +1,97 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include "../models/OrderType.h"
+#include "../models/OrderSide.h"
+#include "../models/TimeInForce.h"
+
+// Allocation-free field helpers shared by OrderParser's fast path and the
+// bulk decoder
+namespace ParseUtils {
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline std::string_view trimView(std::string_view str) {
+    size_t start = 0;
+    size_t end = str.size();
+    while (start < end && isSpace(str[start])) start++;
+    while (end > start && isSpace(str[end - 1])) end--;
+    return str.substr(start, end - start);
+}
+
+// b must already be upper case
+inline bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char c = a[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c != b[i]) return false;
+    }
+    return true;
+}
+
+// The whole token must be consumed, so "12abc" is an error rather than 12
+template<typename T>
+bool parseNumber(std::string_view text, T& out) {
+    const char* last = text.data() + text.size();
+    auto result = std::from_chars(text.data(), last, out);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+// Plain decimals with up to 15 significant digits are exact as an integer
+// mantissa over a power of ten, so one division gives the correctly rounded
+// double, the same as from_chars. Anything else goes through from_chars.
+inline bool parsePrice(std::string_view text, double& out) {
+    static constexpr double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                       1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    uint64_t mantissa = 0;
+    size_t digits = 0;
+    size_t fraction = 0;
+    bool seenDot = false;
+    for (char c : text) {
+        if (c >= '0' && c <= '9') {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+            digits++;
+            if (seenDot) fraction++;
+        } else if (c == '.' && !seenDot) {
+            seenDot = true;
+        } else {
+            return parseNumber(text, out);
+        }
+    }
+    if (digits == 0 || digits > 15) return parseNumber(text, out);
+    out = static_cast<double>(mantissa) / POW10[fraction];
+    return true;
+}
+
+inline bool parseOrderType(std::string_view str, OrderType& out) {
+    if (equalsIgnoreCase(str, "MARKET")) out = OrderType::MARKET;
+    else if (equalsIgnoreCase(str, "LIMIT")) out = OrderType::LIMIT;
+    else if (equalsIgnoreCase(str, "STOP")) out = OrderType::STOP;
+    else if (equalsIgnoreCase(str, "STOP_LIMIT")) out = OrderType::STOP_LIMIT;
+    else if (equalsIgnoreCase(str, "CANCEL")) out = OrderType::CANCEL;
+    else if (equalsIgnoreCase(str, "MODIFY")) out = OrderType::MODIFY;
+    else return false;
+    return true;
+}
+
+inline bool parseTimeInForce(std::string_view str, TimeInForce& out) {
+    if (equalsIgnoreCase(str, "GTC")) out = TimeInForce::GTC;
+    else if (equalsIgnoreCase(str, "IOC")) out = TimeInForce::IOC;
+    else if (equalsIgnoreCase(str, "FOK")) out = TimeInForce::FOK;
+    else return false;
+    return true;
+}
+
+inline bool parseOrderSide(std::string_view str, OrderSide& out) {
+    if (equalsIgnoreCase(str, "BUY")) out = OrderSide::BUY;
+    else if (equalsIgnoreCase(str, "SELL")) out = OrderSide::SELL;
+    else return false;
+    return true;
+}
+
+}
@@ -0,0 +1,382 @@
+#include "Snapshot.h"
+#include "../engine/SymbolTable.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define OBME_HAVE_FORK 1
+#endif
+
+namespace {
+
+constexpr size_t WRITE_CHUNK = 4096;    // Records per write
+
+// Streams records into path + ".tmp" and publishes the file with one rename
+class SnapshotFile {
+public:
+    explicit SnapshotFile(const std::string& path) : path_(path), tmpPath_(path + ".tmp") {
+        out_.open(tmpPath_, std::ios::binary | std::ios::trunc);
+        if (!out_) throw std::runtime_error("Failed to open snapshot: " + tmpPath_);
+        SnapshotFileHeader header{};
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        chunk_.reserve(WRITE_CHUNK);
+    }
+
+    ~SnapshotFile() {
+        if (!published_) {
+            out_.close();
+            std::remove(tmpPath_.c_str());
+        }
+    }
+
+    // Snapshot-local id for a symbol name, binding it on first use. Names are
+    // matched here rather than through SymbolTable, whose lock a forked child
+    // could find held by a thread that no longer exists.
+    uint32_t bind(const std::string& name, double tickSize) {
+        if (name.empty()) return 0;
+        auto it = symbols_.find(name);
+        if (it != symbols_.end()) return it->second;
+        if (name.size() >= JOURNAL_SYMBOL_SIZE) {
+            throw std::runtime_error("Symbol too long for a snapshot: " + name);
+        }
+        uint32_t symbolId = static_cast<uint32_t>(symbols_.size() + 1);
+        symbols_.emplace(name, symbolId);
+        JournalSymbol symbol{};
+        symbol.symbolId = symbolId;
+        symbol.tickSize = tickSize;
+        std::memcpy(symbol.name, name.data(), name.size());
+        add(JournalRecordType::SYMBOL, &symbol);
+        return symbolId;
+    }
+
+    void addBook(uint32_t symbolId, double lastTradePrice) {
+        SnapshotBook book{};
+        book.symbolId = symbolId;
+        book.lastTradePrice = lastTradePrice;
+        add(JournalRecordType::BOOK, &book);
+    }
+
+    void addOrder(const Order& order) {
+        SnapshotOrder record{};
+        record.orderId = order.orderId;
+        record.clientId = order.clientId;
+        record.price = order.price;
+        record.stopPrice = order.stopPrice;
+        record.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            order.timestamp.time_since_epoch()).count();
+        record.quantity = order.quantity;
+        record.remainingQty = order.remainingQty;
+        record.displayQty = order.displayQty;
+        record.visibleQty = order.visibleQty;
+        // Tick size 0 leaves whatever the loading process has configured
+        record.symbolId = bind(order.symbol, 0.0);
+        record.type = order.type;
+        record.side = order.side;
+        record.timeInForce = order.timeInForce;
+        add(JournalRecordType::RESTING, &record);
+    }
+
+    void publish(uint64_t sequence) {
+        flush();
+        SnapshotFileHeader header{};
+        std::memcpy(header.magic, SNAPSHOT_FILE_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.recordSize = sizeof(JournalRecord);
+        header.sequence = sequence;
+        header.recordCount = recordCount_;
+        out_.seekp(0);
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out_.close();
+        if (!out_) throw std::runtime_error("Failed to write snapshot: " + tmpPath_);
+#ifdef OBME_HAVE_FORK
+        // Durable before it replaces the previous snapshot
+        int fd = ::open(tmpPath_.c_str(), O_RDONLY);
+        if (fd < 0 || ::fsync(fd) != 0) {
+            if (fd >= 0) ::close(fd);
+            throw std::runtime_error("Failed to sync snapshot: " + tmpPath_);
+        }
+        ::close(fd);
+#endif
+        if (std::rename(tmpPath_.c_str(), path_.c_str()) != 0) {
+            throw std::runtime_error("Failed to replace snapshot: " + path_);
+        }
+        published_ = true;
+    }
+
+private:
+    void add(JournalRecordType type, const void* payload) {
+        JournalRecord record;
+        record.type = type;
+        record.sequence = 0;
+        std::memcpy(record.payload, payload, sizeof(record.payload));
+        record.checksum = journalChecksum(record);
+        chunk_.push_back(record);
+        recordCount_++;
+        if (chunk_.size() == WRITE_CHUNK) flush();
+    }
+
+    void flush() {
+        out_.write(reinterpret_cast<const char*>(chunk_.data()),
+                   static_cast<std::streamsize>(chunk_.size() * sizeof(JournalRecord)));
+        if (!out_) throw std::runtime_error("Failed to write snapshot: " + tmpPath_);
+        chunk_.clear();
+    }
+
+    std::string path_;
+    std::string tmpPath_;
+    std::ofstream out_;
+    std::vector<JournalRecord> chunk_;
+    std::unordered_map<std::string, uint32_t> symbols_;
+    uint64_t recordCount_ = 0;
+    bool published_ = false;
+};
+
+void writeBook(SnapshotFile& file, uint32_t symbolId, const OrderBook& book) {
+    file.addBook(symbolId, book.getLastTradePrice());
+    book.forEachResting([&file](const Order& order) { file.addOrder(order); });
+}
+
+// A registry's books with their symbol ids, lowest id first. Collected under
+// the registry's lock before forking, so the child never takes it: a lock
+// held by another thread at fork time would never be released in the child.
+using BookList = std::vector<std::pair<uint32_t, const OrderBook*>>;
+
+BookList listBooks(const BookRegistry& books) {
+    BookList list;
+    books.forEachBook([&list](uint32_t symbolId, const OrderBook& book) { list.emplace_back(symbolId, &book); });
+    return list;
+}
+
+void writeSnapshot(const std::string& path, const OrderBook& book, uint64_t sequence) {
+    SnapshotFile file(path);
+    writeBook(file, 0, book);
+    file.publish(sequence);
+}
+
+void writeSnapshot(const std::string& path, const BookList& books, uint64_t sequence) {
+    SnapshotFile file(path);
+    // name() and getTickSize() are lock-free
+    const SymbolTable& symbols = SymbolTable::instance();
+    for (const auto& entry : books) {
+        writeBook(file, file.bind(symbols.name(entry.first), symbols.getTickSize(entry.first)), *entry.second);
+    }
+    file.publish(sequence);
+}
+
+bool fileHasData(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in && in.tellg() > 0;
+}
+
+template<typename Books>
+uint64_t recoverWith(Books& books, const std::string& snapshotPath, const std::string& journalPath) {
+    uint64_t sequence = 0;
+    if (fileHasData(snapshotPath)) {
+        SnapshotReader snapshot(snapshotPath);
+        snapshot.load(books);
+        sequence = snapshot.getSequence();
+    }
+    for (const auto& path : JournalWriter::listFiles(journalPath)) {
+        // The active file is missing or empty after a crash inside rotate()
+        if (!fileHasData(path)) continue;
+        JournalReader journal(path);
+        // Segments the snapshot already covers end before it
+        if (!journal.skipThrough(sequence)) continue;
+        journal.replay(books);
+        sequence = journal.getLastSequence();
+    }
+    return sequence;
+}
+
+}
+
+void SnapshotWriter::write(const std::string& path, const OrderBook& book, uint64_t sequence) {
+    writeSnapshot(path, book, sequence);
+}
+
+void SnapshotWriter::write(const std::string& path, const BookRegistry& books, uint64_t sequence) {
+    writeSnapshot(path, listBooks(books), sequence);
+}
+
+BackgroundSnapshot::~BackgroundSnapshot() {
+    try {
+        wait();
+    } catch (const std::exception&) {
+        // Nothing left to report a failed snapshot to
+    }
+}
+
+bool BackgroundSnapshot::start(const std::string& path, const OrderBook& book, uint64_t sequence) {
+    return startWith(path, book, sequence);
+}
+
+bool BackgroundSnapshot::start(const std::string& path, const BookRegistry& books, uint64_t sequence) {
+    if (running()) return false;
+    return startWith(path, listBooks(books), sequence);
+}
+
+template<typename Books>
+bool BackgroundSnapshot::startWith(const std::string& path, const Books& books, uint64_t sequence) {
+    if (running()) return false;
+    path_ = path;
+    sequence_ = sequence;
+#ifdef OBME_HAVE_FORK
+    pid_t pid = ::fork();
+    if (pid < 0) throw std::runtime_error("Failed to fork snapshot writer: " + path);
+    if (pid == 0) {
+        // The child has only this thread and must never return into the
+        // engine; _exit skips destructors and atexit handlers meant for the parent
+        int status = 0;
+        try {
+            writeSnapshot(path, books, sequence);
+        } catch (...) {
+            status = 1;
+        }
+        ::_exit(status);
+    }
+    child_ = pid;
+#else
+    writeSnapshot(path, books, sequence);
+    finished_ = true;
+#endif
+    return true;
+}
+
+bool BackgroundSnapshot::poll() {
+    return reap(false);
+}
+
+bool BackgroundSnapshot::wait() {
+    return reap(true);
+}
+
+bool BackgroundSnapshot::running() const {
+    return child_ >= 0;
+}
+
+uint64_t BackgroundSnapshot::getSequence() const {
+    return sequence_;
+}
+
+bool BackgroundSnapshot::reap(bool block) {
+    if (finished_) {
+        finished_ = false;
+        return true;
+    }
+#ifdef OBME_HAVE_FORK
+    if (child_ < 0) return false;
+    int status = 0;
+    pid_t pid;
+    do {
+        pid = ::waitpid(static_cast<pid_t>(child_), &status, block ? 0 : WNOHANG);
+    } while (pid < 0 && errno == EINTR);
+    if (pid == 0) return false;
+    child_ = -1;
+    if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("Snapshot writer failed: " + path_);
+    }
+    return true;
+#else
+    (void)block;
+    return false;
+#endif
+}
+
+SnapshotReader::SnapshotReader(const std::string& path) : path_(path), file_(path) {
+    std::string_view data = file_.view();
+    if (data.size() < sizeof(header_)) throw std::runtime_error("Not a snapshot: " + path);
+    std::memcpy(&header_, data.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, SNAPSHOT_FILE_MAGIC, sizeof(header_.magic)) != 0 ||
+        header_.version != SNAPSHOT_VERSION || header_.recordSize != sizeof(JournalRecord)) {
+        throw std::runtime_error("Not a snapshot: " + path);
+    }
+    symbolMap_.push_back(0);
+}
+
+size_t SnapshotReader::load(OrderBook& book) {
+    return loadWith([&book](uint32_t) -> OrderBook& { return book; });
+}
+
+size_t SnapshotReader::load(BookRegistry& books) {
+    return loadWith([&books](uint32_t symbolId) -> OrderBook& { return books.getBook(symbolId); });
+}
+
+uint64_t SnapshotReader::getSequence() const {
+    return header_.sequence;
+}
+
+template<typename SelectBook>
+size_t SnapshotReader::loadWith(SelectBook selectBook) {
+    std::string_view data = file_.view();
+    if ((data.size() - sizeof(header_)) / sizeof(JournalRecord) < header_.recordCount) {
+        throw std::runtime_error("Snapshot is truncated: " + path_);
+    }
+    const SymbolTable& symbols = SymbolTable::instance();
+    OrderBook* book = nullptr;
+    Order order;
+    size_t restored = 0;
+    for (uint64_t i = 0; i < header_.recordCount; ++i) {
+        JournalRecord record;
+        std::memcpy(&record, data.data() + sizeof(header_) + i * sizeof(JournalRecord), sizeof(record));
+        if (record.checksum != journalChecksum(record)) {
+            throw std::runtime_error("Snapshot record is damaged: " + path_);
+        }
+        if (record.type == JournalRecordType::SYMBOL) {
+            JournalSymbol symbol;
+            std::memcpy(&symbol, record.payload, sizeof(symbol));
+            std::string name(symbol.name, strnlen(symbol.name, sizeof(symbol.name)));
+            uint32_t localId = SymbolTable::instance().intern(name);
+            if (symbol.tickSize > 0) SymbolTable::instance().setTickSize(localId, symbol.tickSize);
+            if (symbol.symbolId >= symbolMap_.size()) symbolMap_.resize(symbol.symbolId + 1, 0);
+            symbolMap_[symbol.symbolId] = localId;
+        } else if (record.type == JournalRecordType::BOOK) {
+            SnapshotBook header;
+            std::memcpy(&header, record.payload, sizeof(header));
+            uint32_t symbolId = header.symbolId < symbolMap_.size() ? symbolMap_[header.symbolId] : 0;
+            book = &selectBook(symbolId);
+            book->restoreLastTradePrice(header.lastTradePrice);
+        } else if (record.type == JournalRecordType::RESTING && book) {
+            SnapshotOrder resting;
+            std::memcpy(&resting, record.payload, sizeof(resting));
+            order.orderId = resting.orderId;
+            order.clientId = resting.clientId;
+            order.symbol = symbols.name(resting.symbolId < symbolMap_.size() ? symbolMap_[resting.symbolId] : 0);
+            order.type = resting.type;
+            order.side = resting.side;
+            order.price = resting.price;
+            order.stopPrice = resting.stopPrice;
+            order.quantity = resting.quantity;
+            order.remainingQty = resting.remainingQty;
+            order.displayQty = resting.displayQty;
+            order.visibleQty = resting.visibleQty;
+            order.timeInForce = resting.timeInForce;
+            order.timestamp = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(resting.timestampNs)));
+            order.lastModified = order.timestamp;
+            if (!book->restoreResting(order)) {
+                throw std::runtime_error("Snapshot order does not fit the book: " + path_);
+            }
+            restored++;
+        } else {
+            throw std::runtime_error("Unexpected snapshot record: " + path_);
+        }
+    }
+    return restored;
+}
+
+uint64_t recoverBooks(OrderBook& book, const std::string& snapshotPath, const std::string& journalPath) {
+    return recoverWith(book, snapshotPath, journalPath);
+}
+
+uint64_t recoverBooks(BookRegistry& books, const std::string& snapshotPath, const std::string& journalPath) {
+    return recoverWith(books, snapshotPath, journalPath);
+}
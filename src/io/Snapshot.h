@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Journal.h"
+#include "MappedFile.h"
+#include "../engine/BookRegistry.h"
+#include "../engine/OrderBook.h"
+
+// Point-in-time image of every resting order, so a restarted engine can load
+// its books and replay only the journal messages that came after.
+//
+// A snapshot file is a SnapshotFileHeader followed by records framed and
+// checksummed exactly like journal records. A BOOK record opens each book and
+// carries its last trade price, which decides whether its stops fire; the
+// RESTING records after it are that book's orders in OrderBook::forEachResting
+// order, so loading them back in sequence rebuilds every level's FIFO queue,
+// the pending stops and the id map. SYMBOL records bind names as in a
+// journal. The header's sequence is the last journal message the books had
+// applied, and recordCount lets the reader reject a short file.
+
+constexpr char SNAPSHOT_FILE_MAGIC[8] = {'O', 'B', 'M', 'E', 'S', 'N', 'A', 'P'};
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotFileHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t reserved;
+    uint64_t sequence;
+    uint64_t recordCount;
+};
+
+struct SnapshotBook {
+    uint32_t symbolId;          // Bound by a SYMBOL record; 0 for a lone OrderBook
+    uint32_t reserved;
+    double lastTradePrice;
+    unsigned char padding[48];
+};
+
+struct SnapshotOrder {
+    uint64_t orderId;
+    uint64_t clientId;
+    double price;
+    double stopPrice;
+    int64_t timestampNs;        // Since the system clock's epoch
+    uint32_t quantity;
+    uint32_t remainingQty;
+    uint32_t displayQty;
+    uint32_t visibleQty;        // Exact slice state, so icebergs keep their place
+    uint32_t symbolId;
+    OrderType type;
+    OrderSide side;
+    TimeInForce timeInForce;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(SnapshotFileHeader) == 32, "SnapshotFileHeader layout changed");
+static_assert(sizeof(SnapshotBook) == sizeof(JournalRecord::payload), "SnapshotBook must fill a record");
+static_assert(sizeof(SnapshotOrder) == sizeof(JournalRecord::payload), "SnapshotOrder must fill a record");
+
+class SnapshotWriter {
+public:
+    // Writes through path + ".tmp" and renames it over path, so a crash
+    // leaves either the previous snapshot or the new one. Reads the books
+    // without locking them (see OrderBook::forEachResting) and never takes
+    // the symbol table's lock. The registry overload does take the
+    // registry's lock to list its books, so it must not run in a forked
+    // child; BackgroundSnapshot lists them before it forks. Throws
+    // std::runtime_error on I/O errors.
+    static void write(const std::string& path, const OrderBook& book, uint64_t sequence);
+    static void write(const std::string& path, const BookRegistry& books, uint64_t sequence);
+};
+
+// Takes snapshots off the matching thread. start() forks: the child gets a
+// copy-on-write image of the books as they are at that instant, writes it
+// out and exits, while the parent carries on matching and only pays for the
+// pages it dirties in the meantime. The child takes no locks: a lock another
+// thread held at the fork would never be released in it. Where fork is
+// unavailable start() writes synchronously instead. Not thread-safe: drive
+// it from the thread that applies the books' orders.
+class BackgroundSnapshot {
+public:
+    BackgroundSnapshot() = default;
+    // Waits for a running child
+    ~BackgroundSnapshot();
+
+    BackgroundSnapshot(const BackgroundSnapshot&) = delete;
+    BackgroundSnapshot& operator=(const BackgroundSnapshot&) = delete;
+
+    // Returns false if the previous snapshot is still being written. Throws
+    // std::runtime_error if the writer cannot be started.
+    bool start(const std::string& path, const OrderBook& book, uint64_t sequence);
+    bool start(const std::string& path, const BookRegistry& books, uint64_t sequence);
+    // Non-blocking. Returns true once per snapshot, when it is complete on
+    // disk; throws std::runtime_error if the child failed to write it.
+    bool poll();
+    // Blocks until the running snapshot finishes; otherwise as poll
+    bool wait();
+
+    bool running() const;
+    // Journal sequence of the last snapshot started
+    uint64_t getSequence() const;
+
+private:
+    template<typename Books>
+    bool startWith(const std::string& path, const Books& books, uint64_t sequence);
+    bool reap(bool block);
+
+    std::string path_;
+    uint64_t sequence_ = 0;
+    long child_ = -1;           // pid of the writer while it runs
+    bool finished_ = false;     // Synchronous write not yet reported
+};
+
+// Loads a snapshot into empty books of the same kind it was taken from
+class SnapshotReader {
+public:
+    // Throws std::runtime_error if the file is missing or not a snapshot
+    explicit SnapshotReader(const std::string& path);
+
+    // Return how many orders were restored. Throw std::runtime_error if a
+    // record is damaged or missing.
+    size_t load(OrderBook& book);
+    size_t load(BookRegistry& books);
+
+    uint64_t getSequence() const;
+
+private:
+    template<typename SelectBook>
+    size_t loadWith(SelectBook selectBook);
+
+    std::string path_;
+    MappedFile file_;
+    SnapshotFileHeader header_;
+    std::vector<uint32_t> symbolMap_;   // Snapshot symbol id -> local id
+};
+
+// Startup: loads snapshotPath if it exists, then replays every journal
+// message after it from the closed segments and the active file. Returns the
+// last sequence applied. Throws std::runtime_error if the snapshot and
+// journal do not join up.
+uint64_t recoverBooks(OrderBook& book, const std::string& snapshotPath, const std::string& journalPath);
+uint64_t recoverBooks(BookRegistry& books, const std::string& snapshotPath, const std::string& journalPath);
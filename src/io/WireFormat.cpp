@@ -0,0 +1,265 @@
+#include "WireFormat.h"
+#include "../engine/Utils.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+uint64_t wallClockNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+template<typename T>
+T makeMessage(WireType type) {
+    T message;
+    std::memset(&message, 0, sizeof(message));
+    message.header.length = sizeof(T);
+    message.header.type = type;
+    return message;
+}
+
+void copySymbol(char* out, const std::string& symbol) {
+    if (symbol.size() > WIRE_SYMBOL_SIZE) {
+        throw std::invalid_argument("Symbol too long for wire format: " + symbol);
+    }
+    std::memcpy(out, symbol.data(), symbol.size());
+}
+
+std::string_view symbolView(const char* symbol) {
+    size_t length = 0;
+    while (length < WIRE_SYMBOL_SIZE && symbol[length] != '\0') length++;
+    return std::string_view(symbol, length);
+}
+
+size_t minimumLength(WireType type) {
+    switch (type) {
+        case WireType::NEW_ORDER: return sizeof(WireNewOrder);
+        case WireType::CANCEL: return sizeof(WireCancel);
+        case WireType::MODIFY: return sizeof(WireModify);
+        case WireType::TRADE: return sizeof(WireTrade);
+        default: return sizeof(WireHeader);
+    }
+}
+
+// A new order's enum bytes must name a value the engine can act on; CANCEL
+// and MODIFY have their own message types
+bool validNewOrder(const WireNewOrder& message) {
+    return message.orderType <= static_cast<uint8_t>(OrderType::STOP_LIMIT) &&
+           message.side <= static_cast<uint8_t>(OrderSide::SELL) &&
+           message.timeInForce <= static_cast<uint8_t>(TimeInForce::FOK);
+}
+
+bool onTick(int64_t wirePrice, double tickSize) {
+    return Utils::isOnTick(fromWirePrice(wirePrice), tickSize);
+}
+
+bool pricesOnTick(const WireNewOrder& message, double tickSize) {
+    return CompactOrder::pricesOnTick(static_cast<OrderType>(message.orderType),
+                                      fromWirePrice(message.price),
+                                      fromWirePrice(message.stopPrice), tickSize);
+}
+
+}
+
+int64_t toWirePrice(double price) {
+    return std::llround(price * WIRE_PRICE_SCALE);
+}
+
+double fromWirePrice(int64_t price) {
+    return static_cast<double>(price) / WIRE_PRICE_SCALE;
+}
+
+std::string_view WireMessage::symbol() const {
+    const char* name;
+    switch (type) {
+        case WireType::NEW_ORDER: name = newOrder.symbol; break;
+        case WireType::CANCEL: name = cancel.symbol; break;
+        case WireType::MODIFY: name = modify.symbol; break;
+        case WireType::TRADE: name = trade.symbol; break;
+        default: return std::string_view();
+    }
+    return symbolView(name);
+}
+
+uint64_t WireMessage::timestampNs() const {
+    switch (type) {
+        case WireType::NEW_ORDER: return newOrder.timestampNs;
+        case WireType::CANCEL: return cancel.timestampNs;
+        case WireType::MODIFY: return modify.timestampNs;
+        case WireType::TRADE: return trade.timestampNs;
+        default: return 0;
+    }
+}
+
+void WireEncoder::writeFileHeader() {
+    WireFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, WIRE_FILE_MAGIC, sizeof(header.magic));
+    header.version = WIRE_VERSION;
+    append(header);
+}
+
+void WireEncoder::encodeNewOrder(const Order& order) {
+    auto message = makeMessage<WireNewOrder>(WireType::NEW_ORDER);
+    message.orderType = static_cast<uint8_t>(order.type);
+    message.side = static_cast<uint8_t>(order.side);
+    message.timeInForce = static_cast<uint8_t>(order.timeInForce);
+    message.orderId = order.orderId;
+    message.clientId = order.clientId;
+    message.price = toWirePrice(order.price);
+    message.stopPrice = toWirePrice(order.stopPrice);
+    message.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        order.timestamp.time_since_epoch()).count());
+    message.quantity = order.remainingQty;
+    message.displayQty = order.displayQty;
+    copySymbol(message.symbol, order.symbol);
+    append(message);
+}
+
+void WireEncoder::encodeNewOrder(const CompactOrder& order) {
+    encodeNewOrder(order.toOrder());
+}
+
+void WireEncoder::encodeCancel(uint64_t orderId, const std::string& symbol, uint64_t timestampNs) {
+    auto message = makeMessage<WireCancel>(WireType::CANCEL);
+    message.orderId = orderId;
+    message.timestampNs = timestampNs ? timestampNs : wallClockNs();
+    copySymbol(message.symbol, symbol);
+    append(message);
+}
+
+void WireEncoder::encodeModify(uint64_t orderId, const std::string& symbol, double price,
+                               uint32_t quantity, uint64_t timestampNs) {
+    auto message = makeMessage<WireModify>(WireType::MODIFY);
+    message.orderId = orderId;
+    message.price = toWirePrice(price);
+    message.quantity = quantity;
+    message.timestampNs = timestampNs ? timestampNs : wallClockNs();
+    copySymbol(message.symbol, symbol);
+    append(message);
+}
+
+void WireEncoder::encodeTrade(const Trade& trade, const std::string& symbol, uint64_t timestampNs) {
+    auto message = makeMessage<WireTrade>(WireType::TRADE);
+    message.buyOrderId = trade.buyOrderId;
+    message.sellOrderId = trade.sellOrderId;
+    message.price = toWirePrice(trade.price);
+    message.quantity = trade.qty;
+    message.timestampNs = timestampNs ? timestampNs : wallClockNs();
+    copySymbol(message.symbol, symbol);
+    append(message);
+}
+
+const std::vector<char>& WireEncoder::buffer() const {
+    return buffer_;
+}
+
+size_t WireEncoder::size() const {
+    return buffer_.size();
+}
+
+void WireEncoder::clear() {
+    buffer_.clear();
+}
+
+template<typename T>
+void WireEncoder::append(const T& message) {
+    const char* bytes = reinterpret_cast<const char*>(&message);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+}
+
+WireDecoder::WireDecoder(std::string_view data) : data_(data) {}
+
+WireStatus WireDecoder::next(WireMessage& out) {
+    while (true) {
+        size_t remaining = data_.size() - offset_;
+        if (remaining == 0) return WireStatus::END;
+        if (remaining < sizeof(WireHeader)) return WireStatus::TRUNCATED;
+
+        WireHeader header;
+        std::memcpy(&header, data_.data() + offset_, sizeof(header));
+        if (header.length < minimumLength(header.type)) return WireStatus::BAD_LENGTH;
+        if (header.length > remaining) return WireStatus::TRUNCATED;
+
+        const char* message = data_.data() + offset_;
+        if (header.type == WireType::NEW_ORDER) {
+            std::memcpy(&out.newOrder, message, sizeof(WireNewOrder));
+            if (!validNewOrder(out.newOrder) ||
+                !pricesOnTick(out.newOrder, tickSizeOf(out.newOrder.symbol))) {
+                return WireStatus::BAD_FIELD;
+            }
+        } else if (header.type == WireType::MODIFY) {
+            // The side is not on the message, so there is no safe direction to round in
+            std::memcpy(&out.modify, message, sizeof(WireModify));
+            if (!onTick(out.modify.price, tickSizeOf(out.modify.symbol))) return WireStatus::BAD_FIELD;
+        }
+        offset_ += header.length;
+        out.type = header.type;
+        // Newer senders may append fields; only the known prefix is read
+        switch (header.type) {
+            case WireType::NEW_ORDER: return WireStatus::OK;
+            case WireType::CANCEL: std::memcpy(&out.cancel, message, sizeof(WireCancel)); return WireStatus::OK;
+            case WireType::MODIFY: return WireStatus::OK;
+            case WireType::TRADE: std::memcpy(&out.trade, message, sizeof(WireTrade)); return WireStatus::OK;
+            default: continue;
+        }
+    }
+}
+
+double WireDecoder::tickSizeOf(const char* symbol) {
+    return SymbolTable::instance().getTickSize(symbols_.intern(symbolView(symbol)));
+}
+
+size_t WireDecoder::offset() const {
+    return offset_;
+}
+
+size_t WireDecoder::checkFileHeader(std::string_view data) {
+    if (data.size() < sizeof(WireFileHeader)) return 0;
+    WireFileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, WIRE_FILE_MAGIC, sizeof(header.magic)) != 0) return 0;
+    if (header.version != WIRE_VERSION) return 0;
+    return sizeof(WireFileHeader);
+}
+
+CompactOrder WireDecoder::toCompactOrder(const WireNewOrder& message, SymbolCache& symbols) {
+    CompactOrder order;
+    order.orderId = message.orderId;
+    order.clientId = message.clientId;
+    order.symbolId = symbols.intern(symbolView(message.symbol));
+    double tickSize = SymbolTable::instance().getTickSize(order.symbolId);
+    OrderSide side = static_cast<OrderSide>(message.side);
+    order.priceTicks = CompactOrder::limitTicks(fromWirePrice(message.price), tickSize, side);
+    order.stopTicks = CompactOrder::stopTicksFor(fromWirePrice(message.stopPrice), tickSize, side);
+    // Keep the sender's time, so journals and snapshots of a replay record
+    // when the order was made rather than when it was decoded
+    auto wallClock = message.timestampNs
+        ? std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::nanoseconds(message.timestampNs)))
+        : std::chrono::system_clock::now();
+    order.timestampNs = CompactOrder::toMonotonicNs(wallClock);
+    order.quantity = message.quantity;
+    order.remainingQty = message.quantity;
+    order.type = static_cast<OrderType>(message.orderType);
+    order.side = static_cast<OrderSide>(message.side);
+    order.timeInForce = static_cast<TimeInForce>(message.timeInForce);
+    order.displayQty = message.displayQty;
+    return order;
+}
+
+CompactOrder WireDecoder::toCompactOrder(const WireCancel& message, SymbolCache& symbols) {
+    return CompactOrder::makeCancel(message.orderId, symbols.intern(symbolView(message.symbol)));
+}
+
+CompactOrder WireDecoder::toCompactOrder(const WireModify& message, SymbolCache& symbols) {
+    uint32_t symbolId = symbols.intern(symbolView(message.symbol));
+    double tickSize = SymbolTable::instance().getTickSize(symbolId);
+    // next() has refused off-tick prices, so nearest is exact
+    return CompactOrder::makeModify(message.orderId, symbolId,
+                                    Utils::priceToTicks(fromWirePrice(message.price), tickSize),
+                                    message.quantity);
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "../engine/CompactOrder.h"
+#include "../engine/OrderBook.h"
+#include "../engine/SymbolTable.h"
+
+// Fixed-layout binary order messages. Every field is little-endian at a
+// fixed offset, every message starts with a WireHeader and is a multiple of
+// 8 bytes long, so a file of them can be replayed without any parsing.
+// Prices are signed fixed point with WIRE_PRICE_SCALE units per 1.0;
+// symbols are up to 8 ASCII bytes, NUL padded.
+//
+// A wire file is a WireFileHeader followed by messages back to back.
+// Readers skip message types they do not know using the header's length.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The wire format is read and written in host order, which must be little-endian"
+#endif
+
+constexpr int64_t WIRE_PRICE_SCALE = 100000000;
+constexpr size_t WIRE_SYMBOL_SIZE = 8;
+constexpr char WIRE_FILE_MAGIC[8] = {'O', 'B', 'M', 'E', 'W', 'I', 'R', 'E'};
+constexpr uint16_t WIRE_VERSION = 1;
+
+enum class WireType : uint8_t {
+    NEW_ORDER = 1,
+    CANCEL = 2,
+    MODIFY = 3,
+    TRADE = 4
+};
+
+struct WireHeader {
+    uint16_t length;        // Whole message, header included
+    WireType type;
+    uint8_t reserved;
+};
+
+struct WireFileHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t reserved2;
+};
+
+struct WireNewOrder {
+    WireHeader header;
+    uint8_t orderType;      // OrderType
+    uint8_t side;           // OrderSide
+    uint8_t timeInForce;    // TimeInForce; zero (GTC) in older files
+    uint8_t reserved;
+    uint64_t orderId;
+    uint64_t clientId;
+    int64_t price;
+    int64_t stopPrice;
+    uint64_t timestampNs;
+    uint32_t quantity;
+    uint32_t displayQty;    // Iceberg peak size; zero (fully shown) in older files
+    char symbol[WIRE_SYMBOL_SIZE];
+};
+
+struct WireCancel {
+    WireHeader header;
+    uint8_t reserved[4];
+    uint64_t orderId;
+    uint64_t timestampNs;
+    char symbol[WIRE_SYMBOL_SIZE];
+};
+
+// New price and total quantity for a resting order
+struct WireModify {
+    WireHeader header;
+    uint8_t reserved[4];
+    uint64_t orderId;
+    int64_t price;
+    uint64_t timestampNs;
+    uint32_t quantity;
+    uint32_t reserved2;
+    char symbol[WIRE_SYMBOL_SIZE];
+};
+
+struct WireTrade {
+    WireHeader header;
+    uint8_t reserved[4];
+    uint64_t buyOrderId;
+    uint64_t sellOrderId;
+    int64_t price;
+    uint64_t timestampNs;
+    uint32_t quantity;
+    uint32_t reserved2;
+    char symbol[WIRE_SYMBOL_SIZE];
+};
+
+static_assert(sizeof(WireHeader) == 4, "WireHeader layout changed");
+static_assert(sizeof(WireFileHeader) == 16, "WireFileHeader layout changed");
+static_assert(sizeof(WireNewOrder) == 64, "WireNewOrder layout changed");
+static_assert(sizeof(WireCancel) == 32, "WireCancel layout changed");
+static_assert(sizeof(WireModify) == 48, "WireModify layout changed");
+static_assert(sizeof(WireTrade) == 56, "WireTrade layout changed");
+static_assert(std::is_trivially_copyable<WireNewOrder>::value, "Wire messages must be trivially copyable");
+
+// One decoded message; the member matching type is valid
+struct WireMessage {
+    WireType type;
+    union {
+        WireHeader header;
+        WireNewOrder newOrder;
+        WireCancel cancel;
+        WireModify modify;
+        WireTrade trade;
+    };
+
+    std::string_view symbol() const;
+    uint64_t timestampNs() const;
+};
+
+int64_t toWirePrice(double price);
+double fromWirePrice(int64_t price);
+
+// Appends encoded messages to an in-memory buffer. Symbols longer than
+// WIRE_SYMBOL_SIZE throw std::invalid_argument.
+class WireEncoder {
+public:
+    void writeFileHeader();
+    void encodeNewOrder(const Order& order);
+    void encodeNewOrder(const CompactOrder& order);
+    void encodeCancel(uint64_t orderId, const std::string& symbol, uint64_t timestampNs = 0);
+    void encodeModify(uint64_t orderId, const std::string& symbol, double price, uint32_t quantity,
+                      uint64_t timestampNs = 0);
+    void encodeTrade(const Trade& trade, const std::string& symbol, uint64_t timestampNs = 0);
+
+    const std::vector<char>& buffer() const;
+    size_t size() const;
+    void clear();
+
+private:
+    template<typename T>
+    void append(const T& message);
+
+    std::vector<char> buffer_;
+};
+
+enum class WireStatus {
+    OK,
+    END,            // No bytes left
+    TRUNCATED,      // Partial message at the end of the buffer
+    BAD_LENGTH,     // Length smaller than the header or than its type requires
+    BAD_FIELD       // NEW_ORDER whose type, side or time in force byte is out of
+                    // range or whose type is CANCEL or MODIFY, or a NEW_ORDER or
+                    // MODIFY with a price off its symbol's tick grid
+};
+
+// Walks a buffer of messages (without the file header) and copies each one
+// out. Unknown types are skipped. On an error offset() stays at the start of
+// the offending message.
+class WireDecoder {
+public:
+    explicit WireDecoder(std::string_view data);
+
+    WireStatus next(WireMessage& out);
+    size_t offset() const;
+
+    // Checks a file's header; returns the offset of the first message, or 0
+    // if the header is missing or from an unsupported version
+    static size_t checkFileHeader(std::string_view data);
+    // Maps a NEW_ORDER onto the engine's hot-path order: symbol interned via
+    // the cache, wire timestamp moved onto the monotonic clock (now when it
+    // is zero). next() only returns on-grid prices; others would be rounded
+    // as CompactOrder::fromOrder does.
+    static CompactOrder toCompactOrder(const WireNewOrder& message, SymbolCache& symbols);
+    static CompactOrder toCompactOrder(const WireCancel& message, SymbolCache& symbols);
+    static CompactOrder toCompactOrder(const WireModify& message, SymbolCache& symbols);
+
+private:
+    double tickSizeOf(const char* symbol);
+
+    std::string_view data_;
+    size_t offset_ = 0;
+    SymbolCache symbols_;   // For tick sizes while validating
+};
@@ -0,0 +1,309 @@
+#include "Workload.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "OrderParser.h"
+#include "WireFormat.h"
+#include "../engine/SymbolTable.h"
+
+namespace {
+
+void fill(Order& out, uint64_t orderId, uint64_t clientId, const std::string& symbol, OrderType type,
+          OrderSide side, double price, uint32_t quantity) {
+    out.orderId = orderId;
+    out.clientId = clientId;
+    out.symbol = symbol;
+    out.type = type;
+    out.side = side;
+    out.price = price;
+    out.quantity = quantity;
+    out.remainingQty = quantity;
+    out.timeInForce = TimeInForce::GTC;
+    out.displayQty = 0;
+    out.visibleQty = 0;
+    out.stopPrice = 0.0;
+}
+
+// Normalized running sum of weights
+std::vector<double> cumulative(const std::vector<double>& weights) {
+    std::vector<double> cdf;
+    double total = 0.0;
+    for (double w : weights) total += w;
+    double sum = 0.0;
+    for (double w : weights) {
+        sum += w;
+        cdf.push_back(sum / total);
+    }
+    cdf.back() = 1.0;
+    return cdf;
+}
+
+bool inUnit(double value) {
+    return value >= 0.0 && value <= 1.0;
+}
+
+} // namespace
+
+WorkloadGenerator::WorkloadGenerator(WorkloadConfig config)
+    : config_(std::move(config)), rng_(config_.seed) {
+    if (config_.symbols.empty()) throw std::invalid_argument("Workload needs at least one symbol");
+    if (!(config_.baseRate > 0.0)) throw std::invalid_argument("Workload baseRate must be positive");
+    if (config_.arrivals == ArrivalProcess::HAWKES &&
+        (config_.branchingRatio < 0.0 || config_.branchingRatio >= 1.0 || !(config_.decayRate > 0.0))) {
+        throw std::invalid_argument("Hawkes arrivals need 0 <= branchingRatio < 1 and a positive decayRate");
+    }
+    if (!inUnit(config_.cancelRatio) || !inUnit(config_.modifyRatio) ||
+        config_.cancelRatio + config_.modifyRatio > 1.0 ||
+        !inUnit(config_.marketRatio) || !inUnit(config_.aggressiveRatio) ||
+        config_.marketRatio + config_.aggressiveRatio > 1.0 || !inUnit(config_.midMoveProbability)) {
+        throw std::invalid_argument("Workload ratios must be in [0, 1] and sum to at most 1");
+    }
+    if (!(config_.touchDecay > 0.0) || config_.touchDecay > 1.0 || config_.maxOffsetTicks < 0 ||
+        config_.halfSpreadTicks < 0 || config_.meanQuantity < 1.0) {
+        throw std::invalid_argument("Workload price or quantity parameters out of range");
+    }
+
+    std::vector<double> weights;
+    for (size_t i = 0; i < config_.symbols.size(); ++i) {
+        weights.push_back(1.0 / std::pow(static_cast<double>(i + 1), config_.zipfExponent));
+    }
+    symbolCdf_ = cumulative(weights);
+    weights.clear();
+    for (int64_t offset = 0; offset <= config_.maxOffsetTicks; ++offset) {
+        weights.push_back(std::pow(config_.touchDecay, static_cast<double>(offset)));
+    }
+    offsetCdf_ = cumulative(weights);
+
+    auto& table = SymbolTable::instance();
+    for (const auto& name : config_.symbols) {
+        symbols_.push_back(SymbolState{name, table.getTickSize(table.intern(name)), config_.startMidTicks, {}});
+    }
+}
+
+// 53 random bits, so [0, 1) is drawn the same way everywhere
+double WorkloadGenerator::uniform() {
+    return static_cast<double>(rng_() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+size_t WorkloadGenerator::pick(const std::vector<double>& cdf) {
+    size_t index = std::upper_bound(cdf.begin(), cdf.end(), uniform()) - cdf.begin();
+    return std::min(index, cdf.size() - 1);
+}
+
+uint32_t WorkloadGenerator::drawQuantity() {
+    if (config_.meanQuantity <= 1.0) return 1;
+    // Geometric on 1, 2, ... with the configured mean
+    double failure = 1.0 - 1.0 / config_.meanQuantity;
+    double extra = std::floor(std::log1p(-uniform()) / std::log(failure));
+    return static_cast<uint32_t>(1.0 + std::min(extra, 1e9));
+}
+
+int64_t WorkloadGenerator::passiveTicks(const SymbolState& symbol, OrderSide side) {
+    int64_t behind = config_.halfSpreadTicks + static_cast<int64_t>(pick(offsetCdf_));
+    int64_t ticks = side == OrderSide::BUY ? symbol.midTicks - behind : symbol.midTicks + behind;
+    return std::max<int64_t>(ticks, 1);
+}
+
+// Hawkes by thinning: between arrivals the rate only decays, so its current
+// value bounds it until the next candidate
+uint64_t WorkloadGenerator::nextArrivalNs() {
+    if (config_.arrivals == ArrivalProcess::POISSON) {
+        clockSeconds_ -= std::log1p(-uniform()) / config_.baseRate;
+    } else {
+        while (true) {
+            double bound = config_.baseRate + excitation_;
+            double gap = -std::log1p(-uniform()) / bound;
+            clockSeconds_ += gap;
+            excitation_ *= std::exp(-config_.decayRate * gap);
+            if (uniform() * bound <= config_.baseRate + excitation_) break;
+        }
+        excitation_ += config_.branchingRatio * config_.decayRate;
+    }
+    return getElapsedNs();
+}
+
+void WorkloadGenerator::newOrder(SymbolState& symbol, Order& out) {
+    OrderSide side = uniform() < 0.5 ? OrderSide::BUY : OrderSide::SELL;
+    uint64_t orderId = nextOrderId_++;
+    uint64_t clientId = 1 + static_cast<uint64_t>(uniform() * 1000.0);
+    uint32_t quantity = drawQuantity();
+    double kind = uniform();
+    if (kind < config_.marketRatio) {
+        fill(out, orderId, clientId, symbol.name, OrderType::MARKET, side, 0.0, quantity);
+        return;
+    }
+    if (kind < config_.marketRatio + config_.aggressiveRatio) {
+        // Through the opposite touch; expected to trade, so never cancelled
+        int64_t through = config_.halfSpreadTicks + static_cast<int64_t>(pick(offsetCdf_));
+        int64_t ticks = side == OrderSide::BUY ? symbol.midTicks + through : symbol.midTicks - through;
+        fill(out, orderId, clientId, symbol.name, OrderType::LIMIT, side,
+             std::max<int64_t>(ticks, 1) * symbol.tickSize, quantity);
+        return;
+    }
+    int64_t ticks = passiveTicks(symbol, side);
+    symbol.live.push_back(Live{orderId, side, ticks, quantity});
+    fill(out, orderId, clientId, symbol.name, OrderType::LIMIT, side, ticks * symbol.tickSize, quantity);
+}
+
+void WorkloadGenerator::next(Order& out) {
+    uint64_t elapsedNs = nextArrivalNs();
+    SymbolState& symbol = symbols_[pick(symbolCdf_)];
+    if (uniform() < config_.midMoveProbability) symbol.midTicks += uniform() < 0.5 ? -1 : 1;
+
+    double kind = uniform();
+    if (kind < config_.cancelRatio + config_.modifyRatio && !symbol.live.empty()) {
+        size_t index = std::min(static_cast<size_t>(uniform() * symbol.live.size()), symbol.live.size() - 1);
+        Live& target = symbol.live[index];
+        if (kind < config_.cancelRatio) {
+            fill(out, target.orderId, 1, symbol.name, OrderType::CANCEL, target.side,
+                 target.ticks * symbol.tickSize, target.quantity);
+            target = symbol.live.back();
+            symbol.live.pop_back();
+        } else {
+            // Half shrink in place, keeping queue priority; half move to a
+            // new passive price with a new size
+            if (target.quantity > 1 && uniform() < 0.5) {
+                target.quantity = 1 + static_cast<uint32_t>(uniform() * (target.quantity - 1));
+            } else {
+                target.ticks = passiveTicks(symbol, target.side);
+                target.quantity = drawQuantity();
+            }
+            fill(out, target.orderId, 1, symbol.name, OrderType::MODIFY, target.side,
+                 target.ticks * symbol.tickSize, target.quantity);
+        }
+    } else {
+        newOrder(symbol, out);
+    }
+    out.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(config_.startTimeNs + elapsedNs)));
+    out.lastModified = out.timestamp;
+    generated_++;
+}
+
+std::vector<Order> WorkloadGenerator::generate(size_t count) {
+    std::vector<Order> orders(count);
+    for (auto& order : orders) next(order);
+    return orders;
+}
+
+std::vector<CompactOrder> WorkloadGenerator::generateCompact(size_t count) {
+    std::vector<CompactOrder> orders;
+    orders.reserve(count);
+    Order order;
+    for (size_t i = 0; i < count; ++i) {
+        next(order);
+        orders.push_back(CompactOrder::fromOrder(order));
+    }
+    return orders;
+}
+
+uint64_t WorkloadGenerator::getGenerated() const {
+    return generated_;
+}
+
+uint64_t WorkloadGenerator::getElapsedNs() const {
+    return static_cast<uint64_t>(clockSeconds_ * 1e9);
+}
+
+WorkloadFormat WorkloadFile::formatFor(const std::string& path) {
+    bool binary = path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    return binary ? WorkloadFormat::WIRE : WorkloadFormat::JSON_LINES;
+}
+
+void WorkloadFile::write(const std::string& path, const std::vector<Order>& orders) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) throw std::runtime_error("Cannot create workload file: " + path);
+
+    if (formatFor(path) == WorkloadFormat::WIRE) {
+        WireEncoder encoder;
+        encoder.writeFileHeader();
+        for (size_t i = 0; i < orders.size(); ++i) {
+            const Order& order = orders[i];
+            uint64_t timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                order.timestamp.time_since_epoch()).count());
+            if (order.type == OrderType::CANCEL) {
+                encoder.encodeCancel(order.orderId, order.symbol, timestampNs);
+            } else if (order.type == OrderType::MODIFY) {
+                encoder.encodeModify(order.orderId, order.symbol, order.price, order.quantity, timestampNs);
+            } else {
+                encoder.encodeNewOrder(order);
+            }
+            if (encoder.size() >= (1 << 20) || i + 1 == orders.size()) {
+                out.write(encoder.buffer().data(), static_cast<std::streamsize>(encoder.size()));
+                encoder.clear();
+            }
+        }
+        if (orders.empty()) out.write(encoder.buffer().data(), static_cast<std::streamsize>(encoder.size()));
+    } else {
+        char line[256];
+        for (const auto& order : orders) {
+            long long timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                order.timestamp.time_since_epoch()).count();
+            int length = std::snprintf(line, sizeof(line),
+                "{\"orderId\":%llu,\"clientId\":%llu,\"symbol\":\"%s\",\"type\":\"%s\",\"side\":\"%s\","
+                "\"price\":%.10g,\"quantity\":%u,\"timestamp\":%lld}\n",
+                static_cast<unsigned long long>(order.orderId), static_cast<unsigned long long>(order.clientId),
+                order.symbol.c_str(), orderTypeToString(order.type).c_str(),
+                order.side == OrderSide::BUY ? "BUY" : "SELL", order.price, order.quantity, timestampNs);
+            out.write(line, std::min<int>(length, sizeof(line) - 1));
+        }
+    }
+    if (!out.flush()) throw std::runtime_error("Failed writing workload file: " + path);
+}
+
+std::vector<CompactOrder> WorkloadFile::load(const std::string& path) {
+    MappedFile file(path);
+    std::string_view data = file.view();
+    std::vector<CompactOrder> orders;
+
+    if (formatFor(path) == WorkloadFormat::WIRE) {
+        size_t start = WireDecoder::checkFileHeader(data);
+        if (start == 0) throw std::runtime_error("Not a wire workload file: " + path);
+        WireDecoder decoder(data.substr(start));
+        SymbolCache symbols;
+        WireMessage message;
+        WireStatus status;
+        while ((status = decoder.next(message)) == WireStatus::OK) {
+            switch (message.type) {
+                case WireType::NEW_ORDER:
+                    orders.push_back(WireDecoder::toCompactOrder(message.newOrder, symbols));
+                    break;
+                case WireType::CANCEL:
+                    orders.push_back(WireDecoder::toCompactOrder(message.cancel, symbols));
+                    break;
+                case WireType::MODIFY:
+                    orders.push_back(WireDecoder::toCompactOrder(message.modify, symbols));
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (status != WireStatus::END) {
+            throw std::runtime_error("Damaged workload message at offset " +
+                                     std::to_string(start + decoder.offset()) + " in " + path);
+        }
+        return orders;
+    }
+
+    OrderParser parser;
+    Order order;
+    size_t lineNumber = 0;
+    while (!data.empty()) {
+        size_t end = data.find('\n');
+        std::string_view line = data.substr(0, end);
+        data = end == std::string_view::npos ? std::string_view() : data.substr(end + 1);
+        lineNumber++;
+        if (line.empty()) continue;
+        ParseError error = parser.parse(line, order);
+        if (error != ParseError::OK) {
+            throw std::runtime_error(std::string("Bad workload line ") + std::to_string(lineNumber) +
+                                     " in " + path + ": " + parseErrorToString(error));
+        }
+        orders.push_back(CompactOrder::fromOrder(order));
+    }
+    return orders;
+}
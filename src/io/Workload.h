@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "../engine/CompactOrder.h"
+#include "../engine/Order.h"
+
+// Synthetic order flow shaped like a real book's rather than uniform noise:
+// bursty arrivals, passive prices clustered at the touch, most resting
+// orders cancelled or modified, and a few symbols taking most of the flow.
+// Everything is drawn from one seeded engine with hand-rolled inverse-CDF
+// sampling, so a seed gives the same stream with any standard library.
+
+enum class ArrivalProcess {
+    POISSON,    // Independent exponential gaps at baseRate
+    HAWKES      // Self-exciting: every arrival raises the rate, which decays back
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 1;
+    // Most popular first; symbol i is picked with weight 1 / (i + 1)^zipfExponent
+    std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA"};
+    double zipfExponent = 1.0;
+
+    ArrivalProcess arrivals = ArrivalProcess::HAWKES;
+    double baseRate = 100000.0;     // Messages per second; the Hawkes background rate
+    // Hawkes only: expected arrivals each arrival triggers (below 1, so the
+    // long-run rate is baseRate / (1 - branchingRatio)), and how fast the
+    // excitation fades, per second
+    double branchingRatio = 0.6;
+    double decayRate = 5000.0;
+
+    // Share of messages that cancel or modify a resting order this stream
+    // sent earlier; the rest are new orders
+    double cancelRatio = 0.45;
+    double modifyRatio = 0.05;
+    // Share of new orders that are market orders, and of new limits priced
+    // through the opposite touch
+    double marketRatio = 0.03;
+    double aggressiveRatio = 0.05;
+
+    // Passive prices sit offset ticks behind the touch, offset being 0 with
+    // the highest weight and each further tick touchDecay times less likely
+    double touchDecay = 0.6;
+    int64_t maxOffsetTicks = 50;
+    int64_t startMidTicks = 10000;  // At each symbol's tick size
+    int64_t halfSpreadTicks = 1;
+    double midMoveProbability = 0.02;   // Per message, a one-tick step either way
+
+    double meanQuantity = 100.0;    // Geometric, at least 1
+    // When the workload starts, in nanoseconds since the system clock's epoch
+    uint64_t startTimeNs = 1700000000000000000ULL;
+};
+
+class WorkloadGenerator {
+public:
+    // Throws std::invalid_argument if the configuration cannot produce a stream
+    explicit WorkloadGenerator(WorkloadConfig config = WorkloadConfig());
+
+    // The next message: a LIMIT or MARKET order, or a CANCEL or MODIFY of a
+    // resting order it sent. A CANCEL carries the target's side and
+    // remaining quantity so the text formats can express it; a MODIFY
+    // carries the new price and total quantity. The timestamp is the
+    // simulated arrival time.
+    void next(Order& out);
+    std::vector<Order> generate(size_t count);
+    std::vector<CompactOrder> generateCompact(size_t count);
+
+    uint64_t getGenerated() const;
+    // Nanoseconds from startTimeNs to the last message
+    uint64_t getElapsedNs() const;
+
+private:
+    struct Live {
+        uint64_t orderId;
+        OrderSide side;
+        int64_t ticks;
+        uint32_t quantity;
+    };
+    struct SymbolState {
+        std::string name;
+        double tickSize;
+        int64_t midTicks;
+        std::vector<Live> live;     // Resting orders that may still be cancelled
+    };
+
+    double uniform();
+    size_t pick(const std::vector<double>& cdf);
+    uint32_t drawQuantity();
+    int64_t passiveTicks(const SymbolState& symbol, OrderSide side);
+    uint64_t nextArrivalNs();
+    void newOrder(SymbolState& symbol, Order& out);
+
+    WorkloadConfig config_;
+    std::mt19937_64 rng_;
+    std::vector<double> symbolCdf_;
+    std::vector<double> offsetCdf_;
+    std::vector<SymbolState> symbols_;
+    double clockSeconds_ = 0.0;
+    double excitation_ = 0.0;       // Hawkes intensity above baseRate at clockSeconds_
+    uint64_t nextOrderId_ = 1;
+    uint64_t generated_ = 0;
+};
+
+enum class WorkloadFormat {
+    WIRE,       // WireFormat messages behind a file header; the fast path
+    JSON_LINES  // One OrderParser JSON object per line, with "timestamp"
+};
+
+// Workload files for DataFeed or the benchmarks. ".bin" paths are WIRE,
+// anything else JSON_LINES. Throw std::runtime_error on I/O errors or, when
+// loading, on a message that does not decode.
+class WorkloadFile {
+public:
+    static WorkloadFormat formatFor(const std::string& path);
+    static void write(const std::string& path, const std::vector<Order>& orders);
+    // Decodes the whole file up front so a replay times only the engine
+    static std::vector<CompactOrder> load(const std::string& path);
+};
@@ -1,47 +1,129 @@
-// Entry point for OBME core
-#include <iostream>
-#include <random>
-#include <thread>
-#include <chrono>
-#include "engine/OrderBook.h"
-#include "engine/Matcher.h"
-#include "io/Logger.h"
-#include "models/OrderType.h"
-#include "models/OrderSide.h"
-
-int main() {
-    Logger logger("../data/logs.txt");
-    OrderBook book;
-    book.setTradeCallback([&logger](const Order& buy, const Order& sell, double price, uint32_t qty) {
-        logger.logTrade("buy=" + std::to_string(buy.orderId) + ",sell=" + std::to_string(sell.orderId) + ",price=" + std::to_string(price) + ",qty=" + std::to_string(qty));
-    });
-    Matcher matcher(book, logger);
-    matcher.start();
-
-    const int numOrders = 10000;
-    std::mt19937 rng(42);
-    std::uniform_int_distribution<> sideDist(0, 1);
-    std::uniform_real_distribution<> priceDist(99.0, 101.0);
-    std::uniform_int_distribution<> qtyDist(1, 100);
-
-    auto start = std::chrono::high_resolution_clock::now();
-    for (int i = 1; i <= numOrders; ++i) {
-        Order order;
-        order.orderId = i;
-        order.symbol = "AAPL";
-        order.type = OrderType::LIMIT;
-        order.side = sideDist(rng) == 0 ? OrderSide::BUY : OrderSide::SELL;
-        order.price = priceDist(rng);
-        order.quantity = qtyDist(rng);
-        order.remainingQty = order.quantity;
-        order.timestamp = std::chrono::system_clock::now();
-        matcher.submitOrder(order);
-    }
-    matcher.stop();
-    auto end = std::chrono::high_resolution_clock::now();
-    double ms = std::chrono::duration<double, std::milli>(end - start).count();
-    std::cout << "Processed " << matcher.getProcessedOrders() << " orders in " << ms << " ms (" << (matcher.getProcessedOrders() / ms * 1000) << "/sec)\n";
-    std::cout << "Total trades: " << book.getTotalTrades() << std::endl;
-    std::cout << "Best Bid: " << book.getBestBid() << ", Best Ask: " << book.getBestAsk() << std::endl;
-    return 0;
-}
+// Entry point for OBME core
+#include <iostream>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include "engine/OrderBook.h"
+#include "engine/Matcher.h"
+#include "io/Logger.h"
+#include "io/Journal.h"
+#include "io/Snapshot.h"
+#include "models/OrderType.h"
+#include "models/OrderSide.h"
+
+// Rebuilds the book from the latest snapshot, if any, and the journal after
+// it, as a restarted engine would
+static int recover(const std::string& journalPath, const std::string& snapshotPath) {
+    OrderBook book;
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t sequence = recoverBooks(book, snapshotPath, journalPath);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << "Recovered through sequence " << sequence << " in " << ms << " ms\n";
+    std::cout << "Total trades: " << book.getTotalTrades() << std::endl;
+    std::cout << "Best Bid: " << book.getBestBid() << ", Best Ask: " << book.getBestAsk() << std::endl;
+    return 0;
+}
+
+// Usage: obme-core [--journal <path> [--snapshot <path>]] | --recover <path> [--snapshot <path>]
+int main(int argc, char** argv) {
+    std::string journalPath;
+    std::string recoverPath;
+    std::string snapshotPath;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--recover") == 0) recoverPath = argv[i + 1];
+        if (std::strcmp(argv[i], "--journal") == 0) journalPath = argv[i + 1];
+        if (std::strcmp(argv[i], "--snapshot") == 0) snapshotPath = argv[i + 1];
+    }
+    if (!recoverPath.empty()) return recover(recoverPath, snapshotPath);
+
+    Logger logger("../data/logs.txt", LogMode::ASYNC_TEXT);
+    OrderBook book;
+    // Fills leave the book as fixed-size reports and this thread logs them,
+    // so matching never waits on the logger
+    ExecutionFeed executions(1 << 16);
+    book.setExecutionFeed(&executions);
+    MatcherConfig config;
+    config.ingress = IngressMode::SPSC_RING;
+    std::unique_ptr<JournalWriter> journal;
+    if (!journalPath.empty()) {
+        journal = std::make_unique<JournalWriter>(journalPath);
+        config.journal = journal.get();
+        if (!snapshotPath.empty()) {
+            config.snapshotPath = snapshotPath;
+            config.snapshotInterval = 4096;
+        }
+    }
+    Matcher matcher(book, logger, config);
+    // Histograms are read while the matcher records into them
+    auto printLatency = [&] {
+        BookLatencyStats stats = book.getLatencyStats();
+        std::cout << "Queue wait ns: " << matcher.getQueueWait().summary() << "\n"
+                  << "Service ns:    " << stats.service.summary() << "\n"
+                  << "Cancel ns:     " << stats.cancel.summary() << "\n"
+                  << "Match depth:   " << stats.matchDepth.summary() << std::endl;
+    };
+    std::atomic<bool> matching{true};
+    std::thread reporter([&] {
+        ExecutionReport reports[256];
+        auto nextDump = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (matching.load(std::memory_order_acquire) || !executions.empty()) {
+            if (std::chrono::steady_clock::now() >= nextDump) {
+                printLatency();
+                nextDump += std::chrono::seconds(1);
+            }
+            size_t n = executions.tryPopBatch(reports, 256);
+            if (n == 0) std::this_thread::yield();
+            for (size_t i = 0; i < n; ++i) {
+                logger.logTrade(reports[i].buyOrderId, reports[i].sellOrderId, reports[i].price, reports[i].qty);
+            }
+        }
+    });
+    matcher.start();
+
+    const int numOrders = 10000;
+    const size_t batchSize = 256;
+    std::vector<Order> batch;
+    batch.reserve(batchSize);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<> sideDist(0, 1);
+    std::uniform_real_distribution<> priceDist(99.0, 101.0);
+    std::uniform_int_distribution<> qtyDist(1, 100);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 1; i <= numOrders; ++i) {
+        Order order;
+        order.orderId = i;
+        order.symbol = "AAPL";
+        order.type = OrderType::LIMIT;
+        order.side = sideDist(rng) == 0 ? OrderSide::BUY : OrderSide::SELL;
+        order.price = std::round(priceDist(rng) * 100.0) / 100.0;  // On the 0.01 grid
+        order.quantity = qtyDist(rng);
+        order.remainingQty = order.quantity;
+        order.timestamp = std::chrono::system_clock::now();
+        batch.push_back(order);
+        if (batch.size() == batchSize || i == numOrders) {
+            matcher.submitBatch(batch);
+            batch.clear();
+            if (matcher.isHalted()) break;
+        }
+    }
+    matcher.stop();
+    matching.store(false, std::memory_order_release);
+    reporter.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << "Processed " << matcher.getProcessedOrders() << " orders in " << ms << " ms (" << (matcher.getProcessedOrders() / ms * 1000) << "/sec)\n";
+    std::cout << "Total trades: " << book.getTotalTrades() << std::endl;
+    std::cout << "Best Bid: " << book.getBestBid() << ", Best Ask: " << book.getBestAsk() << std::endl;
+    printLatency();
+    if (matcher.isHalted()) {
+        std::cerr << "Matcher halted: " << matcher.getHaltReason() << std::endl;
+        return 1;
+    }
+    return 0;
+}
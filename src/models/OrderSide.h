@@ -1,11 +1,12 @@
-#pragma once
-#include <string>
-
-enum class OrderSide {
-    BUY,
-    SELL
-};
-
-inline std::string orderSideToString(OrderSide side) {
-    return side == OrderSide::BUY ? "BUY" : "SELL";
-}
+#pragma once
+#include <cstdint>
+#include <string>
+
+enum class OrderSide : uint8_t {
+    BUY,
+    SELL
+};
+
+inline std::string orderSideToString(OrderSide side) {
+    return side == OrderSide::BUY ? "BUY" : "SELL";
+}
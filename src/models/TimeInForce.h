@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+enum class TimeInForce : uint8_t {
+    GTC,    // Good till cancelled: any residual rests in the book
+    IOC,    // Immediate or cancel: fill what is available, drop the rest
+    FOK     // Fill or kill: fill the whole quantity at once or nothing
+};
+
+inline std::string timeInForceToString(TimeInForce tif) {
+    switch (tif) {
+        case TimeInForce::GTC: return "GTC";
+        case TimeInForce::IOC: return "IOC";
+        case TimeInForce::FOK: return "FOK";
+        default: return "UNKNOWN";
+    }
+}
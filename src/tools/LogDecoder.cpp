@@ -0,0 +1,59 @@
+// Offline decoder for logs written in LogMode::ASYNC_BINARY
+// Usage: obme-logdecode <binary log> [output file]
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "io/LogRecord.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <binary log> [output file]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Failed to open log file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    LogFileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, LOG_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "Not a binary OBME log: " << argv[1] << std::endl;
+        return 1;
+    }
+    if (header.version != LOG_FILE_VERSION || header.recordSize != sizeof(LogRecord)) {
+        std::cerr << "Unsupported log version " << header.version
+                  << " (record size " << header.recordSize << ")" << std::endl;
+        return 1;
+    }
+
+    std::ofstream outFile;
+    if (argc > 2) {
+        outFile.open(argv[2]);
+        if (!outFile.is_open()) {
+            std::cerr << "Failed to open output file: " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = argc > 2 ? outFile : std::cout;
+
+    LogRecordFormatter formatter;
+    LogRecord records[1024];
+    std::string text;
+    uint64_t total = 0;
+    while (in) {
+        in.read(reinterpret_cast<char*>(records), sizeof(records));
+        size_t n = static_cast<size_t>(in.gcount()) / sizeof(LogRecord);
+        for (size_t i = 0; i < n; ++i) formatter.append(text, records[i]);
+        out << text;
+        text.clear();
+        total += n;
+    }
+    if (in.gcount() % sizeof(LogRecord) != 0) {
+        std::cerr << "Warning: trailing partial record ignored" << std::endl;
+    }
+    std::cerr << "Decoded " << total << " records" << std::endl;
+    return 0;
+}
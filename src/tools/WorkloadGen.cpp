@@ -0,0 +1,62 @@
+// Writes a seeded synthetic workload for replay benchmarks
+// Usage: obme-workload <output .bin|.json> [--messages N] [--seed N] [--poisson]
+//            [--rate R] [--branching N] [--decay D] [--symbols N] [--zipf S]
+//            [--cancel R] [--modify R] [--market R] [--aggressive R]
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include "io/Workload.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "Usage: " << argv[0] << " <output .bin|.json> [--messages N] [--seed N] [--poisson]"
+                  << " [--rate R] [--branching N] [--decay D] [--symbols N] [--zipf S]"
+                  << " [--cancel R] [--modify R] [--market R] [--aggressive R]" << std::endl;
+        return 1;
+    }
+
+    WorkloadConfig config;
+    size_t messages = 1000000;
+    for (int i = 2; i < argc; ++i) {
+        const char* flag = argv[i];
+        if (std::strcmp(flag, "--poisson") == 0) {
+            config.arrivals = ArrivalProcess::POISSON;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << std::endl;
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(flag, "--messages") == 0) messages = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(flag, "--seed") == 0) config.seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(flag, "--rate") == 0) config.baseRate = std::atof(value);
+        else if (std::strcmp(flag, "--branching") == 0) config.branchingRatio = std::atof(value);
+        else if (std::strcmp(flag, "--decay") == 0) config.decayRate = std::atof(value);
+        else if (std::strcmp(flag, "--zipf") == 0) config.zipfExponent = std::atof(value);
+        else if (std::strcmp(flag, "--cancel") == 0) config.cancelRatio = std::atof(value);
+        else if (std::strcmp(flag, "--modify") == 0) config.modifyRatio = std::atof(value);
+        else if (std::strcmp(flag, "--market") == 0) config.marketRatio = std::atof(value);
+        else if (std::strcmp(flag, "--aggressive") == 0) config.aggressiveRatio = std::atof(value);
+        else if (std::strcmp(flag, "--symbols") == 0) {
+            // SYM0 is the most popular
+            config.symbols.clear();
+            for (long n = 0; n < std::atol(value); ++n) config.symbols.push_back("SYM" + std::to_string(n));
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        WorkloadGenerator generator(config);
+        WorkloadFile::write(argv[1], generator.generate(messages));
+        std::cerr << "Wrote " << generator.getGenerated() << " messages spanning "
+                  << generator.getElapsedNs() / 1e6 << " ms of simulated time to " << argv[1] << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
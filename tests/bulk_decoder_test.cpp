@@ -0,0 +1,160 @@
+#include "../src/io/BulkDecoder.h"
+#include "../src/engine/SymbolTable.h"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const BulkDecoder::Isa ALL_ISAS[] = {
+    BulkDecoder::Isa::SCALAR, BulkDecoder::Isa::SSE2, BulkDecoder::Isa::AVX2
+};
+
+// Mixed formats, CRLF endings, blank lines and a few bad lines
+static std::string makeInput(int lines) {
+    std::string input;
+    for (int i = 1; i <= lines; ++i) {
+        std::string id = std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                input += "{\"orderId\": " + id + ", \"clientId\": 7, \"symbol\": \"AAPL\", \"type\": \"LIMIT\", "
+                         "\"side\": \"BUY\", \"price\": 150.25, \"quantity\": 100, \"stopPrice\": 0.0, \"displayQty\": 20}\n";
+                break;
+            case 1:
+                input += id + ",MSFT,limit,SELL,300.5,20,9,15,0\r\n";
+                break;
+            case 2:
+                input += id + "|GOOGL|MARKET|BUY|0|5\n\n";
+                break;
+            case 3:
+                input += "{\"orderId\":" + id + ",\"symbol\":\"TSLA\",\"type\":\"STOP_LIMIT\",\"side\":\"SELL\","
+                         "\"price\":209.99,\"quantity\":3,\"remainingQty\":2,\"stopPrice\":210,\"timeInForce\":\"IOC\"}\n";
+                break;
+        }
+    }
+    return input;
+}
+
+void test_matches_order_parser() {
+    std::string input = makeInput(4000);   // Spans several 64 KB blocks
+    OrderParser parser;
+    for (auto isa : ALL_ISAS) {
+        BulkDecoder decoder(isa);
+        OrderBatch batch;
+        assert(decoder.decode(input, batch) == input.size());
+        assert(batch.size() == 4000);
+        assert(batch.errors.empty());
+
+        size_t row = 0;
+        size_t pos = 0;
+        Order expected;
+        while (pos < input.size()) {
+            size_t end = input.find('\n', pos);
+            std::string_view line(input.data() + pos, end - pos);
+            pos = end + 1;
+            if (parser.parse(line, expected) != ParseError::OK) continue;
+            Order actual = batch.toOrder(row++);
+            assert(actual.orderId == expected.orderId);
+            assert(actual.clientId == expected.clientId);
+            assert(actual.symbol == expected.symbol);
+            assert(actual.type == expected.type);
+            assert(actual.side == expected.side);
+            assert(actual.price == expected.price);
+            assert(actual.quantity == expected.quantity);
+            assert(actual.remainingQty == expected.remainingQty);
+            assert(actual.stopPrice == expected.stopPrice);
+            assert(actual.timeInForce == expected.timeInForce);
+            assert(actual.displayQty == expected.displayQty);
+        }
+        assert(row == batch.size());
+    }
+    std::cout << "test_matches_order_parser passed\n";
+}
+
+void test_errors_report_offsets() {
+    const std::string input =
+        "1,AAPL,LIMIT,BUY,100,10\n"
+        "2,AAPL,LIMIT,HOLD,100,10\n"
+        "garbage\n"
+        "{\"orderId\":3,\"symbol\":\"AAPL\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"price\":1x,\"quantity\":1}\n"
+        "{\"orderId\":4,\"symbol\":\"AAPL\n"
+        "5|AAPL|LIMIT|SELL|101|0\n"
+        "7," + std::string(MAX_SYMBOL_LENGTH + 1, 'S') + ",LIMIT,SELL,101,7\n"
+        "6,AAPL,LIMIT,SELL,101,7";
+    for (auto isa : ALL_ISAS) {
+        BulkDecoder decoder(isa);
+        OrderBatch batch;
+        decoder.decode(input, batch);
+        assert(batch.size() == 2);
+        assert(batch.orderIds[0] == 1 && batch.orderIds[1] == 6);
+        assert(batch.errors.size() == 6);
+        assert(batch.errors[0].offset == input.find("2,AAPL"));
+        assert(batch.errors[0].error == ParseError::BAD_SIDE);
+        assert(batch.errors[1].error == ParseError::UNKNOWN_FORMAT);
+        assert(batch.errors[2].error == ParseError::BAD_NUMBER);
+        assert(batch.errors[3].error == ParseError::MISSING_FIELD);
+        assert(batch.errors[4].error == ParseError::INVALID_ORDER);
+        assert(batch.errors[5].error == ParseError::INVALID_ORDER);    // Symbol too long
+    }
+    std::cout << "test_errors_report_offsets passed\n";
+}
+
+void test_off_tick_rows_and_escaped_quotes() {
+    const std::string input =
+        "1,AAPL,LIMIT,BUY,100.005,10\n"
+        "2|AAPL|MARKET|SELL|100.005|10\n"
+        "3,AAPL,STOP,SELL,0,10,1,10,99.999\n"
+        "{\"orderId\":4,\"symbol\":\"AAPL\",\"type\":\"STOP_LIMIT\",\"side\":\"BUY\",\"price\":100.01,"
+        "\"quantity\":1,\"stopPrice\":100.0001}\n"
+        "{\"orderId\":5,\"symbol\":\"AB\\\\\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"price\":100,\"quantity\":1}\n"
+        "{\"orderId\":6,\"symbol\":\"A\\\"B\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"price\":100,\"quantity\":1}\n";
+    for (auto isa : ALL_ISAS) {
+        BulkDecoder decoder(isa);
+        OrderBatch batch;
+        decoder.decode(input, batch);
+        // Off-tick prices are refused as the Matcher refuses them, never rounded
+        assert(batch.errors.size() == 3);
+        assert(batch.errors[0].offset == 0 && batch.errors[0].error == ParseError::OFF_TICK);
+        assert(batch.errors[1].offset == input.find("3,AAPL"));
+        assert(batch.errors[1].error == ParseError::OFF_TICK);
+        assert(batch.errors[2].error == ParseError::OFF_TICK);
+        // The market order's price is unused; "AB\\" ends at its last quote and
+        // "A\"B" does not end at its escaped one
+        assert(batch.size() == 3);
+        assert(batch.orderIds[0] == 2 && batch.orderIds[1] == 5 && batch.orderIds[2] == 6);
+        assert(SymbolTable::instance().name(batch.symbolIds[1]) == "AB\\\\");
+        assert(SymbolTable::instance().name(batch.symbolIds[2]) == "A\\\"B");
+    }
+    std::cout << "test_off_tick_rows_and_escaped_quotes passed\n";
+}
+
+void test_chunked_decode() {
+    std::string input = makeInput(200);
+    BulkDecoder decoder;
+    OrderBatch batch;
+    std::string carry;
+    for (size_t pos = 0; pos < input.size(); pos += 777) {
+        carry += input.substr(pos, 777);
+        bool final = pos + 777 >= input.size();
+        size_t used = decoder.decode(carry, batch, final);
+        carry.erase(0, used);
+    }
+    assert(carry.empty());
+    assert(batch.size() == 200);
+    for (size_t i = 0; i < batch.size(); ++i) assert(batch.orderIds[i] == i + 1);
+
+    std::vector<CompactOrder> compact;
+    batch.toCompactOrders(compact);
+    assert(compact.size() == 200);
+    assert(compact[0].symbolId == SymbolTable::instance().find("MSFT"));
+    assert(compact[0].priceTicks == 30050);
+    std::cout << "test_chunked_decode passed (" << BulkDecoder::isaName(decoder.getIsa()) << ")\n";
+}
+
+int main() {
+    test_matches_order_parser();
+    test_errors_report_offsets();
+    test_off_tick_rows_and_escaped_quotes();
+    test_chunked_decode();
+    std::cout << "All bulk decoder tests passed!\n";
+    return 0;
+}
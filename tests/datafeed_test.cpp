@@ -0,0 +1,102 @@
+#include "../src/io/DataFeed.h"
+#include "../src/io/MappedFile.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+}
+
+void test_mapped_file() {
+    writeFile("datafeed_mapped.txt", "abc\ndef");
+    MappedFile file("datafeed_mapped.txt");
+    assert(file.isOpen());
+    assert(file.view() == "abc\ndef");
+
+    writeFile("datafeed_empty.txt", "");
+    MappedFile empty("datafeed_empty.txt");
+    assert(empty.isOpen() && empty.size() == 0);
+
+    bool threw = false;
+    try {
+        MappedFile missing("datafeed_missing.txt");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove("datafeed_mapped.txt");
+    std::remove("datafeed_empty.txt");
+    std::cout << "test_mapped_file passed\n";
+}
+
+void test_file_replay_lines() {
+    // CRLF endings, a blank line and no trailing newline
+    writeFile("datafeed_lines.txt", "first\r\nsecond\n\nthird");
+    std::vector<std::string> lines;
+    DataFeed feed;
+    assert(feed.connect("datafeed_lines.txt"));
+    feed.setLineHandler([&lines](std::string_view line) { lines.emplace_back(line); });
+    feed.start();
+    feed.wait();
+    assert((lines == std::vector<std::string>{"first", "second", "third"}));
+    assert(feed.getProcessedLines() == 4);
+    assert(!feed.isRunning());
+
+    // The copying handler still works when no line handler is set
+    DataFeed legacy;
+    std::vector<std::string> copies;
+    assert(legacy.connect("datafeed_lines.txt"));
+    legacy.setDataHandler([&copies](const std::string& line) { copies.push_back(line); });
+    legacy.start();
+    legacy.wait();
+    assert(copies == lines);
+    std::remove("datafeed_lines.txt");
+    std::cout << "test_file_replay_lines passed\n";
+}
+
+void test_timestamp_extraction() {
+    int64_t ns = 0;
+    assert(DataFeed::extractJsonTimestamp("{\"timestamp\": 1700000000}", ns));
+    assert(ns == 1700000000LL * 1000000000LL);
+    assert(DataFeed::extractJsonTimestamp("{\"timestamp\":1700000000123}", ns));
+    assert(ns == 1700000000123LL * 1000000LL);
+    assert(DataFeed::extractJsonTimestamp("{\"timestamp\":1700000000.5,\"x\":1}", ns));
+    assert(ns == 1700000000500000000LL);
+    assert(!DataFeed::extractJsonTimestamp("{\"orderId\":1}", ns));
+    std::cout << "test_timestamp_extraction passed\n";
+}
+
+void test_paced_replay() {
+    // 60 ms of recorded time replayed at double speed takes at least 30 ms
+    writeFile("datafeed_paced.json",
+              "{\"timestamp\":1700000000000}\n"
+              "{\"timestamp\":1700000000030}\n"
+              "{\"timestamp\":1700000000060}\n");
+    DataFeed feed;
+    int count = 0;
+    assert(feed.connect("datafeed_paced.json"));
+    feed.setLineHandler([&count](std::string_view) { count++; });
+    feed.setReplayMode(ReplayMode::TIMESTAMP_PACED, 2.0);
+    auto start = std::chrono::steady_clock::now();
+    feed.start();
+    feed.wait();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    assert(count == 3);
+    assert(elapsed >= std::chrono::milliseconds(30));
+    std::remove("datafeed_paced.json");
+    std::cout << "test_paced_replay passed\n";
+}
+
+int main() {
+    test_mapped_file();
+    test_file_replay_lines();
+    test_timestamp_extraction();
+    test_paced_replay();
+    std::cout << "All data feed tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "../src/io/Journal.h"
+#include "../src/engine/Matcher.h"
+#include "../src/engine/SymbolTable.h"
+#include "test_flow.h"
+#include <cassert>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <sys/resource.h>
+
+static const char* JOURNAL_PATH = "journal_test.jrnl";
+
+void test_recovery_reproduces_trades() {
+    std::remove(JOURNAL_PATH);
+    auto flow = makeFlow(20000, 7);
+    std::vector<std::vector<uint64_t>> live, recovered;
+    {
+        JournalConfig journalConfig;
+        journalConfig.preallocateBytes = 256 * 1024;     // Forces a few growth steps
+        JournalWriter journal(JOURNAL_PATH, journalConfig);
+        Logger logger("journal_test.log");
+        BookRegistry books;
+        recordTrades(books, live);
+        MatcherConfig config;
+        config.ingress = IngressMode::SPSC_RING;
+        config.maxBatch = 300;
+        config.journal = &journal;
+        Matcher matcher(books, logger, config);
+        matcher.start();
+        for (size_t i = 0; i < flow.size(); i += 97) {
+            matcher.submitBatch(flow.data() + i, std::min<size_t>(97, flow.size() - i));
+        }
+        matcher.stop();
+        assert(journal.getLastSequence() == flow.size());
+        assert(journal.getSyncCount() > 0);
+    }
+    assert(!live.empty());
+
+    // A fresh registry fed only from the journal trades exactly the same
+    BookRegistry books;
+    recordTrades(books, recovered);
+    JournalReader reader(JOURNAL_PATH);
+    assert(reader.replay(books) == flow.size());
+    assert(reader.getLastSequence() == flow.size());
+    assert(recovered == live);
+    std::cout << "test_recovery_reproduces_trades passed (" << live.size() << " trades)\n";
+}
+
+void test_torn_tail_and_resume() {
+    std::remove(JOURNAL_PATH);
+    auto flow = makeFlow(100, 7);
+    {
+        JournalWriter journal(JOURNAL_PATH);
+        journal.append(flow.data(), 60);
+        journal.append(flow.data() + 60, 40);
+    }
+    // Tear the last record as a crash mid-write would
+    size_t end;
+    {
+        JournalReader reader(JOURNAL_PATH);
+        reader.skipToEnd();
+        assert(reader.getLastSequence() == 100);
+        end = reader.getEndOffset();
+    }
+    {
+        std::fstream file(JOURNAL_PATH, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(end - 20));
+        file.write("torn", 4);
+    }
+    {
+        JournalReader reader(JOURNAL_PATH);
+        CompactOrder order;
+        uint64_t count = 0;
+        while (reader.next(order)) {
+            assert(order.orderId == flow[count].orderId);
+            count++;
+        }
+        assert(count == 99 && reader.getLastSequence() == 99);
+    }
+
+    // Reopening continues right after the last intact record
+    {
+        JournalWriter journal(JOURNAL_PATH);
+        assert(journal.getLastSequence() == 99);
+        assert(journal.append(flow.data() + 99, 1) == 100);
+    }
+    JournalReader reader(JOURNAL_PATH);
+    CompactOrder order;
+    uint64_t count = 0;
+    while (reader.next(order)) {
+        assert(order.orderId == flow[count].orderId && order.symbolId == flow[count].symbolId);
+        count++;
+    }
+    assert(count == 100);
+    std::cout << "test_torn_tail_and_resume passed\n";
+}
+
+void test_rejects_other_files() {
+    {
+        std::ofstream out(JOURNAL_PATH, std::ios::binary | std::ios::trunc);
+        out << "not a journal at all";
+    }
+    bool threw = false;
+    try {
+        JournalReader reader(JOURNAL_PATH);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove(JOURNAL_PATH);
+    std::cout << "test_rejects_other_files passed\n";
+}
+
+// A symbol the journal could not record is refused where it enters, so the
+// worker never meets it
+void test_long_symbol_refused_at_submit() {
+    std::remove(JOURNAL_PATH);
+    std::string longSymbol(MAX_SYMBOL_LENGTH + 1, 'X');
+    JournalWriter journal(JOURNAL_PATH);
+    Logger logger("journal_test.log");
+    BookRegistry books;
+    MatcherConfig config;
+    config.journal = &journal;
+    Matcher matcher(books, logger, config);
+    matcher.start();
+    assert(!matcher.submitOrder(Order(1, 1, longSymbol, OrderType::LIMIT, OrderSide::BUY, 100.0, 1)));
+    assert(matcher.submitOrder(Order(2, 1, std::string(MAX_SYMBOL_LENGTH, 'Y'), OrderType::LIMIT,
+                                     OrderSide::BUY, 100.0, 1)));
+    matcher.stop();
+    assert(matcher.getRefusedOrders() == 1 && matcher.getProcessedOrders() == 1);
+    assert(!matcher.isHalted() && journal.getLastSequence() == 1);
+
+    bool threw = false;
+    try {
+        SymbolTable::instance().intern(longSymbol);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw && SymbolTable::instance().find(longSymbol) == 0);
+    std::remove(JOURNAL_PATH);
+    std::cout << "test_long_symbol_refused_at_submit passed\n";
+}
+
+// Past the file size limit the journal cannot grow: the matcher halts
+// instead of applying orders it could not record
+void test_append_failure_halts_matcher() {
+    std::remove(JOURNAL_PATH);
+    auto flow = makeFlow(2000, 7);
+    rlimit original{};
+    getrlimit(RLIMIT_FSIZE, &original);
+    std::signal(SIGXFSZ, SIG_IGN);
+    uint64_t processed = 0;
+    {
+        JournalConfig journalConfig;
+        journalConfig.preallocateBytes = 16 * 1024;
+        journalConfig.sync = false;
+        JournalWriter journal(JOURNAL_PATH, journalConfig);
+        rlimit capped = original;
+        capped.rlim_cur = 64 * 1024;
+        setrlimit(RLIMIT_FSIZE, &capped);
+
+        Logger logger("journal_test.log");
+        BookRegistry books;
+        MatcherConfig config;
+        config.ingress = IngressMode::SPSC_RING;
+        config.maxBatch = 100;
+        config.journal = &journal;
+        Matcher matcher(books, logger, config);
+        matcher.start();
+        for (size_t i = 0; i < flow.size(); i += 100) matcher.submitBatch(flow.data() + i, 100);
+        matcher.stop();
+        setrlimit(RLIMIT_FSIZE, &original);
+
+        assert(matcher.isHalted());
+        assert(matcher.getHaltReason().find("journal") != std::string::npos);
+        processed = matcher.getProcessedOrders();
+        assert(processed > 0 && processed < flow.size());
+        assert(processed + matcher.getDroppedOrders() == flow.size());
+        // Nothing was applied that the journal does not hold
+        assert(journal.getLastSequence() == processed);
+    }
+    std::signal(SIGXFSZ, SIG_DFL);
+    BookRegistry books;
+    assert(JournalReader(JOURNAL_PATH).replay(books) == processed);
+    std::remove(JOURNAL_PATH);
+    std::cout << "test_append_failure_halts_matcher passed (" << processed << " journaled)\n";
+}
+
+int main() {
+    test_recovery_reproduces_trades();
+    test_torn_tail_and_resume();
+    test_rejects_other_files();
+    test_long_symbol_refused_at_submit();
+    test_append_failure_halts_matcher();
+    std::remove("journal_test.log");
+    std::cout << "All journal tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "../src/engine/LatencyHistogram.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+void test_bucket_bounds() {
+    // Exact below 128, then every value lands in a bucket no wider than 1/64 of it
+    for (uint64_t v = 0; v < 128; ++v) {
+        assert(LatencyHistogram::bucketOf(v) == v && LatencyHistogram::bucketLimit(v) == v);
+    }
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t v = rng() >> (24 + rng() % 40);
+        size_t bucket = LatencyHistogram::bucketOf(v);
+        uint64_t limit = LatencyHistogram::bucketLimit(bucket);
+        assert(limit >= v);
+        assert(limit - v <= v / 64);
+        assert(bucket == 0 || LatencyHistogram::bucketLimit(bucket - 1) < v);
+    }
+    // Past the top everything shares the last bucket
+    assert(LatencyHistogram::bucketOf(~0ULL) == LatencySnapshot::BUCKET_COUNT - 1);
+    std::cout << "test_bucket_bounds passed\n";
+}
+
+void test_percentiles() {
+    LatencyHistogram histogram;
+    assert(histogram.snapshot().count == 0 && histogram.snapshot().percentile(0.99) == 0);
+
+    std::mt19937_64 rng(5);
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 50000; ++i) {
+        uint64_t v = 100 + rng() % 2000000;
+        values.push_back(v);
+        histogram.record(v);
+    }
+    std::sort(values.begin(), values.end());
+    LatencySnapshot snapshot = histogram.snapshot();
+    assert(snapshot.count == values.size() && snapshot.max == values.back());
+    for (double p : {0.5, 0.9, 0.99, 0.999}) {
+        uint64_t exact = values[static_cast<size_t>(p * values.size()) - 1];
+        uint64_t reported = snapshot.percentile(p);
+        assert(reported >= exact && reported - exact <= exact / 64);
+    }
+    assert(snapshot.percentile(1.0) == values.back());
+    std::cout << "test_percentiles passed (" << snapshot.summary() << ")\n";
+}
+
+void test_merge_per_thread_histograms() {
+    // One histogram per recording thread, merged by a reader that never
+    // stops them
+    constexpr int THREADS = 3;
+    constexpr uint64_t PER_THREAD = 200000;
+    std::vector<LatencyHistogram> histograms(THREADS);
+    std::atomic<int> done{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < THREADS; ++t) {
+        writers.emplace_back([&, t] {
+            for (uint64_t i = 0; i < PER_THREAD; ++i) histograms[t].record((t + 1) * 1000);
+            done++;
+        });
+    }
+    uint64_t lastCount = 0;
+    while (done.load() < THREADS) {
+        LatencySnapshot merged;
+        for (const auto& h : histograms) merged.merge(h.snapshot());
+        assert(merged.count >= lastCount && merged.count <= THREADS * PER_THREAD);
+        lastCount = merged.count;
+    }
+    for (auto& writer : writers) writer.join();
+
+    LatencySnapshot merged;
+    for (const auto& h : histograms) merged.merge(h.snapshot());
+    assert(merged.count == THREADS * PER_THREAD);
+    assert(merged.max == THREADS * 1000);
+    assert(merged.percentile(0.3) <= 1000 + 1000 / 64);
+    assert(merged.percentile(0.5) >= 2000 && merged.percentile(0.5) <= 2000 + 2000 / 64);
+    std::cout << "test_merge_per_thread_histograms passed\n";
+}
+
+int main() {
+    test_bucket_bounds();
+    test_percentiles();
+    test_merge_per_thread_histograms();
+    std::cout << "All latency tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,248 @@
+#include "../src/io/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::vector<std::string> readLines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) lines.push_back(line);
+    return lines;
+}
+
+// Strips the "[timestamp] " prefix
+static std::string body(const std::string& line) {
+    size_t pos = line.find("] ");
+    return pos == std::string::npos ? line : line.substr(pos + 2);
+}
+
+void test_async_text_matches_sync() {
+    std::remove("logger_sync.log");
+    std::remove("logger_async.log");
+    const std::string longMessage(130, 'x');
+    {
+        Logger sync("logger_sync.log");
+        Logger async("logger_async.log", LogMode::ASYNC_TEXT);
+        for (Logger* logger : {&sync, &async}) {
+            logger->logTrade(1, 2, 100.5, 10);
+            logger->logOrderBatch(3, 7, 9);
+            logger->log(longMessage);
+            logger->logBatch({"first", "second"});
+        }
+    }
+    auto syncLines = readLines("logger_sync.log");
+    auto asyncLines = readLines("logger_async.log");
+    assert(syncLines.size() == asyncLines.size());
+    // Line 0 is the "Logger initialized - <file>" banner
+    for (size_t i = 1; i < syncLines.size(); ++i) {
+        assert(body(syncLines[i]) == body(asyncLines[i]));
+    }
+    assert(body(asyncLines[1]) == "TRADE: buy=1,sell=2,price=100.500000,qty=10");
+    assert(body(asyncLines[2]) == "Orders processed: count=3, first=7, last=9");
+    assert(body(asyncLines[3]) == longMessage);
+    std::remove("logger_sync.log");
+    std::remove("logger_async.log");
+    std::cout << "test_async_text_matches_sync passed\n";
+}
+
+void test_binary_log_decodes() {
+    std::remove("logger_binary.bin");
+    const int threads = 4;
+    const int perThread = 500;
+    {
+        Logger logger("logger_binary.bin", LogMode::ASYNC_BINARY);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&logger, t] {
+                for (int i = 0; i < perThread; ++i) {
+                    logger.logTrade(t * perThread + i, 0, 99.0, 1);
+                }
+            });
+        }
+        for (auto& producer : producers) producer.join();
+        assert(logger.getDroppedRecords() == 0);
+    }
+
+    std::ifstream in("logger_binary.bin", std::ios::binary);
+    LogFileHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    assert(std::string(header.magic, 8) == "OBMELOG1");
+    assert(header.recordSize == sizeof(LogRecord));
+
+    LogRecordFormatter formatter;
+    LogRecord record;
+    std::string text;
+    int trades = 0;
+    std::vector<bool> seen(threads * perThread, false);
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        if (record.event == LogEvent::TRADE) {
+            assert(!seen[record.args[0]]);
+            seen[record.args[0]] = true;
+            trades++;
+        }
+        formatter.append(text, record);
+    }
+    assert(trades == threads * perThread);
+    // Two messages from the logger itself plus every trade
+    assert(std::count(text.begin(), text.end(), '\n') == trades + 2);
+    assert(text.find("Logger shutting down") != std::string::npos);
+    std::remove("logger_binary.bin");
+    std::cout << "test_binary_log_decodes passed\n";
+}
+
+// Multi-chunk messages from several threads must come back whole, in both
+// the text writer and the binary decoder
+void test_multi_producer_messages() {
+    const int threads = 4;
+    const int perThread = 200;
+    for (LogMode mode : {LogMode::ASYNC_TEXT, LogMode::ASYNC_BINARY}) {
+        std::remove("logger_multi.log");
+        {
+            Logger logger("logger_multi.log", mode);
+            std::vector<std::thread> producers;
+            for (int t = 0; t < threads; ++t) {
+                producers.emplace_back([&logger, t] {
+                    const std::string message(200, static_cast<char>('A' + t));
+                    for (int i = 0; i < perThread; ++i) logger.log(message);
+                });
+            }
+            for (auto& producer : producers) producer.join();
+            assert(logger.getDroppedRecords() == 0);
+        }
+
+        std::vector<std::string> lines;
+        if (mode == LogMode::ASYNC_TEXT) {
+            lines = readLines("logger_multi.log");
+        } else {
+            std::ifstream in("logger_multi.log", std::ios::binary);
+            LogFileHeader header{};
+            in.read(reinterpret_cast<char*>(&header), sizeof(header));
+            LogRecordFormatter formatter;
+            LogRecord record;
+            std::string text;
+            while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+                formatter.append(text, record);
+            }
+            size_t start = 0, end;
+            while ((end = text.find('\n', start)) != std::string::npos) {
+                lines.push_back(text.substr(start, end - start));
+                start = end + 1;
+            }
+        }
+        std::vector<int> counts(threads, 0);
+        for (const auto& line : lines) {
+            std::string text = body(line);
+            if (text.size() != 200) continue;
+            int t = text[0] - 'A';
+            assert(t >= 0 && t < threads);
+            assert(text == std::string(200, text[0]));
+            counts[t]++;
+        }
+        for (int count : counts) assert(count == perThread);
+    }
+    std::remove("logger_multi.log");
+    std::cout << "test_multi_producer_messages passed\n";
+}
+
+// Counts the distinct "thread N" lines a writer produced
+static size_t threadLines(const std::string& path) {
+    std::set<std::string> seen;
+    for (const auto& line : readLines(path)) {
+        std::string text = body(line);
+        if (text.rfind("thread ", 0) == 0) seen.insert(text);
+    }
+    return seen.size();
+}
+
+// More threads than MAX_PRODUCERS, first one after another, then all alive
+// at once: exited threads hand their rings back, and threads beyond the cap
+// share the overflow ring, so nothing is dropped either way
+void test_many_threads() {
+    const int threads = static_cast<int>(AsyncLogWriter::MAX_PRODUCERS) + 44;
+    AsyncLogConfig config;
+    config.bufferRecords = 64;
+
+    std::remove("logger_threads.log");
+    {
+        std::ofstream file("logger_threads.log");
+        AsyncLogWriter writer(file, LogMode::ASYNC_TEXT, config);
+        for (int t = 0; t < threads; ++t) {
+            std::thread([&writer, t] { writer.enqueueMessage("thread " + std::to_string(t)); }).join();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        assert(writer.getProducerCount() < AsyncLogWriter::MAX_PRODUCERS);
+        assert(writer.getDroppedRecords() == 0);
+        writer.shutdown();
+    }
+    assert(threadLines("logger_threads.log") == static_cast<size_t>(threads));
+
+    std::remove("logger_threads.log");
+    {
+        std::ofstream file("logger_threads.log");
+        AsyncLogWriter writer(file, LogMode::ASYNC_TEXT, config);
+        std::atomic<int> logged{0};
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&writer, &logged, t] {
+                assert(writer.enqueueMessage("thread " + std::to_string(t)));
+                logged.fetch_add(1);
+                while (logged.load() < threads) std::this_thread::yield();
+            });
+        }
+        for (auto& producer : producers) producer.join();
+        assert(writer.getProducerCount() == AsyncLogWriter::MAX_PRODUCERS);
+        assert(writer.getDroppedRecords() == 0);
+        writer.shutdown();
+    }
+    assert(threadLines("logger_threads.log") == static_cast<size_t>(threads));
+    std::remove("logger_threads.log");
+    std::cout << "test_many_threads passed\n";
+}
+
+void test_full_buffer_drops() {
+    std::remove("logger_drop.log");
+    AsyncLogConfig config;
+    config.bufferRecords = 16;
+    config.flushInterval = std::chrono::milliseconds(1000);
+    {
+        Logger logger("logger_drop.log", LogMode::ASYNC_TEXT, config);
+        for (int i = 0; i < 100000; ++i) logger.logOrderBatch(1, i, i);
+        // Never blocks; whatever did not fit is counted instead
+        assert(logger.getDroppedRecords() > 0);
+    }
+    std::remove("logger_drop.log");
+
+    // A message that cannot fit whole is dropped whole, never truncated
+    std::remove("logger_drop.log");
+    {
+        Logger logger("logger_drop.log", LogMode::ASYNC_TEXT, config);
+        uint64_t before = logger.getDroppedRecords();
+        logger.log(std::string(LOG_TEXT_CAPACITY * 20, 'y'));
+        assert(logger.getDroppedRecords() == before + 20);
+        logger.log("after");
+    }
+    auto lines = readLines("logger_drop.log");
+    for (const auto& line : lines) assert(body(line)[0] != 'y');
+    assert(body(lines[1]) == "after");
+    std::remove("logger_drop.log");
+    std::cout << "test_full_buffer_drops passed\n";
+}
+
+int main() {
+    test_async_text_matches_sync();
+    test_binary_log_decodes();
+    test_multi_producer_messages();
+    test_many_threads();
+    test_full_buffer_drops();
+    std::cout << "All logger tests passed!\n";
+    return 0;
+}
@@ -1,13 +1,349 @@
-#include "../src/engine/Matcher.h"
-#include <cassert>
-#include <iostream>
-
-void test_match() {
-    // TODO: Add test logic
-    std::cout << "test_match passed\n";
-}
-
-int main() {
-    test_match();
-    return 0;
-}
+#include "../src/engine/Matcher.h"
+#include "../src/engine/ShardedMatcher.h"
+#include "../src/engine/SymbolTable.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+static Order makeOrder(uint64_t id, OrderSide side, double price, uint32_t qty) {
+    return Order(id, 100, "AAPL", OrderType::LIMIT, side, price, qty);
+}
+
+void test_match() {
+    Logger logger("matcher_test.log");
+    OrderBook book;
+    Matcher matcher(book, logger);
+    matcher.start();
+    matcher.submitOrder(makeOrder(1, OrderSide::BUY, 100.0, 10));
+    matcher.submitOrder(makeOrder(2, OrderSide::SELL, 100.0, 10));
+    matcher.stop();
+
+    assert(matcher.getProcessedOrders() == 2);
+    assert(book.getTotalTrades() == 1);
+    std::cout << "test_match passed\n";
+}
+
+void test_ring_buffers() {
+    const uint64_t count = 50000;
+
+    // SPSC preserves order end to end
+    SpscRingBuffer<uint64_t> spsc(1024);
+    std::thread producer([&]{
+        for (uint64_t i = 1; i <= count; ++i) {
+            while (!spsc.tryPush(i)) std::this_thread::yield();
+        }
+    });
+    uint64_t expected = 1, value;
+    while (expected <= count) {
+        if (spsc.tryPop(value)) {
+            assert(value == expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(spsc.empty());
+
+    // MPSC keeps each producer's own sequence ordered
+    const int producers = 4;
+    MpscRingBuffer<uint64_t> mpsc(256);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]{
+            for (uint64_t i = 1; i <= count; ++i) {
+                while (!mpsc.tryPush((static_cast<uint64_t>(p) << 32) | i)) std::this_thread::yield();
+            }
+        });
+    }
+    std::vector<uint64_t> last(producers, 0);
+    uint64_t received = 0;
+    while (received < count * producers) {
+        if (mpsc.tryPop(value)) {
+            uint64_t p = value >> 32, seq = value & 0xffffffff;
+            assert(seq == last[p] + 1);
+            last[p] = seq;
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : threads) t.join();
+    assert(mpsc.empty());
+
+    std::cout << "test_ring_buffers passed\n";
+}
+
+void test_ring_backpressure() {
+    Logger logger("matcher_test.log");
+    OrderBook book;
+    MatcherConfig config;
+    config.ingress = IngressMode::MPSC_RING;
+    config.ringCapacity = 4;
+    Matcher matcher(book, logger, config);
+
+    // Nothing drains the ring until start(), so the fifth submit is refused
+    for (uint64_t id = 1; id <= 4; ++id) {
+        assert(matcher.trySubmitOrder(makeOrder(id, OrderSide::BUY, 99.0, 1)));
+    }
+    assert(!matcher.trySubmitOrder(makeOrder(5, OrderSide::BUY, 99.0, 1)));
+    assert(matcher.getRejectedSubmits() == 1);
+
+    matcher.start();
+    matcher.stop();
+    assert(matcher.getProcessedOrders() == 4);
+    std::cout << "test_ring_backpressure passed\n";
+}
+
+void test_ring_ingress_modes() {
+    const IngressMode modes[] = {IngressMode::SPSC_RING, IngressMode::MPSC_RING};
+    const WaitStrategy waits[] = {WaitStrategy::BUSY_SPIN, WaitStrategy::YIELD, WaitStrategy::BLOCK};
+    const uint64_t perProducer = 2000;
+
+    for (IngressMode mode : modes) {
+        for (WaitStrategy wait : waits) {
+            Logger logger("matcher_test.log");
+            OrderBook book;
+            MatcherConfig config;
+            config.ingress = mode;
+            config.wait = wait;
+            config.ringCapacity = 256;
+            Matcher matcher(book, logger, config);
+            matcher.start();
+
+            int producers = mode == IngressMode::SPSC_RING ? 1 : 4;
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p]{
+                    for (uint64_t i = 0; i < perProducer; ++i) {
+                        uint64_t id = p * perProducer + i + 1;
+                        OrderSide side = id % 2 ? OrderSide::BUY : OrderSide::SELL;
+                        matcher.submitOrder(makeOrder(id, side, 100.0, 1));
+                    }
+                });
+            }
+            for (auto& t : threads) t.join();
+            matcher.stop();
+
+            assert(matcher.getProcessedOrders() == producers * perProducer);
+            assert(book.getTotalTrades() > 0);
+        }
+    }
+    std::cout << "test_ring_ingress_modes passed\n";
+}
+
+void test_batch_submit_and_drain() {
+    const IngressMode modes[] = {IngressMode::LOCKED_QUEUE, IngressMode::SPSC_RING, IngressMode::MPSC_RING};
+
+    for (IngressMode mode : modes) {
+        Logger logger("matcher_test.log");
+        OrderBook book;
+        size_t batchedTrades = 0, callbacks = 0;
+        book.setTradeBatchCallback([&](const std::vector<Trade>& trades) {
+            assert(!trades.empty());
+            batchedTrades += trades.size();
+            callbacks++;
+        });
+        MatcherConfig config;
+        config.ingress = mode;
+        config.ringCapacity = 128;
+        config.maxBatch = 64;
+        Matcher matcher(book, logger, config);
+
+        // Queue everything before starting so the worker drains full batches
+        std::vector<Order> orders;
+        for (uint64_t id = 1; id <= 100; ++id) {
+            orders.push_back(makeOrder(id, id % 2 ? OrderSide::BUY : OrderSide::SELL, 100.0, 1));
+        }
+        matcher.submitBatch(orders);
+        matcher.start();
+        matcher.stop();
+
+        assert(matcher.getProcessedOrders() == 100);
+        assert(book.getTotalTrades() == 50);
+        assert(batchedTrades == 50);
+        assert(callbacks <= 2); // one per drained batch that traded
+        // Every order is timed from submit to dequeue, and through the book
+        assert(matcher.getQueueWait().count == 100);
+        BookLatencyStats stats = book.getLatencyStats();
+        assert(stats.service.count == 100 && stats.cancel.count == 0);
+        assert(stats.matchDepth.count == 100 && stats.matchDepth.max == 1);
+    }
+    std::cout << "test_batch_submit_and_drain passed\n";
+}
+
+void test_sharded_matcher_routes_by_symbol() {
+    Logger logger("matcher_test.log");
+    BookRegistry books;
+    ShardedMatcher matcher(books, logger, 3);
+    const std::vector<std::string> symbols = {"AAPL", "GOOGL", "MSFT", "TSLA", "AMZN"};
+
+    // Each symbol gets a resting bid; the opposite symbol's ask must not hit it
+    uint64_t id = 1;
+    std::vector<Order> orders;
+    for (const auto& symbol : symbols) {
+        orders.push_back(Order(id++, 1, symbol, OrderType::LIMIT, OrderSide::BUY, 100.0, 10));
+    }
+    orders.push_back(Order(id++, 2, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 4));
+    orders.push_back(Order(id++, 2, "MSFT", OrderType::LIMIT, OrderSide::SELL, 101.0, 4));
+    matcher.start();
+    matcher.submitBatch(orders);
+    matcher.submitOrder(Order(id++, 2, "TSLA", OrderType::LIMIT, OrderSide::SELL, 99.0, 10));
+    matcher.stop();
+
+    assert(matcher.getProcessedOrders() == orders.size() + 1);
+    assert(matcher.getQueueWait().count == orders.size() + 1);
+    uint64_t perShard = 0;
+    for (size_t shard = 0; shard < matcher.getShardCount(); ++shard) {
+        perShard += matcher.getQueueWait(shard).count;
+    }
+    assert(perShard == orders.size() + 1);
+    assert(books.size() == symbols.size());
+    assert(books.findBook("AAPL")->getTotalTrades() == 1);
+    assert(books.findBook("MSFT")->getTotalTrades() == 0);
+    assert(books.findBook("MSFT")->getBestAsk() == 101.0);
+    assert(books.findBook("TSLA")->getTotalTrades() == 1);
+    assert(books.findBook("TSLA")->getBestBid() == 0.0);
+    assert(books.findBook("GOOGL")->getBestBid() == 100.0);
+    assert(books.getTotalTrades() == 2);
+
+    // A symbol always lands on the same shard
+    uint32_t aapl = SymbolTable::instance().find("AAPL");
+    assert(matcher.shardFor(aapl) == matcher.shardFor(aapl));
+    assert(matcher.shardFor(aapl) < matcher.getShardCount());
+
+    std::cout << "test_sharded_matcher_routes_by_symbol passed\n";
+}
+
+void test_cancel_and_modify_through_ingress() {
+    Logger logger("matcher_test.log");
+    for (IngressMode ingress : {IngressMode::LOCKED_QUEUE, IngressMode::SPSC_RING}) {
+        OrderBook book;
+        MatcherConfig config;
+        config.ingress = ingress;
+        Matcher matcher(book, logger, config);
+        std::vector<uint64_t> fills;
+        book.setTradeCallback([&](const Order& buy, const Order&, double, uint32_t) {
+            fills.push_back(buy.orderId);
+        });
+        uint32_t aapl = SymbolTable::instance().intern("AAPL");
+
+        // Applied in submission order, interleaved with new orders
+        std::vector<CompactOrder> orders;
+        for (uint64_t id = 1; id <= 4; ++id) {
+            orders.push_back(CompactOrder::fromOrder(makeOrder(id, OrderSide::BUY, 100.0, 10)));
+        }
+        orders.push_back(CompactOrder::makeCancel(2, aapl));
+        orders.push_back(CompactOrder::makeModify(1, aapl, 10000, 20));   // grows: back of queue
+        orders.push_back(CompactOrder::makeModify(3, aapl, 10000, 5));    // shrinks: keeps place
+        orders.push_back(CompactOrder::makeCancel(77, aapl));             // unknown id, ignored
+        matcher.start();
+        matcher.submitBatch(orders.data(), orders.size());
+        matcher.submitOrder(makeOrder(10, OrderSide::SELL, 100.0, 35));
+        matcher.stop();
+
+        assert(matcher.getProcessedOrders() == orders.size() + 1);
+        assert((fills == std::vector<uint64_t>{3, 4, 1}));
+        assert(book.getBestBid() == 0.0 && book.getBestAsk() == 0.0);
+        assert(book.getPoolStats().inUse == 0);
+        BookLatencyStats stats = book.getLatencyStats();
+        assert(stats.cancel.count == 2 && stats.service.count == orders.size() - 1);
+    }
+    std::cout << "test_cancel_and_modify_through_ingress passed\n";
+}
+
+void test_off_tick_prices_never_trade_through() {
+    Logger logger("matcher_test.log");
+    OrderBook book;
+    std::vector<std::pair<uint64_t, double>> buys;
+    book.setTradeCallback([&](const Order& buy, const Order&, double price, uint32_t) {
+        buys.emplace_back(buy.orderId, price);
+    });
+    Matcher matcher(book, logger);
+    matcher.start();
+    assert(matcher.submitOrder(makeOrder(1, OrderSide::SELL, 100.01, 5)));
+    // The baseline book would rest this bid below the ask; rounding it to
+    // the nearest tick would have crossed it
+    assert(!matcher.submitOrder(makeOrder(2, OrderSide::BUY, 100.006, 5)));
+    assert(!matcher.trySubmitOrder(makeOrder(3, OrderSide::BUY, 100.009, 5)));
+    assert(matcher.submitBatch({makeOrder(4, OrderSide::BUY, 100.0099, 5),
+                                makeOrder(5, OrderSide::BUY, 100.0, 5)}) == 1);
+    matcher.stop();
+    assert(matcher.getProcessedOrders() == 2 && matcher.getRefusedOrders() == 3);
+    assert(buys.empty() && book.getBestBid() == 100.0);
+
+    // Converted without the check, a buy rounds down and still never fills
+    // above its limit
+    for (int i = 1; i < 10; ++i) {
+        double limit = 100.0 + i * 0.001;
+        OrderBook rounded;
+        std::vector<double> prices;
+        rounded.setTradeCallback([&](const Order&, const Order&, double price, uint32_t) {
+            prices.push_back(price);
+        });
+        rounded.addOrder(CompactOrder::fromOrder(makeOrder(10, OrderSide::SELL, 100.0, 1)));
+        rounded.addOrder(CompactOrder::fromOrder(makeOrder(11, OrderSide::SELL, 100.01, 1)));
+        rounded.addOrder(CompactOrder::fromOrder(makeOrder(12, OrderSide::BUY, limit, 2)));
+        assert(prices.size() == 1 && prices[0] <= limit);
+    }
+    std::cout << "test_off_tick_prices_never_trade_through passed\n";
+}
+
+void test_worker_setup() {
+    // Single book: reserved by the worker before start() returns
+    {
+        Logger logger("matcher_test.log");
+        OrderBook book;
+        MatcherConfig config;
+        config.ingress = IngressMode::SPSC_RING;
+        config.wait = WaitStrategy::BUSY_SPIN;
+        config.cpu = 0;
+        config.reserveOrders = 3 * OrderPool::DEFAULT_CAPACITY;
+        Matcher matcher(book, logger, config);
+        matcher.start();
+        OrderPool::Stats reserved = book.getPoolStats();
+        // A fresh worker-built slab on top of the constructor's, not a top-up
+        assert(reserved.capacity == OrderPool::DEFAULT_CAPACITY + config.reserveOrders);
+        assert(reserved.slabs == 2);
+        for (uint64_t id = 1; id <= config.reserveOrders; ++id) {
+            matcher.submitOrder(makeOrder(id, OrderSide::BUY, 50.0 + id * 0.01, 1));
+        }
+        matcher.stop();
+        assert(matcher.getProcessedOrders() == config.reserveOrders);
+        assert(book.getPoolStats().inUse == config.reserveOrders);
+        assert(book.getPoolStats().slabs == 2);     // Never grew while matching
+    }
+    // Registry: each book as the worker first routes to it; real-time
+    // priority and memory locking are best effort and only logged on failure
+    {
+        Logger logger("matcher_test.log");
+        BookRegistry books;
+        MatcherConfig config;
+        config.wait = WaitStrategy::BLOCK;
+        config.realtimePriority = 1;
+        config.lockMemory = true;
+        config.reserveOrders = 10000;
+        Matcher matcher(books, logger, config);
+        matcher.start();
+        matcher.submitOrder(Order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 1));
+        matcher.submitOrder(Order(2, 100, "MSFT", OrderType::LIMIT, OrderSide::SELL, 200.0, 1));
+        matcher.stop();
+        assert(matcher.getProcessedOrders() == 2);
+        assert(books.getBook("AAPL").getPoolStats().capacity >= 10000);
+        assert(books.getBook("MSFT").getPoolStats().capacity >= 10000);
+    }
+    std::cout << "test_worker_setup passed\n";
+}
+
+int main() {
+    test_match();
+    test_ring_buffers();
+    test_ring_backpressure();
+    test_ring_ingress_modes();
+    test_batch_submit_and_drain();
+    test_sharded_matcher_routes_by_symbol();
+    test_cancel_and_modify_through_ingress();
+    test_off_tick_prices_never_trade_through();
+    test_worker_setup();
+    return 0;
+}
@@ -1,205 +1,892 @@
-#include "../src/engine/OrderBook.h"
-#include <cassert>
-#include <iostream>
-#include "../src/models/OrderType.h"
-#include "../src/models/OrderSide.h"
-
-void test_add_order() {
-    OrderBook book;
-    
-    // Test Order constructor
-    Order order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 150.0, 100);
-    auto orderPtr = std::make_shared<Order>(order);
-    
-    // Test order validation
-    assert(order.isValid());
-    assert(!order.isPartiallyFilled());
-    assert(!order.isFullyFilled());
-    
-    // Test order properties
-    assert(order.orderId == 1);
-    assert(order.clientId == 100);
-    assert(order.symbol == "AAPL");
-    assert(order.type == OrderType::LIMIT);
-    assert(order.side == OrderSide::BUY);
-    assert(order.price == 150.0);
-    assert(order.quantity == 100);
-    assert(order.remainingQty == 100);
-    
-    // Test adding to order book
-    book.addOrder(orderPtr);
-    
-    // Test partial fill
-    order.updateRemainingQty(30);
-    assert(order.isPartiallyFilled());
-    assert(!order.isFullyFilled());
-    assert(order.getFilledQty() == 30);
-    assert(order.remainingQty == 70);
-    
-    // Test full fill
-    order.updateRemainingQty(70);
-    assert(!order.isPartiallyFilled());
-    assert(order.isFullyFilled());
-    assert(order.getFilledQty() == 100);
-    assert(order.remainingQty == 0);
-    
-    std::cout << "test_add_order passed\n";
-}
-
-void test_basic_limit_match() {
-    OrderBook book;
-    bool tradeHappened = false;
-    book.setTradeCallback([&](const Order& buy, const Order& sell, double price, uint32_t qty) {
-        tradeHappened = true;
-        assert(buy.side == OrderSide::BUY);
-        assert(sell.side == OrderSide::SELL);
-        assert(price == 100.0);
-        assert(qty == 10);
-    });
-    auto buy = std::make_shared<Order>();
-    buy->orderId = 1;
-    buy->symbol = "AAPL";
-    buy->type = OrderType::LIMIT;
-    buy->side = OrderSide::BUY;
-    buy->price = 100.0;
-    buy->quantity = 10;
-    buy->remainingQty = 10;
-    buy->timestamp = std::chrono::system_clock::now();
-    book.addOrder(buy);
-    auto sell = std::make_shared<Order>();
-    sell->orderId = 2;
-    sell->symbol = "AAPL";
-    sell->type = OrderType::LIMIT;
-    sell->side = OrderSide::SELL;
-    sell->price = 100.0;
-    sell->quantity = 10;
-    sell->remainingQty = 10;
-    sell->timestamp = std::chrono::system_clock::now();
-    book.addOrder(sell);
-    assert(tradeHappened);
-    std::cout << "test_basic_limit_match passed\n";
-}
-
-void test_order_constructors() {
-    // Test default constructor
-    Order defaultOrder;
-    assert(defaultOrder.orderId == 0);
-    assert(defaultOrder.quantity == 0);
-    assert(defaultOrder.remainingQty == 0);
-    assert(!defaultOrder.isValid()); // Should be invalid with zero values
-    
-    // Test parameterized constructor
-    Order order(123, 456, "MSFT", OrderType::MARKET, OrderSide::SELL, 250.75, 50);
-    assert(order.orderId == 123);
-    assert(order.clientId == 456);
-    assert(order.symbol == "MSFT");
-    assert(order.type == OrderType::MARKET);
-    assert(order.side == OrderSide::SELL);
-    assert(order.price == 250.75);
-    assert(order.quantity == 50);
-    assert(order.remainingQty == 50);
-    assert(order.isValid());
-    
-    // Test copy constructor
-    Order copied(order);
-    assert(copied.orderId == order.orderId);
-    assert(copied.symbol == order.symbol);
-    assert(copied.type == order.type);
-    assert(copied == order); // Test equality operator
-    
-    std::cout << "test_order_constructors passed\n";
-}
-
-void test_order_matching() {
-    // Create buy and sell orders that can match
-    Order buyOrder(1, 100, "GOOGL", OrderType::LIMIT, OrderSide::BUY, 2500.0, 10);
-    Order sellOrder(2, 200, "GOOGL", OrderType::LIMIT, OrderSide::SELL, 2500.0, 15);
-    
-    // Test matching capability
-    assert(buyOrder.canMatchWith(sellOrder));
-    assert(sellOrder.canMatchWith(buyOrder));
-    
-    // Test execution price
-    double execPrice = buyOrder.getExecutionPrice(sellOrder);
-    assert(execPrice == 2500.0);
-    
-    // Test orders with different symbols shouldn't match
-    Order differentSymbol(3, 300, "TSLA", OrderType::LIMIT, OrderSide::SELL, 800.0, 5);
-    assert(!buyOrder.canMatchWith(differentSymbol));
-    
-    // Test same side orders shouldn't match
-    Order sameSide(4, 400, "GOOGL", OrderType::LIMIT, OrderSide::BUY, 2450.0, 20);
-    assert(!buyOrder.canMatchWith(sameSide));
-    
-    std::cout << "test_order_matching passed\n";
-}
-
-void test_order_lifecycle() {
-    Order order(10, 500, "AMZN", OrderType::LIMIT, OrderSide::BUY, 3200.0, 100);
-    
-    // Initial state
-    assert(!order.isPartiallyFilled());
-    assert(!order.isFullyFilled());
-    assert(order.getFilledQty() == 0);
-    
-    // Partial fill
-    order.updateRemainingQty(30);
-    assert(order.isPartiallyFilled());
-    assert(!order.isFullyFilled());
-    assert(order.getFilledQty() == 30);
-    assert(order.remainingQty == 70);
-    
-    // Another partial fill
-    order.updateRemainingQty(25);
-    assert(order.isPartiallyFilled());
-    assert(!order.isFullyFilled());
-    assert(order.getFilledQty() == 55);
-    assert(order.remainingQty == 45);
-    
-    // Complete fill
-    order.updateRemainingQty(45);
-    assert(!order.isPartiallyFilled());
-    assert(order.isFullyFilled());
-    assert(order.getFilledQty() == 100);
-    assert(order.remainingQty == 0);
-    
-    // Test cancel functionality
-    Order cancelOrder(20, 600, "NFLX", OrderType::LIMIT, OrderSide::SELL, 450.0, 50);
-    cancelOrder.cancel();
-    assert(cancelOrder.isFullyFilled()); // Cancelled orders appear as fully filled
-    assert(cancelOrder.remainingQty == 0);
-    
-    std::cout << "test_order_lifecycle passed\n";
-}
-
-void test_order_string_representation() {
-    Order order(999, 777, "META", OrderType::STOP_LIMIT, OrderSide::BUY, 300.50, 25, 305.0);
-    
-    std::string orderStr = order.toString();
-    
-    // Check that string contains key information
-    assert(orderStr.find("999") != std::string::npos); // orderId
-    assert(orderStr.find("777") != std::string::npos); // clientId
-    assert(orderStr.find("META") != std::string::npos); // symbol
-    assert(orderStr.find("STOP_LIMIT") != std::string::npos); // type
-    assert(orderStr.find("BUY") != std::string::npos); // side
-    assert(orderStr.find("300.50") != std::string::npos); // price
-    assert(orderStr.find("25") != std::string::npos); // quantity
-    assert(orderStr.find("305") != std::string::npos); // stopPrice
-    
-    std::cout << "test_order_string_representation passed\n";
-}
-
-int main() {
-    std::cout << "=== Running OBME Core Order Tests ===\n";
-    
-    test_add_order();
-    test_basic_limit_match();
-    test_order_constructors();
-    test_order_matching();
-    test_order_lifecycle();
-    test_order_string_representation();
-    
-    std::cout << "\n=== All tests passed! ===\n";
-    return 0;
-}
+#include "../src/engine/OrderBook.h"
+#include "../src/engine/TickOrderBook.h"
+#include "../src/engine/PriceLadder.h"
+#include "../src/engine/SymbolTable.h"
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "../src/models/OrderType.h"
+#include "../src/models/OrderSide.h"
+
+// Counts heap allocations so FIXED books can be checked for zero
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void test_add_order() {
+    OrderBook book;
+    
+    // Test Order constructor
+    Order order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 150.0, 100);
+    auto orderPtr = std::make_shared<Order>(order);
+    
+    // Test order validation
+    assert(order.isValid());
+    assert(!order.isPartiallyFilled());
+    assert(!order.isFullyFilled());
+    
+    // Test order properties
+    assert(order.orderId == 1);
+    assert(order.clientId == 100);
+    assert(order.symbol == "AAPL");
+    assert(order.type == OrderType::LIMIT);
+    assert(order.side == OrderSide::BUY);
+    assert(order.price == 150.0);
+    assert(order.quantity == 100);
+    assert(order.remainingQty == 100);
+    
+    // Test adding to order book
+    book.addOrder(orderPtr);
+    
+    // Test partial fill
+    order.updateRemainingQty(30);
+    assert(order.isPartiallyFilled());
+    assert(!order.isFullyFilled());
+    assert(order.getFilledQty() == 30);
+    assert(order.remainingQty == 70);
+    
+    // Test full fill
+    order.updateRemainingQty(70);
+    assert(!order.isPartiallyFilled());
+    assert(order.isFullyFilled());
+    assert(order.getFilledQty() == 100);
+    assert(order.remainingQty == 0);
+    
+    std::cout << "test_add_order passed\n";
+}
+
+void test_basic_limit_match() {
+    OrderBook book;
+    bool tradeHappened = false;
+    book.setTradeCallback([&](const Order& buy, const Order& sell, double price, uint32_t qty) {
+        tradeHappened = true;
+        assert(buy.side == OrderSide::BUY);
+        assert(sell.side == OrderSide::SELL);
+        assert(price == 100.0);
+        assert(qty == 10);
+    });
+    auto buy = std::make_shared<Order>();
+    buy->orderId = 1;
+    buy->symbol = "AAPL";
+    buy->type = OrderType::LIMIT;
+    buy->side = OrderSide::BUY;
+    buy->price = 100.0;
+    buy->quantity = 10;
+    buy->remainingQty = 10;
+    buy->timestamp = std::chrono::system_clock::now();
+    book.addOrder(buy);
+    auto sell = std::make_shared<Order>();
+    sell->orderId = 2;
+    sell->symbol = "AAPL";
+    sell->type = OrderType::LIMIT;
+    sell->side = OrderSide::SELL;
+    sell->price = 100.0;
+    sell->quantity = 10;
+    sell->remainingQty = 10;
+    sell->timestamp = std::chrono::system_clock::now();
+    book.addOrder(sell);
+    assert(tradeHappened);
+    std::cout << "test_basic_limit_match passed\n";
+}
+
+void test_order_constructors() {
+    // Test default constructor
+    Order defaultOrder;
+    assert(defaultOrder.orderId == 0);
+    assert(defaultOrder.quantity == 0);
+    assert(defaultOrder.remainingQty == 0);
+    assert(!defaultOrder.isValid()); // Should be invalid with zero values
+    
+    // Test parameterized constructor
+    Order order(123, 456, "MSFT", OrderType::MARKET, OrderSide::SELL, 250.75, 50);
+    assert(order.orderId == 123);
+    assert(order.clientId == 456);
+    assert(order.symbol == "MSFT");
+    assert(order.type == OrderType::MARKET);
+    assert(order.side == OrderSide::SELL);
+    assert(order.price == 250.75);
+    assert(order.quantity == 50);
+    assert(order.remainingQty == 50);
+    assert(order.isValid());
+    
+    // Test copy constructor
+    Order copied(order);
+    assert(copied.orderId == order.orderId);
+    assert(copied.symbol == order.symbol);
+    assert(copied.type == order.type);
+    assert(copied == order); // Test equality operator
+    
+    std::cout << "test_order_constructors passed\n";
+}
+
+void test_order_matching() {
+    // Create buy and sell orders that can match
+    Order buyOrder(1, 100, "GOOGL", OrderType::LIMIT, OrderSide::BUY, 2500.0, 10);
+    Order sellOrder(2, 200, "GOOGL", OrderType::LIMIT, OrderSide::SELL, 2500.0, 15);
+    
+    // Test matching capability
+    assert(buyOrder.canMatchWith(sellOrder));
+    assert(sellOrder.canMatchWith(buyOrder));
+    
+    // Test execution price
+    double execPrice = buyOrder.getExecutionPrice(sellOrder);
+    assert(execPrice == 2500.0);
+    
+    // Test orders with different symbols shouldn't match
+    Order differentSymbol(3, 300, "TSLA", OrderType::LIMIT, OrderSide::SELL, 800.0, 5);
+    assert(!buyOrder.canMatchWith(differentSymbol));
+    
+    // Test same side orders shouldn't match
+    Order sameSide(4, 400, "GOOGL", OrderType::LIMIT, OrderSide::BUY, 2450.0, 20);
+    assert(!buyOrder.canMatchWith(sameSide));
+    
+    std::cout << "test_order_matching passed\n";
+}
+
+void test_order_lifecycle() {
+    Order order(10, 500, "AMZN", OrderType::LIMIT, OrderSide::BUY, 3200.0, 100);
+    
+    // Initial state
+    assert(!order.isPartiallyFilled());
+    assert(!order.isFullyFilled());
+    assert(order.getFilledQty() == 0);
+    
+    // Partial fill
+    order.updateRemainingQty(30);
+    assert(order.isPartiallyFilled());
+    assert(!order.isFullyFilled());
+    assert(order.getFilledQty() == 30);
+    assert(order.remainingQty == 70);
+    
+    // Another partial fill
+    order.updateRemainingQty(25);
+    assert(order.isPartiallyFilled());
+    assert(!order.isFullyFilled());
+    assert(order.getFilledQty() == 55);
+    assert(order.remainingQty == 45);
+    
+    // Complete fill
+    order.updateRemainingQty(45);
+    assert(!order.isPartiallyFilled());
+    assert(order.isFullyFilled());
+    assert(order.getFilledQty() == 100);
+    assert(order.remainingQty == 0);
+    
+    // Test cancel functionality
+    Order cancelOrder(20, 600, "NFLX", OrderType::LIMIT, OrderSide::SELL, 450.0, 50);
+    cancelOrder.cancel();
+    assert(cancelOrder.isFullyFilled()); // Cancelled orders appear as fully filled
+    assert(cancelOrder.remainingQty == 0);
+    
+    std::cout << "test_order_lifecycle passed\n";
+}
+
+void test_order_string_representation() {
+    Order order(999, 777, "META", OrderType::STOP_LIMIT, OrderSide::BUY, 300.50, 25, 305.0);
+    
+    std::string orderStr = order.toString();
+    
+    // Check that string contains key information
+    assert(orderStr.find("999") != std::string::npos); // orderId
+    assert(orderStr.find("777") != std::string::npos); // clientId
+    assert(orderStr.find("META") != std::string::npos); // symbol
+    assert(orderStr.find("STOP_LIMIT") != std::string::npos); // type
+    assert(orderStr.find("BUY") != std::string::npos); // side
+    assert(orderStr.find("300.50") != std::string::npos); // price
+    assert(orderStr.find("25") != std::string::npos); // quantity
+    assert(orderStr.find("305") != std::string::npos); // stopPrice
+    
+    std::cout << "test_order_string_representation passed\n";
+}
+
+void test_tick_book_matching() {
+    TickOrderBook book(0.01, 64);
+    std::vector<uint64_t> fills;
+    book.setTradeCallback([&](const Order& buy, const Order& sell, double price, uint32_t qty) {
+        fills.push_back(buy.orderId);
+        assert(sell.orderId == 3);
+        assert(std::abs(price - 100.0) < 1e-9);
+    });
+    
+    // Prices differing only by rounding noise land on the same tick
+    book.addOrder(Order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0 + 1e-9, 10));
+    book.addOrder(Order(2, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0 - 1e-9, 10));
+    assert(std::abs(book.getBestBid() - 100.0) < 1e-9);
+    // Off-grid limits round away from the touch: neither side crosses its price
+    book.addOrder(Order(7, 100, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.005, 1));
+    book.addOrder(Order(6, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.009, 1));
+    assert(std::abs(book.getBestAsk() - 100.01) < 1e-9);
+    assert(book.getTotalTrades() == 0);
+    book.cancelOrder(6);
+    book.cancelOrder(7);
+    
+    // Far outside the initial window forces the ladder to grow
+    book.addOrder(Order(4, 100, "AAPL", OrderType::LIMIT, OrderSide::SELL, 250.0, 5));
+    book.addOrder(Order(5, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 50.0, 5));
+    assert(std::abs(book.getBestAsk() - 250.0) < 1e-9);
+    assert(std::abs(book.getBestBid() - 100.0) < 1e-9);
+    
+    // Sweep the 100.00 level in FIFO order
+    book.addOrder(Order(3, 100, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 20));
+    assert(fills.size() == 2 && fills[0] == 1 && fills[1] == 2);
+    assert(std::abs(book.getBestBid() - 50.0) < 1e-9);
+    
+    book.cancelOrder(5);
+    assert(book.getBestBid() == 0.0);
+    assert(book.getTotalTrades() == 2);
+    
+    std::cout << "test_tick_book_matching passed\n";
+}
+
+void test_tick_book_far_prices() {
+    // A billion ticks between the touches must not size the window
+    PriceLadder ladder(64, 1024);
+    const int64_t far = 1000000000;
+    ladder.levelAt(10000, OrderSide::BUY);
+    ladder.markOccupied(10000, OrderSide::BUY);
+    ladder.levelAt(far, OrderSide::SELL);
+    ladder.markOccupied(far, OrderSide::SELL);
+    assert(ladder.capacity() <= 1024);
+    assert(ladder.overflowLevels() == 1);
+    assert(ladder.bestBidTick() == 10000 && ladder.bestAskTick() == far);
+    
+    // Beyond the capped window on the other side as well
+    ladder.levelAt(5000, OrderSide::BUY);
+    ladder.markOccupied(5000, OrderSide::BUY);
+    int64_t next = 0;
+    assert(ladder.nextLevel(OrderSide::BUY, 10000, next) && next == 5000);
+    assert(!ladder.nextLevel(OrderSide::BUY, 5000, next));
+    assert(!ladder.nextLevel(OrderSide::SELL, far, next));
+    
+    // Once the window empties it re-centers and takes back overflow levels
+    ladder.markEmpty(10000, OrderSide::BUY);
+    ladder.markEmpty(5000, OrderSide::BUY);
+    assert(!ladder.hasOrders(OrderSide::BUY));
+    ladder.levelAt(far - 10, OrderSide::SELL);
+    ladder.markOccupied(far - 10, OrderSide::SELL);
+    assert(ladder.overflowLevels() == 0);
+    assert(ladder.bestAskTick() == far - 10);
+    assert(ladder.nextLevel(OrderSide::SELL, far - 10, next) && next == far);
+    
+    TickOrderBook book(0.01);
+    book.addOrder(Order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 10));
+    book.addOrder(Order(2, 100, "AAPL", OrderType::LIMIT, OrderSide::SELL, 1e7, 5));
+    book.addOrder(Order(3, 100, "AAPL", OrderType::LIMIT, OrderSide::SELL, 2e7, 5));
+    assert(std::abs(book.getBestBid() - 100.0) < 1e-9);
+    assert(std::abs(book.getBestAsk() - 1e7) < 1e-6);
+    auto snapshot = book.getDepthSnapshot(5);
+    assert(snapshot.asks.size() == 2 && std::abs(snapshot.asks[1].price - 2e7) < 1e-6);
+    
+    book.addOrder(Order(4, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 2e7, 10));
+    assert(book.getTotalTrades() == 2);
+    assert(book.getBestAsk() == 0.0);
+    assert(std::abs(book.getBestBid() - 100.0) < 1e-9);
+    
+    std::cout << "test_tick_book_far_prices passed\n";
+}
+
+void test_cancel_and_reduce_keep_fifo() {
+    OrderBook book;
+    std::vector<uint64_t> fills;
+    std::vector<uint32_t> qtys;
+    book.setTradeCallback([&](const Order& buy, const Order&, double, uint32_t qty) {
+        fills.push_back(buy.orderId);
+        qtys.push_back(qty);
+    });
+    
+    // Four bids queued at the same price
+    for (uint64_t id = 1; id <= 4; ++id) {
+        book.addOrder(Order(id, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 10));
+    }
+    
+    // Cancel from the middle, reduce the head in place
+    book.cancelOrder(2);
+    book.reduceOrder(1, 6);
+    book.cancelOrder(2); // already gone
+    assert(book.getBestBid() == 100.0);
+    
+    book.addOrder(Order(10, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 30));
+    assert((fills == std::vector<uint64_t>{1, 3, 4}));
+    assert((qtys == std::vector<uint32_t>{4, 10, 10}));
+    assert(book.getBestBid() == 0.0);
+    
+    // Residual of the sell rests; reducing it to zero empties the level
+    assert(book.getBestAsk() == 100.0);
+    book.reduceOrder(10, 6);
+    assert(book.getBestAsk() == 0.0);
+    
+    std::cout << "test_cancel_and_reduce_keep_fifo passed\n";
+}
+
+void test_order_pool_recycling() {
+    OrderBook book(2, PoolMode::FIXED);
+    
+    assert(book.addOrder(Order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 10)));
+    assert(book.addOrder(Order(2, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 98.0, 10)));
+    assert(!book.addOrder(Order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 97.0, 10))); // duplicate id
+    assert(!book.addOrder(Order(3, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 97.0, 10))); // pool exhausted
+    
+    auto stats = book.getPoolStats();
+    assert(stats.capacity == 2 && stats.inUse == 2 && stats.highWaterMark == 2);
+    assert(stats.slabs == 1 && stats.failedAcquires == 1);
+    
+    // A cancel and a fill hand both slots back for reuse
+    book.cancelOrder(2);
+    assert(book.getPoolStats().inUse == 1);
+    assert(book.addOrder(Order(4, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 99.0, 10)));
+    stats = book.getPoolStats();
+    assert(stats.inUse == 0 && stats.highWaterMark == 2 && stats.capacity == 2);
+    assert(book.getTotalTrades() == 1);
+    
+    // A growable pool adds slabs instead of refusing
+    OrderBook growable(1);
+    assert(growable.addOrder(Order(1, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 10)));
+    assert(growable.addOrder(Order(2, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 98.0, 10)));
+    assert(growable.getPoolStats().slabs == 2);
+    
+    std::cout << "test_order_pool_recycling passed\n";
+}
+
+// Resting adds at fresh levels, pending stops, a sweep and cancels: once a
+// FIXED book has seen the prices once, none of it may reach the heap
+template<typename Book>
+void checkFixedPoolDoesNotAllocate(Book& book) {
+    const int count = 1000;
+    std::vector<Order> orders;
+    for (int i = 0; i < count; ++i) {
+        orders.emplace_back(i + 1, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0 + i * 0.01, 10);
+    }
+    std::vector<Order> asks;
+    for (int i = 0; i < 100; ++i) {
+        asks.emplace_back(count + i + 1, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 120.0 + i * 0.01, 10);
+    }
+    Order stop(5000, 1, "AAPL", OrderType::STOP_LIMIT, OrderSide::SELL, 90.0, 10, 95.0);
+    Order sweep(6000, 1, "AAPL", OrderType::MARKET, OrderSide::SELL, 0.0, 500);
+    
+    for (int pass = 0; pass < 2; ++pass) {
+        size_t before = allocations;
+        for (const auto& order : orders) assert(book.addOrder(order));
+        for (const auto& order : asks) assert(book.addOrder(order));
+        assert(book.addOrder(stop));
+        assert(book.addOrder(sweep));
+        assert(book.getPendingStops() == 1);
+        for (int i = 0; i < count - 50; ++i) book.cancelOrder(i + 1);
+        for (const auto& order : asks) book.cancelOrder(order.orderId);
+        book.cancelOrder(stop.orderId);
+        assert(book.getPoolStats().inUse == 0);
+        // The first pass is the warm-up
+        if (pass == 1) assert(allocations == before);
+    }
+}
+
+void test_fixed_pool_does_not_allocate() {
+    OrderBook book(2048, PoolMode::FIXED);
+    checkFixedPoolDoesNotAllocate(book);
+    TickOrderBook tickBook(0.01, 4096, 2048, PoolMode::FIXED);
+    checkFixedPoolDoesNotAllocate(tickBook);
+    std::cout << "test_fixed_pool_does_not_allocate passed\n";
+}
+
+void test_compact_order_conversion() {
+    static_assert(sizeof(CompactOrder) == 64, "one cache line");
+    
+    Order order(42, 7, "NVDA", OrderType::STOP_LIMIT, OrderSide::SELL, 120.254, 300, 119.5);
+    order.remainingQty = 200;
+    CompactOrder compact;
+    // Off the 0.01 grid: flagged, and the sell limit rounded up, never down
+    assert(!CompactOrder::fromOrder(order, compact));
+    
+    auto& symbols = SymbolTable::instance();
+    assert(compact.symbolId == symbols.find("NVDA"));
+    assert(symbols.name(compact.symbolId) == "NVDA");
+    assert(compact.priceTicks == 12026);
+    assert(compact.stopTicks == 11950);
+    assert(compact.isValid());
+    
+    // Interned ids make symbol comparison an integer compare
+    assert(compact.sameSymbol(CompactOrder::fromOrder(Order(43, 7, "NVDA", OrderType::LIMIT, OrderSide::BUY, 120.0, 1))));
+    assert(!compact.sameSymbol(CompactOrder::fromOrder(Order(44, 7, "AMD", OrderType::LIMIT, OrderSide::BUY, 120.0, 1))));
+    
+    Order back = compact.toOrder();
+    assert(back.orderId == 42 && back.clientId == 7 && back.symbol == "NVDA");
+    assert(back.type == OrderType::STOP_LIMIT && back.side == OrderSide::SELL);
+    assert(std::abs(back.price - 120.26) < 1e-9 && std::abs(back.stopPrice - 119.5) < 1e-9);
+    assert(back.quantity == 300 && back.remainingQty == 200);
+    auto drift = back.timestamp - order.timestamp;
+    assert(drift < std::chrono::microseconds(1) && drift > -std::chrono::microseconds(1));
+    
+    // Binary noise is not off the grid; real off-tick prices round away from the market
+    order.price = 120.0 + 0.01 * 25;
+    assert(CompactOrder::fromOrder(order, compact) && compact.priceTicks == 12025);
+    Order buy(45, 7, "NVDA", OrderType::STOP_LIMIT, OrderSide::BUY, 100.006, 1, 99.994);
+    assert(!CompactOrder::fromOrder(buy, compact));
+    assert(compact.priceTicks == 10000 && compact.stopTicks == 10000);
+    Order market(46, 7, "NVDA", OrderType::MARKET, OrderSide::BUY, 0.005, 1);
+    assert(CompactOrder::fromOrder(market, compact));   // Its price is never used
+    
+    // The book accepts the compact form directly
+    OrderBook book;
+    assert(book.addOrder(CompactOrder::fromOrder(Order(1, 1, "NVDA", OrderType::LIMIT, OrderSide::BUY, 120.0, 5))));
+    assert(book.getBestBid() == 120.0);
+    
+    std::cout << "test_compact_order_conversion passed\n";
+}
+
+void test_modify_priority() {
+    OrderBook book;
+    TickOrderBook tickBook(0.01);
+    std::vector<uint64_t> fills, tickFills;
+    book.setTradeCallback([&](const Order& buy, const Order&, double, uint32_t) {
+        fills.push_back(buy.orderId);
+    });
+    tickBook.setTradeCallback([&](const Order& buy, const Order&, double, uint32_t) {
+        tickFills.push_back(buy.orderId);
+    });
+    
+    for (uint64_t id = 1; id <= 3; ++id) {
+        Order bid(id, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 10);
+        book.addOrder(bid);
+        tickBook.addOrder(bid);
+    }
+    
+    // Shrinking in place keeps order 1 at the head; growing order 2 and
+    // repricing order 3 away and back both send them to the back
+    assert(book.modifyOrder(1, 100.0, 5) && tickBook.modifyOrder(1, 100.0, 5));
+    assert(book.modifyOrder(2, 100.0, 12) && tickBook.modifyOrder(2, 100.0, 12));
+    assert(book.modifyOrder(3, 99.0, 10) && tickBook.modifyOrder(3, 99.0, 10));
+    assert(book.getBestBid() == 100.0);
+    Order reprice(3, 100, "AAPL", OrderType::MODIFY, OrderSide::BUY, 100.0, 10);
+    assert(book.addOrder(reprice) && tickBook.addOrder(reprice));
+    assert(!book.modifyOrder(99, 100.0, 10) && !tickBook.modifyOrder(99, 100.0, 10));
+    
+    Order sell(10, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 27);
+    book.addOrder(sell);
+    tickBook.addOrder(sell);
+    assert((fills == std::vector<uint64_t>{1, 2, 3}));
+    assert(tickFills == fills);
+    
+    // Filled quantity counts toward the new total: order 20 has filled 4 of
+    // 10, so a new total of 6 leaves 2 open and a total of 4 cancels it
+    book.addOrder(Order(20, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 10));
+    book.addOrder(Order(21, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 4));
+    assert(book.modifyOrder(20, 101.0, 6));
+    book.addOrder(Order(22, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 2));
+    assert(book.getBestBid() == 0.0);
+    book.addOrder(Order(23, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 10));
+    book.addOrder(Order(24, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 4));
+    assert(book.modifyOrder(23, 101.0, 4));
+    assert(book.getBestBid() == 0.0);
+    
+    // A reprice through the spread trades immediately
+    book.addOrder(Order(30, 200, "AAPL", OrderType::LIMIT, OrderSide::SELL, 103.0, 5));
+    book.addOrder(Order(31, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 102.0, 5));
+    uint64_t trades = book.getTotalTrades();
+    assert(book.modifyOrder(31, 103.0, 5));
+    assert(book.getTotalTrades() == trades + 1);
+    assert(book.getBestAsk() == 0.0 && book.getBestBid() == 0.0);
+    
+    // Cancels go through addOrder too and free the pool slot
+    book.addOrder(Order(40, 100, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 10));
+    size_t inUse = book.getPoolStats().inUse;
+    assert(book.addOrder(Order(40, 100, "AAPL", OrderType::CANCEL, OrderSide::BUY, 0.0, 10)));
+    assert(!book.addOrder(Order(40, 100, "AAPL", OrderType::CANCEL, OrderSide::BUY, 0.0, 10)));
+    assert(book.getPoolStats().inUse == inUse - 1);
+    assert(book.getBestBid() == 0.0);
+    
+    std::cout << "test_modify_priority passed\n";
+}
+
+template<typename Book>
+void checkMarketAndTimeInForce(Book& book) {
+    std::vector<uint64_t> fills;
+    book.setTradeCallback([&](const Order&, const Order& sell, double, uint32_t) {
+        fills.push_back(sell.orderId);
+    });
+    book.addOrder(Order(1, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 10));
+    book.addOrder(Order(2, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 103.0, 10));
+    book.addOrder(Order(3, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 10));
+    
+    // A market buy at price 0 sweeps both ask levels; its residual is dropped
+    assert(book.addOrder(Order(100, 2, "AAPL", OrderType::MARKET, OrderSide::BUY, 0.0, 25)));
+    assert((fills == std::vector<uint64_t>{1, 2}));
+    assert(book.getBestAsk() == 0.0 && book.getBestBid() == 99.0);
+    
+    // A market sell trades at the bid and never rests at 0
+    assert(book.addOrder(Order(101, 2, "AAPL", OrderType::MARKET, OrderSide::SELL, 0.0, 15)));
+    assert(book.getBestBid() == 0.0 && book.getBestAsk() == 0.0);
+    
+    // IOC fills what crosses its limit and drops the rest
+    book.addOrder(Order(4, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 5));
+    book.addOrder(Order(5, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 102.0, 5));
+    Order ioc(102, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 8);
+    ioc.timeInForce = TimeInForce::IOC;
+    uint64_t trades = book.getTotalTrades();
+    assert(book.addOrder(ioc));
+    assert(book.getTotalTrades() == trades + 1);
+    assert(book.getBestBid() == 0.0 && book.getBestAsk() == 102.0);
+    
+    // FOK: 7 cannot be covered within 102, so nothing trades; 5 can
+    Order fok(103, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 102.0, 7);
+    fok.timeInForce = TimeInForce::FOK;
+    assert(book.addOrder(fok));
+    assert(book.getTotalTrades() == trades + 1);
+    assert(book.getBestAsk() == 102.0 && book.getBestBid() == 0.0);
+    fok.orderId = 104;
+    fok.quantity = fok.remainingQty = 5;
+    assert(book.addOrder(fok));
+    assert(book.getTotalTrades() == trades + 2);
+    assert(book.getBestAsk() == 0.0);
+    
+    // Level totals follow partial fills and in-place reductions
+    book.addOrder(Order(6, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 104.0, 10));
+    book.addOrder(Order(7, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 105.0, 10));
+    book.reduceOrder(6, 4);
+    Order partial(105, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 104.0, 2);
+    book.addOrder(partial);
+    Order marketFok(106, 2, "AAPL", OrderType::MARKET, OrderSide::BUY, 0.0, 15);
+    marketFok.timeInForce = TimeInForce::FOK;
+    trades = book.getTotalTrades();
+    assert(book.addOrder(marketFok));
+    assert(book.getTotalTrades() == trades);
+    marketFok.orderId = 107;
+    marketFok.quantity = marketFok.remainingQty = 14;
+    assert(book.addOrder(marketFok));
+    assert(book.getTotalTrades() == trades + 2);
+    assert(book.getBestAsk() == 0.0);
+    assert(book.getPoolStats().inUse == 0);
+}
+
+void test_market_and_time_in_force() {
+    OrderBook book;
+    checkMarketAndTimeInForce(book);
+    TickOrderBook tickBook(0.01);
+    checkMarketAndTimeInForce(tickBook);
+    std::cout << "test_market_and_time_in_force passed\n";
+}
+
+template<typename Book>
+void checkStopOrders(Book& book) {
+    std::vector<std::pair<uint64_t, double>> fills;
+    book.setTradeCallback([&](const Order& buy, const Order&, double price, uint32_t) {
+        fills.push_back({buy.orderId, price});
+    });
+    book.addOrder(Order(1, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 10));
+    book.addOrder(Order(2, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 102.0, 10));
+    book.addOrder(Order(3, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 103.0, 10));
+    book.addOrder(Order(4, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 10));
+    
+    // Stops wait without touching the book, and can be cancelled
+    book.addOrder(Order(10, 2, "AAPL", OrderType::STOP_LIMIT, OrderSide::BUY, 102.0, 5, 101.0));
+    book.addOrder(Order(11, 2, "AAPL", OrderType::STOP, OrderSide::BUY, 0.0, 15, 102.0));
+    book.addOrder(Order(12, 2, "AAPL", OrderType::STOP, OrderSide::SELL, 0.0, 5, 98.0));
+    book.addOrder(Order(13, 2, "AAPL", OrderType::STOP, OrderSide::BUY, 0.0, 5, 101.0));
+    assert(book.getPendingStops() == 4 && book.getBestBid() == 99.0);
+    book.cancelOrder(13);
+    assert(book.getPendingStops() == 3);
+    
+    // A trade at 101 fires the stop-limit, whose fill at 102 fires the stop,
+    // which sweeps the rest of the asks, all within one call
+    book.addOrder(Order(20, 3, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 10));
+    std::vector<std::pair<uint64_t, double>> expected = {{20, 101.0}, {10, 102.0}, {11, 102.0}, {11, 103.0}};
+    assert(fills == expected);
+    assert(book.getPendingStops() == 1);
+    assert(book.getBestAsk() == 0.0 && book.getBestBid() == 99.0);
+    
+    // A trade at 99 does not reach the sell stop at 98
+    book.addOrder(Order(21, 3, "AAPL", OrderType::LIMIT, OrderSide::SELL, 99.0, 4));
+    assert(book.getPendingStops() == 1);
+    
+    // A stop the market is already through enters at once
+    book.addOrder(Order(22, 3, "AAPL", OrderType::STOP, OrderSide::SELL, 0.0, 3, 100.0));
+    assert(fills.size() == 6 && fills.back() == std::make_pair(uint64_t(4), 99.0));
+    assert(book.getPendingStops() == 1);
+    assert(book.getPoolStats().inUse == 2);
+}
+
+void test_stop_orders() {
+    OrderBook book;
+    checkStopOrders(book);
+    TickOrderBook tickBook(0.01);
+    checkStopOrders(tickBook);
+    std::cout << "test_stop_orders passed\n";
+}
+
+template<typename Book>
+void checkIcebergOrders(Book& book) {
+    std::vector<std::pair<uint64_t, uint32_t>> fills;
+    book.setTradeCallback([&](const Order&, const Order& sell, double, uint32_t qty) {
+        fills.push_back({sell.orderId, qty});
+    });
+    Order iceberg(1, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 30);
+    iceberg.displayQty = 10;
+    book.addOrder(iceberg);
+    book.addOrder(Order(2, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 10));
+    
+    // Each used-up slice requeues behind order 2 without a new pool slot
+    book.addOrder(Order(10, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 15));
+    std::vector<std::pair<uint64_t, uint32_t>> expected = {{1, 10}, {2, 5}};
+    assert(fills == expected);
+    assert(book.getPoolStats().inUse == 2);
+    book.addOrder(Order(11, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 20));
+    expected.insert(expected.end(), {{2, 5}, {1, 10}, {1, 5}});
+    assert(fills == expected);
+    assert(book.getPoolStats().inUse == 1);
+    
+    // Reducing caps the visible slice
+    book.reduceOrder(1, 3);
+    book.addOrder(Order(12, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 5));
+    expected.push_back({1, 2});
+    assert(fills == expected);
+    assert(book.getBestAsk() == 0.0 && book.getBestBid() == 100.0);
+    book.cancelOrder(12);
+    
+    // Hidden reserve counts toward a FOK
+    Order reserve(5, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.0, 20);
+    reserve.displayQty = 5;
+    book.addOrder(reserve);
+    Order fok(14, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 12);
+    fok.timeInForce = TimeInForce::FOK;
+    assert(book.addOrder(fok));
+    expected.insert(expected.end(), {{5, 5}, {5, 5}, {5, 2}});
+    assert(fills == expected);
+    book.cancelOrder(5);
+    assert(book.getBestAsk() == 0.0);
+    
+    // An aggressing iceberg trades its whole size, then rests a slice
+    book.addOrder(Order(3, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 4));
+    Order buyer(13, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 24);
+    buyer.displayQty = 5;
+    book.addOrder(buyer);
+    book.addOrder(Order(4, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 7));
+    expected.insert(expected.end(), {{3, 4}, {4, 5}, {4, 2}});
+    assert(fills == expected);
+    assert(book.getBestBid() == 101.0 && book.getPoolStats().inUse == 1);
+}
+
+void test_iceberg_orders() {
+    OrderBook book;
+    checkIcebergOrders(book);
+    TickOrderBook tickBook(0.01);
+    checkIcebergOrders(tickBook);
+    std::cout << "test_iceberg_orders passed\n";
+}
+
+template<typename Book>
+void checkDepthFeed(Book& book) {
+    DepthFeed feed(64);
+    book.setDepthFeed(&feed);
+    auto drain = [&] {
+        std::vector<LevelUpdate> updates;
+        LevelUpdate update;
+        while (feed.tryPop(update)) updates.push_back(update);
+        return updates;
+    };
+    book.addOrder(Order(1, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 10));
+    Order iceberg(2, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 30);
+    iceberg.displayQty = 5;
+    book.addOrder(iceberg);
+    book.addOrder(Order(3, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 102.0, 7));
+    book.addOrder(Order(4, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 5));
+    auto updates = drain();
+    assert(updates.size() == 4);
+    assert(updates[1].sequence == 2 && updates[1].price == 101.0);
+    assert(updates[1].qty == 15 && updates[1].orderCount == 2);   // Reserve stays hidden
+    assert(updates[3].side == OrderSide::BUY && updates[3].qty == 5);
+    
+    // A sweep through a level publishes it once, with its final state
+    book.addOrder(Order(5, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 12));
+    updates = drain();
+    assert(updates.size() == 1);
+    assert(updates[0].sequence == 5 && updates[0].side == OrderSide::SELL);
+    assert(updates[0].qty == 3 && updates[0].orderCount == 1);
+    
+    DepthSnapshot top = book.getDepthSnapshot(1);
+    assert(top.sequence == 5);
+    assert(top.bids.size() == 1 && top.bids[0].price == 99.0 && top.bids[0].qty == 5);
+    assert(top.asks.size() == 1 && top.asks[0].price == 101.0 && top.asks[0].qty == 3);
+    
+    // A late joiner rebuilds the book from a snapshot plus the later updates
+    DepthSnapshot joined = book.getDepthSnapshot(10);
+    assert(joined.asks.size() == 2 && joined.asks[1].price == 102.0);
+    book.reduceOrder(3, 2);
+    book.cancelOrder(4);
+    book.modifyOrder(2, 100.0, 25);
+    std::map<std::pair<OrderSide, double>, uint64_t> levels;
+    for (const auto& level : joined.bids) levels[{OrderSide::BUY, level.price}] = level.qty;
+    for (const auto& level : joined.asks) levels[{OrderSide::SELL, level.price}] = level.qty;
+    for (const auto& update : drain()) {
+        assert(update.sequence > joined.sequence);
+        if (update.qty == 0) levels.erase({update.side, update.price});
+        else levels[{update.side, update.price}] = update.qty;
+    }
+    DepthSnapshot now = book.getDepthSnapshot(10);
+    assert(now.sequence == 9 && now.bids.empty() && now.asks.size() == 2);
+    assert(levels.size() == 2);
+    for (const auto& level : now.asks) {
+        uint64_t replayed = levels[{OrderSide::SELL, level.price}];
+        assert(replayed == level.qty);
+    }
+    
+    // A full feed drops updates but still burns their sequence numbers
+    DepthFeed tiny(2);
+    book.setDepthFeed(&tiny);
+    book.addOrder(Order(6, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 98.0, 1));
+    book.addOrder(Order(7, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 97.0, 1));
+    book.addOrder(Order(8, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 96.0, 1));
+    assert(book.getDroppedDepthUpdates() == 1);
+    assert(book.getDepthSnapshot(0).sequence == 12);
+    book.setDepthFeed(nullptr);
+    book.cancelOrder(6);
+    assert(tiny.size() == 2 && book.getDepthSnapshot(0).sequence == 12);
+}
+
+void test_depth_feed() {
+    OrderBook book;
+    checkDepthFeed(book);
+    TickOrderBook tickBook(0.01);
+    checkDepthFeed(tickBook);
+    std::cout << "test_depth_feed passed\n";
+}
+
+template<typename Book>
+void checkExecutionFeed(Book& book) {
+    ExecutionFeed feed(16);
+    book.setExecutionFeed(&feed);
+    std::vector<std::vector<uint64_t>> callbackTrades;
+    book.setTradeCallback([&](const Order& buy, const Order& sell, double price, uint32_t qty) {
+        callbackTrades.push_back({buy.orderId, sell.orderId, static_cast<uint64_t>(price * 100 + 0.5), qty});
+    });
+    book.addOrder(Order(1, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 10));
+    book.addOrder(Order(2, 1, "AAPL", OrderType::LIMIT, OrderSide::SELL, 102.0, 10));
+    book.addOrder(Order(3, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 102.0, 15));    // Takes both levels
+    book.addOrder(Order(4, 2, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 8));
+    book.addOrder(Order(5, 1, "AAPL", OrderType::MARKET, OrderSide::SELL, 0.0, 3));
+    std::vector<ExecutionReport> reports;
+    ExecutionReport report;
+    while (feed.tryPop(report)) reports.push_back(report);
+    assert(reports.size() == 3 && callbackTrades.size() == 3);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        assert(reports[i].sequence == i + 1 && reports[i].tradeId == i + 1);
+        assert(reports[i].buyOrderId == callbackTrades[i][0] && reports[i].sellOrderId == callbackTrades[i][1]);
+        assert(static_cast<uint64_t>(reports[i].price * 100 + 0.5) == callbackTrades[i][2]);
+        assert(reports[i].qty == callbackTrades[i][3]);
+    }
+    assert(reports[0].aggressor == OrderSide::BUY && reports[0].price == 101.0 && reports[0].qty == 10);
+    assert(reports[1].aggressor == OrderSide::BUY && reports[1].price == 102.0 && reports[1].qty == 5);
+    assert(reports[2].aggressor == OrderSide::SELL && reports[2].buyOrderId == 4 && reports[2].qty == 3);
+    
+    // A full feed drops reports, never stalls matching, and leaves a gap
+    ExecutionFeed tiny(2);
+    book.setExecutionFeed(&tiny);
+    for (uint64_t id = 6; id <= 8; ++id) {
+        book.addOrder(Order(id, 1, "AAPL", OrderType::MARKET, OrderSide::SELL, 0.0, 1));
+    }
+    assert(book.getDroppedExecutionReports() == 1 && book.getTotalTrades() == 6);
+    assert(tiny.tryPop(report) && report.sequence == 4 && report.tradeId == 4);
+    book.setExecutionFeed(nullptr);
+    book.addOrder(Order(9, 1, "AAPL", OrderType::MARKET, OrderSide::SELL, 0.0, 1));
+    assert(tiny.size() == 1 && book.getTotalTrades() == 7);
+}
+
+void test_execution_feed() {
+    OrderBook book;
+    checkExecutionFeed(book);
+    TickOrderBook tickBook(0.01);
+    checkExecutionFeed(tickBook);
+    std::cout << "test_execution_feed passed\n";
+}
+
+template<typename Book>
+void checkTopOfBook(Book& book) {
+    assert(book.getTopOfBook().sequence == 0);
+    book.addOrder(Order(1, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 10));
+    book.addOrder(Order(2, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0, 5));
+    Order iceberg(3, 2, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0, 50);
+    iceberg.displayQty = 8;
+    book.addOrder(iceberg);
+    TopOfBook top = book.getTopOfBook();
+    assert(top.sequence == 3);
+    assert(top.bidPrice == 99.0 && top.bidQty == 15);
+    assert(top.askPrice == 101.0 && top.askQty == 8);
+    
+    // Changes away from the touch leave the top and its sequence alone
+    book.addOrder(Order(4, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 98.0, 7));
+    book.cancelOrder(4);
+    assert(book.getTopOfBook().sequence == 3);
+    book.reduceOrder(1, 4);
+    assert(book.getTopOfBook().bidQty == 11 && book.getTopOfBook().sequence == 4);
+    
+    // Readers on other threads always see a whole published state
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        uint64_t lastSequence = 0;
+        while (!done.load()) {
+            TopOfBook seen = book.getTopOfBook();
+            assert(seen.sequence >= lastSequence);
+            assert(seen.askPrice == 101.0);
+            if (seen.bidPrice != 99.0) assert(seen.bidQty == static_cast<uint64_t>(seen.bidPrice));
+            lastSequence = seen.sequence;
+        }
+    });
+    book.addOrder(Order(5, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 100));
+    for (int i = 1; i <= 20000; ++i) {
+        // Price and size move together, so a torn read breaks qty == price
+        bool high = i % 2 == 0;
+        book.modifyOrder(5, high ? 100.0 : 99.99, high ? 100 : 99);
+    }
+    done = true;
+    reader.join();
+}
+
+void test_top_of_book() {
+    OrderBook book;
+    checkTopOfBook(book);
+    TickOrderBook tickBook(0.01);
+    checkTopOfBook(tickBook);
+    std::cout << "test_top_of_book passed\n";
+}
+
+int main() {
+    std::cout << "=== Running OBME Core Order Tests ===\n";
+    
+    test_add_order();
+    test_basic_limit_match();
+    test_order_constructors();
+    test_order_matching();
+    test_order_lifecycle();
+    test_order_string_representation();
+    test_tick_book_matching();
+    test_tick_book_far_prices();
+    test_cancel_and_reduce_keep_fifo();
+    test_modify_priority();
+    test_market_and_time_in_force();
+    test_stop_orders();
+    test_iceberg_orders();
+    test_depth_feed();
+    test_execution_feed();
+    test_top_of_book();
+    test_order_pool_recycling();
+    test_fixed_pool_does_not_allocate();
+    test_compact_order_conversion();
+    
+    std::cout << "\n=== All tests passed! ===\n";
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "../src/io/OrderParser.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// Counts heap allocations so the fast path can be checked for zero
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void test_fast_path_matches_legacy() {
+    OrderParser parser;
+    const std::string inputs[] = {
+        "{\"orderId\": 7, \"clientId\": 101, \"symbol\": \"AAPL\", \"type\": \"limit\", \"side\": \"SELL\", "
+        "\"price\": 150.25, \"quantity\": 100, \"remainingQty\": 40, \"stopPrice\": 0.0}",
+        "{\"orderId\":6,\"symbol\":\"AMZN\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"price\":180,\"quantity\":9,\"timeInForce\":\"ioc\",\"displayQty\":3}",
+        "{\"orderId\":8,\"symbol\":\"MSFT\",\"type\":\"STOP_LIMIT\",\"side\":\"BUY\",\"price\":300.5,\"quantity\":5,\"stopPrice\":299}",
+        "9, GOOGL, MARKET, BUY, 0, 25, 55, 20, 0",
+        "10|TSLA|LIMIT|SELL|210.75|3"
+    };
+    for (const auto& input : inputs) {
+        Order legacy = parser.parse(input);
+        Order fast;
+        assert(parser.parse(std::string_view(input), fast) == ParseError::OK);
+        assert(fast.orderId == legacy.orderId);
+        assert(fast.clientId == legacy.clientId);
+        assert(fast.symbol == legacy.symbol);
+        assert(fast.type == legacy.type);
+        assert(fast.side == legacy.side);
+        assert(fast.price == legacy.price);
+        assert(fast.quantity == legacy.quantity);
+        assert(fast.remainingQty == legacy.remainingQty);
+        assert(fast.stopPrice == legacy.stopPrice);
+        assert(fast.timeInForce == legacy.timeInForce);
+        assert(fast.displayQty == legacy.displayQty);
+    }
+    assert(parser.parse(inputs[1]).timeInForce == TimeInForce::IOC);
+    assert(parser.parse(inputs[1]).displayQty == 3);
+    assert(parser.parse(inputs[0]).timeInForce == TimeInForce::GTC);
+    std::cout << "test_fast_path_matches_legacy passed\n";
+}
+
+void test_fast_path_errors() {
+    OrderParser parser;
+    Order order;
+    assert(parser.parse("   ", order) == ParseError::EMPTY_INPUT);
+    assert(parser.parse("hello", order) == ParseError::UNKNOWN_FORMAT);
+    assert(parser.parse("1,AAPL,LIMIT,BUY,100", order) == ParseError::MISSING_FIELD);
+    assert(parser.parse("1,AAPL,LIMIT,BUY,10x0,5", order) == ParseError::BAD_NUMBER);
+    assert(parser.parse("1,AAPL,LIMITED,BUY,100,5", order) == ParseError::BAD_TYPE);
+    assert(parser.parse("1|AAPL|LIMIT|HOLD|100|5", order) == ParseError::BAD_SIDE);
+    assert(parser.parse("1,AAPL,LIMIT,BUY,100,0", order) == ParseError::INVALID_ORDER);
+    assert(parser.parse("1," + std::string(MAX_SYMBOL_LENGTH + 1, 'S') + ",LIMIT,BUY,100,5", order) ==
+           ParseError::INVALID_ORDER);
+    assert(parser.parse("1,AAPL,LIMIT,BUY,100,99999999999", order) == ParseError::BAD_NUMBER);
+    assert(parser.parse("{\"orderId\":1,\"symbol\":\"AAPL\",\"side\":\"BUY\",\"quantity\":5}", order) == ParseError::MISSING_FIELD);
+    assert(parser.parse("{\"orderId\":1,\"symbol\":\"AAPL}", order) == ParseError::MALFORMED);
+    assert(parser.parse("{\"orderId\":1,\"symbol\":\"AAPL\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"quantity\":5,"
+                        "\"timeInForce\":\"DAY\"}", order) == ParseError::BAD_TYPE);
+    assert(std::string(parseErrorToString(ParseError::BAD_SIDE)) == "BAD_SIDE");
+    std::cout << "test_fast_path_errors passed\n";
+}
+
+void test_fast_path_does_not_allocate() {
+    OrderParser parser;
+    Order order;
+    const std::string json = "{\"orderId\":1,\"symbol\":\"AAPL\",\"type\":\"LIMIT\",\"side\":\"BUY\",\"price\":100.5,\"quantity\":10}";
+    const std::string csv = "2,GOOGL,LIMIT,SELL,101.25,20,7";
+    const std::string pipe = "3|MSFT|MARKET|BUY|0|30";
+    assert(parser.parse(json, order) == ParseError::OK);
+
+    size_t before = allocations;
+    for (int i = 0; i < 1000; ++i) {
+        assert(parser.parse(json, order) == ParseError::OK);
+        assert(parser.parse(csv, order) == ParseError::OK);
+        assert(parser.parse(pipe, order) == ParseError::OK);
+        assert(parser.parse("1,AAPL,LIMIT,BUY,bad,5", order) == ParseError::BAD_NUMBER);
+    }
+    assert(allocations == before);
+    std::cout << "test_fast_path_does_not_allocate passed\n";
+}
+
+int main() {
+    test_fast_path_matches_legacy();
+    test_fast_path_errors();
+    test_fast_path_does_not_allocate();
+    std::cout << "All parser tests passed!\n";
+    return 0;
+}
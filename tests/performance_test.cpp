@@ -1,147 +1,927 @@
-#include <iostream>
-#include <chrono>
-#include <random>
-#include <vector>
-#include <algorithm>
-#include <numeric>
-#include "engine/OrderBook.h"
-#include "engine/Order.h"
-#include "io/Logger.h"
-
-class PerformanceTester {
-private:
-    OrderBook book_;
-    Logger logger_;
-    std::mt19937 rng_;
-    uint64_t orderIdCounter_;
-    
-public:
-    PerformanceTester() : logger_("../data/performance_test.log"), rng_(42), orderIdCounter_(1) {
-        book_.setTradeCallback([](const Order& buy, const Order& sell, double price, uint32_t qty) {
-            // Minimal callback for performance testing
-        });
-    }
-    
-    Order generateRandomOrder() {
-        std::uniform_int_distribution<> sideDist(0, 1);
-        std::uniform_real_distribution<> priceDist(99.0, 101.0);
-        std::uniform_int_distribution<> qtyDist(1, 1000);
-        std::uniform_int_distribution<> typeDist(0, 1);
-        
-        OrderSide side = sideDist(rng_) == 0 ? OrderSide::BUY : OrderSide::SELL;
-        OrderType type = typeDist(rng_) == 0 ? OrderType::LIMIT : OrderType::MARKET;
-        double price = type == OrderType::MARKET ? 0.0 : priceDist(rng_);
-        
-        return Order(orderIdCounter_++, 100, "PERF", type, side, price, qtyDist(rng_));
-    }
-    
-    void runPerformanceTest(int numOrders) {
-        std::cout << "Starting performance test with " << numOrders << " orders...\n";
-        
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        for (int i = 0; i < numOrders; ++i) {
-            Order order = generateRandomOrder();
-            auto orderPtr = std::make_shared<Order>(order);
-            book_.addOrder(orderPtr);
-        }
-        
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        
-        double seconds = duration.count() / 1000000.0;
-        double ordersPerSecond = numOrders / seconds;
-        double avgLatencyMicros = duration.count() / (double)numOrders;
-        
-        std::cout << "\n=== Performance Results ===\n";
-        std::cout << "Total Orders: " << numOrders << "\n";
-        std::cout << "Total Time: " << seconds << " seconds\n";
-        std::cout << "Orders/Second: " << ordersPerSecond << "\n";
-        std::cout << "Average Latency: " << avgLatencyMicros << " microseconds\n";
-        std::cout << "Total Trades: " << book_.getTotalTrades() << "\n";
-        std::cout << "Best Bid: " << book_.getBestBid() << "\n";
-        std::cout << "Best Ask: " << book_.getBestAsk() << "\n";
-        
-        if (ordersPerSecond >= 10000) {
-            std::cout << "TARGET ACHIEVED: 10,000+ orders/sec!\n";
-        } else {
-            std::cout << "Target not reached, but performance is: " << ordersPerSecond << " orders/sec\n";
-        }
-        
-        if (avgLatencyMicros < 1000) {
-            std::cout << "SUB-MILLISECOND LATENCY ACHIEVED!\n";
-        } else {
-            std::cout << "Latency is: " << avgLatencyMicros << " microseconds\n";
-        }
-    }
-    
-    void runLatencyTest(int numOrders = 1000) {
-        std::cout << "\nRunning latency test...\n";
-        std::vector<double> latencies;
-        
-        for (int i = 0; i < numOrders; ++i) {
-            Order order = generateRandomOrder();
-            auto orderPtr = std::make_shared<Order>(order);
-            
-            auto start = std::chrono::high_resolution_clock::now();
-            book_.addOrder(orderPtr);
-            auto end = std::chrono::high_resolution_clock::now();
-            
-            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-            latencies.push_back(latency.count());
-        }
-        
-        // Calculate statistics
-        std::sort(latencies.begin(), latencies.end());
-        double min_lat = latencies.front();
-        double max_lat = latencies.back();
-        double avg_lat = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
-        double p50 = latencies[latencies.size() * 0.5];
-        double p95 = latencies[latencies.size() * 0.95];
-        double p99 = latencies[latencies.size() * 0.99];
-        
-        std::cout << "\n=== Latency Statistics (nanoseconds) ===\n";
-        std::cout << "Min: " << min_lat << " ns\n";
-        std::cout << "Average: " << avg_lat << " ns\n";
-        std::cout << "P50 (median): " << p50 << " ns\n";
-        std::cout << "P95: " << p95 << " ns\n";
-        std::cout << "P99: " << p99 << " ns\n";
-        std::cout << "Max: " << max_lat << " ns\n";
-        
-        std::cout << "\n=== Latency Statistics (microseconds) ===\n";
-        std::cout << "Min: " << min_lat/1000 << " μs\n";
-        std::cout << "Average: " << avg_lat/1000 << " μs\n";
-        std::cout << "P50 (median): " << p50/1000 << " μs\n";
-        std::cout << "P95: " << p95/1000 << " μs\n";
-        std::cout << "P99: " << p99/1000 << " μs\n";
-        std::cout << "Max: " << max_lat/1000 << " μs\n";
-    }
-};
-
-int main() {
-    std::cout << "OBME Core Performance Test Suite\n";
-    std::cout << "========================================\n";
-    
-    PerformanceTester tester;
-    
-    // Test different scales
-    std::vector<int> testSizes = {1000, 5000, 10000, 25000, 50000};
-    
-    for (int size : testSizes) {
-        tester.runPerformanceTest(size);
-        std::cout << "\n";
-    }
-    
-    // Detailed latency analysis
-    tester.runLatencyTest(10000);
-    
-    std::cout << "\nPerformance Goals Status:\n";
-    std::cout << "High-performance C++ order book: IMPLEMENTED\n";
-    std::cout << "Price-time priority matching: IMPLEMENTED\n";
-    std::cout << "Thread-safe order handling: IMPLEMENTED\n";
-    std::cout << "Custom bid/ask queues: IMPLEMENTED\n";
-    std::cout << "Robust logging system: IMPLEMENTED\n";
-    std::cout << "Trade execution tracking: IMPLEMENTED\n";
-    
-    return 0;
-}
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <atomic>
+#include "engine/OrderBook.h"
+#include "engine/TickOrderBook.h"
+#include "engine/ShardedMatcher.h"
+#include "engine/SymbolTable.h"
+#include "engine/Order.h"
+#include "io/Logger.h"
+#include "io/DataFeed.h"
+#include "io/OrderParser.h"
+#include "io/BulkDecoder.h"
+#include "io/WireFormat.h"
+#include "io/Journal.h"
+#include "io/Snapshot.h"
+
+class PerformanceTester {
+private:
+    OrderBook book_;
+    Logger logger_;
+    std::mt19937 rng_;
+    uint64_t orderIdCounter_;
+    
+public:
+    PerformanceTester() : logger_("../data/performance_test.log"), rng_(42), orderIdCounter_(1) {
+        book_.setTradeCallback([](const Order& buy, const Order& sell, double price, uint32_t qty) {
+            // Minimal callback for performance testing
+        });
+    }
+    
+    Order generateRandomOrder() {
+        std::uniform_int_distribution<> sideDist(0, 1);
+        std::uniform_real_distribution<> priceDist(99.0, 101.0);
+        std::uniform_int_distribution<> qtyDist(1, 1000);
+        std::uniform_int_distribution<> typeDist(0, 1);
+        
+        OrderSide side = sideDist(rng_) == 0 ? OrderSide::BUY : OrderSide::SELL;
+        OrderType type = typeDist(rng_) == 0 ? OrderType::LIMIT : OrderType::MARKET;
+        double price = type == OrderType::MARKET ? 0.0 : onTick(priceDist(rng_));
+        
+        return Order(orderIdCounter_++, 100, "PERF", type, side, price, qtyDist(rng_));
+    }
+    
+    Order generateLimitOrder() {
+        std::uniform_int_distribution<> sideDist(0, 1);
+        std::uniform_real_distribution<> priceDist(99.0, 101.0);
+        std::uniform_int_distribution<> qtyDist(1, 1000);
+        
+        OrderSide side = sideDist(rng_) == 0 ? OrderSide::BUY : OrderSide::SELL;
+        return Order(orderIdCounter_++, 100, "PERF", OrderType::LIMIT, side, onTick(priceDist(rng_)), qtyDist(rng_));
+    }
+
+    // The matchers refuse prices off the default 0.01 grid
+    static double onTick(double price) {
+        return std::round(price * 100.0) / 100.0;
+    }
+    
+    template<typename Book>
+    double timeBook(Book& book, const std::vector<Order>& orders) {
+        book.setTradeCallback([](const Order&, const Order&, double, uint32_t) {});
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& order : orders) {
+            book.addOrder(order);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+    
+    void runBackendComparison(int numOrders) {
+        std::cout << "\nComparing map-based and tick-ladder books with " << numOrders << " limit orders...\n";
+        
+        std::vector<Order> orders;
+        orders.reserve(numOrders);
+        for (int i = 0; i < numOrders; ++i) {
+            orders.push_back(generateLimitOrder());
+        }
+        
+        OrderBook mapBook;
+        TickOrderBook tickBook(0.01);
+        double mapSeconds = timeBook(mapBook, orders);
+        double tickSeconds = timeBook(tickBook, orders);
+        
+        std::cout << "\n=== Book Backend Comparison ===\n";
+        std::cout << "std::map book: " << numOrders / mapSeconds << " orders/sec, "
+                  << mapBook.getTotalTrades() << " trades\n";
+        std::cout << "Tick ladder book: " << numOrders / tickSeconds << " orders/sec, "
+                  << tickBook.getTotalTrades() << " trades\n";
+        std::cout << "Speedup: " << mapSeconds / tickSeconds << "x\n";
+    }
+    
+    void runCancelTest(int levelDepth) {
+        std::cout << "\nRunning cancel test on a level " << levelDepth << " orders deep...\n";
+        OrderBook book;
+        std::vector<uint64_t> ids;
+        for (int i = 0; i < levelDepth; ++i) {
+            ids.push_back(orderIdCounter_);
+            book.addOrder(Order(orderIdCounter_++, 100, "PERF", OrderType::LIMIT, OrderSide::BUY, 100.0, 10));
+        }
+        std::shuffle(ids.begin(), ids.end(), rng_);
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint64_t id : ids) {
+            book.cancelOrder(id);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double nanos = std::chrono::duration<double, std::nano>(end - start).count();
+        
+        std::cout << "Average cancel latency: " << nanos / levelDepth << " ns\n";
+    }
+    
+    void runMessageTypeLatency(int numMessages) {
+        std::cout << "\nRunning per-message-type latency test with " << numMessages << " messages...\n";
+        struct Live { uint64_t id; OrderSide side; int64_t ticks; uint32_t qty; };
+        OrderBook book;
+        uint32_t symbolId = SymbolTable::instance().intern("PERF");
+        std::uniform_int_distribution<int64_t> offsetDist(1, 1000);
+        std::vector<Live> live;
+        
+        // Bids rest below 10000 ticks and asks above, so nothing crosses and
+        // each message measures only its own bookkeeping
+        auto makeNew = [&](OrderSide side) {
+            int64_t offset = offsetDist(rng_);
+            Live order{orderIdCounter_++, side, side == OrderSide::BUY ? 10000 - offset : 10000 + offset, 100};
+            live.push_back(order);
+            Order full(order.id, 100, "PERF", OrderType::LIMIT, side, order.ticks * 0.01, order.qty);
+            return CompactOrder::fromOrder(full);
+        };
+        for (int i = 0; i < numMessages / 4; ++i) {
+            book.addOrder(makeNew(i % 2 ? OrderSide::BUY : OrderSide::SELL));
+        }
+        
+        const char* names[] = {"NEW", "CANCEL", "MODIFY (reduce)", "MODIFY (reprice)"};
+        std::vector<double> latencies[4];
+        for (int i = 0; i < numMessages; ++i) {
+            int kind = i % 4;
+            CompactOrder message;
+            if (kind == 0 || live.empty()) {
+                kind = 0;
+                message = makeNew(i % 8 ? OrderSide::SELL : OrderSide::BUY);
+            } else {
+                size_t pick = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng_);
+                Live& target = live[pick];
+                if (kind == 1) {
+                    message = CompactOrder::makeCancel(target.id, symbolId);
+                    target = live.back();
+                    live.pop_back();
+                } else if (kind == 2 && target.qty > 1) {
+                    target.qty--;
+                    message = CompactOrder::makeModify(target.id, symbolId, target.ticks, target.qty);
+                } else {
+                    kind = 3;
+                    int64_t offset = offsetDist(rng_);
+                    target.ticks = target.side == OrderSide::BUY ? 10000 - offset : 10000 + offset;
+                    message = CompactOrder::makeModify(target.id, symbolId, target.ticks, target.qty);
+                }
+            }
+            auto start = std::chrono::high_resolution_clock::now();
+            book.addOrder(message);
+            auto end = std::chrono::high_resolution_clock::now();
+            latencies[kind].push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        
+        std::cout << "\n=== Latency by Message Type (nanoseconds) ===\n";
+        for (int kind = 0; kind < 4; ++kind) printLatencySeries(names[kind], latencies[kind]);
+    }
+    
+    void printLatencySeries(const char* name, std::vector<double>& samples) {
+        if (samples.empty()) return;
+        std::sort(samples.begin(), samples.end());
+        double avg = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        std::cout << name << ": avg " << avg
+                  << ", p50 " << samples[samples.size() / 2]
+                  << ", p99 " << samples[samples.size() * 99 / 100]
+                  << " (" << samples.size() << " messages)\n";
+    }
+    
+    void runStopTriggerTest(int pendingStops) {
+        std::cout << "\nRunning stop trigger test with " << pendingStops << " pending stops...\n";
+        std::vector<Order> flow;
+        for (int i = 0; i < 100000; ++i) flow.push_back(generateLimitOrder());
+        
+        // Stops far outside the traded range stay pending the whole run, so
+        // any per-trade scan of them would show up as lost throughput
+        OrderBook plain, withStops;
+        for (int i = 0; i < pendingStops; ++i) {
+            bool buy = i % 2 == 0;
+            withStops.addOrder(Order(orderIdCounter_++, 100, "PERF", OrderType::STOP, buy ? OrderSide::BUY : OrderSide::SELL,
+                                     0.0, 10, buy ? 200.0 + i * 0.01 : 50.0 - i * 0.001));
+        }
+        double plainSeconds = timeBook(plain, flow);
+        double stopSeconds = timeBook(withStops, flow);
+        
+        // Release: one trade fires every stop; each enters as a non-crossing limit
+        OrderBook release;
+        release.addOrder(Order(orderIdCounter_++, 100, "PERF", OrderType::LIMIT, OrderSide::SELL, 100.0, 1));
+        for (int i = 0; i < pendingStops; ++i) {
+            release.addOrder(Order(orderIdCounter_++, 100, "PERF", OrderType::STOP_LIMIT, OrderSide::BUY,
+                                   90.0 - (i % 100) * 0.01, 10, 99.0 + (i % 100) * 0.01));
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        release.addOrder(Order(orderIdCounter_++, 100, "PERF", OrderType::LIMIT, OrderSide::BUY, 100.0, 1));
+        auto end = std::chrono::high_resolution_clock::now();
+        double releaseNanos = std::chrono::duration<double, std::nano>(end - start).count();
+        
+        std::cout << "\n=== Stop Orders ===\n";
+        std::cout << "No stops: " << flow.size() / plainSeconds << " orders/sec\n";
+        std::cout << pendingStops << " pending stops: " << flow.size() / stopSeconds << " orders/sec\n";
+        std::cout << "Released " << pendingStops - release.getPendingStops() << " stops in one cascade: "
+                  << releaseNanos / pendingStops << " ns/stop\n";
+    }
+    
+    void runIcebergTest(int numOrders) {
+        std::cout << "\nRunning iceberg test with " << numOrders << " orders...\n";
+        std::vector<Order> plainFlow;
+        for (int i = 0; i < numOrders; ++i) plainFlow.push_back(generateLimitOrder());
+        
+        // Same flow with 30% of orders showing a fifth of their size
+        std::vector<Order> icebergFlow = plainFlow;
+        std::uniform_int_distribution<> pct(0, 99);
+        for (auto& order : icebergFlow) {
+            if (pct(rng_) < 30) order.displayQty = std::max<uint32_t>(1, order.quantity / 5);
+        }
+        
+        OrderBook warmup, plainBook, icebergBook;
+        timeBook(warmup, plainFlow);
+        double plainSeconds = timeBook(plainBook, plainFlow);
+        double icebergSeconds = timeBook(icebergBook, icebergFlow);
+        
+        std::cout << "\n=== Iceberg Orders (30% participation) ===\n";
+        std::cout << "Plain limits: " << numOrders / plainSeconds << " orders/sec, "
+                  << plainBook.getTotalTrades() << " trades\n";
+        std::cout << "With icebergs: " << numOrders / icebergSeconds << " orders/sec, "
+                  << icebergBook.getTotalTrades() << " trades\n";
+        std::cout << "Throughput ratio: " << plainSeconds / icebergSeconds << "\n";
+    }
+    
+    void runDepthFeedTest(int numOrders) {
+        std::cout << "\nRunning market data test with " << numOrders << " orders...\n";
+        std::vector<Order> orders;
+        orders.reserve(numOrders);
+        for (int i = 0; i < numOrders; ++i) orders.push_back(generateLimitOrder());
+        
+        OrderBook warmup, quietBook, pollBook, feedBook;
+        timeBook(warmup, orders);
+        double quietSeconds = timeBook(quietBook, orders);
+        
+        // Consumer polling the seqlocked top of book
+        std::atomic<bool> done{false};
+        uint64_t polls = 0;
+        std::thread poller([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                pollBook.getTopOfBook();
+                polls++;
+            }
+        });
+        double pollSeconds = timeBook(pollBook, orders);
+        done = true;
+        poller.join();
+        
+        // Consumer draining level deltas without touching the book
+        DepthFeed feed(1 << 16);
+        feedBook.setDepthFeed(&feed);
+        done = false;
+        uint64_t updates = 0;
+        std::thread consumer([&] {
+            LevelUpdate batch[256];
+            while (!done.load(std::memory_order_acquire) || !feed.empty()) {
+                size_t n = feed.tryPopBatch(batch, 256);
+                if (n == 0) std::this_thread::yield();
+                updates += n;
+            }
+        });
+        double feedSeconds = timeBook(feedBook, orders);
+        done = true;
+        consumer.join();
+        
+        std::cout << "\n=== Market Data Publication ===\n";
+        std::cout << "No consumer: " << numOrders / quietSeconds << " orders/sec\n";
+        std::cout << "BBO polling: " << numOrders / pollSeconds << " orders/sec ("
+                  << polls / pollSeconds << " top-of-book reads/sec)\n";
+        std::cout << "Depth feed: " << numOrders / feedSeconds << " orders/sec ("
+                  << updates << " level updates, " << feedBook.getDroppedDepthUpdates()
+                  << " dropped)\n";
+        DepthSnapshot snapshot = feedBook.getDepthSnapshot(5);
+        std::cout << "Snapshot at sequence " << snapshot.sequence << ": "
+                  << snapshot.bids.size() << " bid and " << snapshot.asks.size() << " ask levels\n";
+    }
+    
+    void runExecutionReportTest(int numOrders) {
+        std::cout << "\nRunning execution report test with " << numOrders << " orders...\n";
+        std::vector<Order> orders;
+        orders.reserve(numOrders);
+        for (int i = 0; i < numOrders; ++i) orders.push_back(generateLimitOrder());
+        const std::string path = "../data/performance_fills.log";
+        
+        // Per-order latency and total time for one book
+        auto timeOrders = [&](OrderBook& book, std::vector<double>& latencies) {
+            latencies.reserve(orders.size());
+            auto begin = std::chrono::high_resolution_clock::now();
+            for (const auto& order : orders) {
+                auto start = std::chrono::high_resolution_clock::now();
+                book.addOrder(order);
+                latencies.push_back(std::chrono::duration<double, std::nano>(
+                    std::chrono::high_resolution_clock::now() - start).count());
+            }
+            std::sort(latencies.begin(), latencies.end());
+            return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+        };
+        
+        // Formatting and a flushing log write per fill, under the book lock
+        std::vector<double> callbackLatencies;
+        double callbackSeconds;
+        {
+            std::remove(path.c_str());
+            Logger fills(path, LogMode::SYNC);
+            OrderBook book;
+            book.setTradeCallback([&fills](const Order& buy, const Order& sell, double price, uint32_t qty) {
+                fills.logTrade("Trade: " + std::to_string(buy.orderId) + " " + std::to_string(sell.orderId) +
+                               " " + std::to_string(price) + " " + std::to_string(qty));
+            });
+            callbackSeconds = timeOrders(book, callbackLatencies);
+        }
+        
+        // Fixed-size reports into a ring; a consumer thread does the same logging
+        std::vector<double> feedLatencies;
+        double feedSeconds;
+        uint64_t reported = 0;
+        uint64_t dropped;
+        {
+            std::remove(path.c_str());
+            Logger fills(path, LogMode::SYNC);
+            OrderBook book;
+            // Sized for the whole burst: a flushing logger drains slower
+            // than the book fills, and the feed absorbs the difference
+            ExecutionFeed feed(1 << 18);
+            book.setExecutionFeed(&feed);
+            std::atomic<bool> done{false};
+            std::thread consumer([&] {
+                ExecutionReport batch[256];
+                while (!done.load(std::memory_order_acquire) || !feed.empty()) {
+                    size_t n = feed.tryPopBatch(batch, 256);
+                    if (n == 0) std::this_thread::yield();
+                    for (size_t i = 0; i < n; ++i) {
+                        fills.logTrade(batch[i].buyOrderId, batch[i].sellOrderId, batch[i].price, batch[i].qty);
+                    }
+                    reported += n;
+                }
+            });
+            feedSeconds = timeOrders(book, feedLatencies);
+            done = true;
+            consumer.join();
+            dropped = book.getDroppedExecutionReports();
+        }
+        std::remove(path.c_str());
+        
+        auto percentile = [](const std::vector<double>& sorted, double p) {
+            return sorted[static_cast<size_t>(sorted.size() * p)];
+        };
+        std::cout << "\n=== Fill Delivery ===\n";
+        std::cout << "Logging trade callback: " << numOrders / callbackSeconds << " orders/sec, p50 "
+                  << percentile(callbackLatencies, 0.5) << " ns, p99 " << percentile(callbackLatencies, 0.99)
+                  << " ns, max " << callbackLatencies.back() << " ns\n";
+        std::cout << "Execution feed: " << numOrders / feedSeconds << " orders/sec, p50 "
+                  << percentile(feedLatencies, 0.5) << " ns, p99 " << percentile(feedLatencies, 0.99)
+                  << " ns, max " << feedLatencies.back() << " ns (" << reported << " reports, "
+                  << dropped << " dropped)\n";
+    }
+    
+    void runShardedTest(int numOrders) {
+        std::cout << "\nRunning sharded matcher test with " << numOrders << " orders...\n";
+        const std::vector<std::string> symbols = {"AAPL", "GOOGL", "MSFT", "TSLA", "AMZN"};
+        std::uniform_int_distribution<size_t> symbolDist(0, symbols.size() - 1);
+        
+        std::vector<Order> orders;
+        orders.reserve(numOrders);
+        for (int i = 0; i < numOrders; ++i) {
+            Order order = generateLimitOrder();
+            order.symbol = symbols[symbolDist(rng_)];
+            orders.push_back(order);
+        }
+        
+        std::cout << "\n=== Sharded Matcher Throughput ===\n";
+        for (size_t shards : {1, 2, 4}) {
+            BookRegistry books;
+            ShardedMatcher matcher(books, logger_, shards);
+            auto start = std::chrono::high_resolution_clock::now();
+            matcher.start();
+            for (size_t i = 0; i < orders.size(); i += 256) {
+                auto last = std::min(orders.size(), i + 256);
+                matcher.submitBatch(std::vector<Order>(orders.begin() + i, orders.begin() + last));
+            }
+            matcher.stop();
+            auto end = std::chrono::high_resolution_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << shards << " shard(s): " << matcher.getProcessedOrders() / seconds
+                      << " orders/sec, " << books.getTotalTrades() << " trades\n";
+        }
+    }
+    
+    void runLoggingTest(int numEvents) {
+        std::cout << "\nRunning logging test with " << numEvents << " trade events...\n";
+        std::cout << "\n=== Logger Cost Per Event (calling thread) ===\n";
+        const std::pair<LogMode, const char*> modes[] = {
+            {LogMode::SYNC, "sync text"},
+            {LogMode::ASYNC_TEXT, "async text"},
+            {LogMode::ASYNC_BINARY, "async binary"}
+        };
+        // Events go out in bursts that fit the per-thread buffer, with a pause
+        // between bursts so the writer keeps up; only the bursts are timed
+        const int burst = 4096;
+        for (const auto& mode : modes) {
+            std::string path = mode.first == LogMode::ASYNC_BINARY
+                ? "../data/performance_log_bench.bin" : "../data/performance_log_bench.log";
+            std::remove(path.c_str());
+            Logger logger(path, mode.first);
+            logger.logTrade(0, 0, 100.25, 10);
+            double nanos = 0;
+            for (int done = 0; done < numEvents; done += burst) {
+                auto start = std::chrono::high_resolution_clock::now();
+                for (int i = done; i < done + burst; ++i) {
+                    logger.logTrade(i, i + 1, 100.25, 10);
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+                nanos += std::chrono::duration<double, std::nano>(end - start).count();
+                if (mode.first != LogMode::SYNC) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            int total = (numEvents + burst - 1) / burst * burst;
+            std::cout << mode.second << ": " << nanos / total << " ns/event";
+            if (logger.getDroppedRecords()) std::cout << " (" << logger.getDroppedRecords() << " dropped)";
+            std::cout << "\n";
+        }
+        std::remove("../data/performance_log_bench.log");
+        std::remove("../data/performance_log_bench.bin");
+    }
+    
+    void runJournalTest(int numMessages) {
+        std::cout << "\nRunning journal test with " << numMessages << " messages...\n";
+        const std::string path = "../data/performance_journal.jrnl";
+        std::remove(path.c_str());
+        
+        // 70% new limits, 20% cancels and 10% modifies of recent orders
+        std::vector<CompactOrder> flow;
+        flow.reserve(numMessages);
+        uint32_t symbolId = SymbolTable::instance().intern("PERF");
+        std::uniform_int_distribution<> kind(0, 9);
+        std::uniform_int_distribution<uint64_t> back(1, 1000);
+        uint64_t firstId = orderIdCounter_;
+        while (flow.size() < static_cast<size_t>(numMessages)) {
+            int k = kind(rng_);
+            uint64_t target = orderIdCounter_ - std::min(back(rng_), orderIdCounter_ - firstId + 1);
+            if (k < 2 && orderIdCounter_ > firstId) {
+                flow.push_back(CompactOrder::makeCancel(target, symbolId));
+            } else if (k < 3 && orderIdCounter_ > firstId) {
+                flow.push_back(CompactOrder::makeModify(target, symbolId, 9900 + back(rng_) % 200, 500));
+            } else {
+                flow.push_back(CompactOrder::fromOrder(generateLimitOrder()));
+            }
+        }
+        
+        // Write in matcher-sized batches, one fdatasync per batch
+        auto start = std::chrono::high_resolution_clock::now();
+        uint64_t syncs;
+        {
+            JournalWriter journal(path);
+            for (size_t i = 0; i < flow.size(); i += 1024) {
+                journal.append(flow.data() + i, std::min<size_t>(1024, flow.size() - i));
+            }
+            syncs = journal.getSyncCount();
+        }
+        double writeSeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        
+        start = std::chrono::high_resolution_clock::now();
+        size_t decoded = 0;
+        {
+            JournalReader reader(path);
+            CompactOrder order;
+            while (reader.next(order)) decoded++;
+        }
+        double readSeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        
+        OrderBook recovered;
+        start = std::chrono::high_resolution_clock::now();
+        size_t replayed = JournalReader(path).replay(recovered);
+        double replaySeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        std::remove(path.c_str());
+        
+        std::cout << "\n=== Journal ===\n";
+        std::cout << "Write: " << numMessages / writeSeconds << " msgs/sec (" << syncs << " fdatasyncs)\n";
+        std::cout << "Read: " << decoded / readSeconds << " msgs/sec\n";
+        std::cout << "Recovery replay: " << replayed / replaySeconds << " msgs/sec, "
+                  << recovered.getTotalTrades() << " trades\n";
+    }
+    
+    void runSnapshotTest(int numOrders) {
+        std::cout << "\nRunning snapshot test with " << numOrders << " resting orders...\n";
+        const std::string snapshotPath = "../data/performance_snapshot.snap";
+        const std::string journalPath = "../data/performance_snapshot.jrnl";
+        std::remove(journalPath.c_str());
+        
+        // Non-crossing limits over 2000 levels, a few hundred orders deep each
+        std::vector<CompactOrder> flow;
+        flow.reserve(numOrders);
+        uint32_t symbolId = SymbolTable::instance().intern("PERF");
+        std::uniform_int_distribution<int> level(0, 999);
+        std::uniform_int_distribution<uint32_t> qty(1, 1000);
+        for (int i = 0; i < numOrders; ++i) {
+            bool buy = i % 2 == 0;
+            int64_t tick = buy ? 9999 - level(rng_) : 10001 + level(rng_);
+            Order order(orderIdCounter_++, 1, "PERF", OrderType::LIMIT,
+                        buy ? OrderSide::BUY : OrderSide::SELL, tick / 100.0, qty(rng_));
+            flow.push_back(CompactOrder::fromOrder(order));
+            flow.back().symbolId = symbolId;
+        }
+        OrderBook book(numOrders);
+        book.addOrders(flow.data(), flow.size());
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        SnapshotWriter::write(snapshotPath, book, flow.size());
+        double writeSeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        
+        // Matching only stalls for the fork; the child writes in parallel
+        BackgroundSnapshot background;
+        start = std::chrono::high_resolution_clock::now();
+        background.start(snapshotPath, book, flow.size());
+        double forkMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        background.wait();
+        double backgroundSeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        
+        OrderBook loaded(numOrders);
+        start = std::chrono::high_resolution_clock::now();
+        size_t restored = SnapshotReader(snapshotPath).load(loaded);
+        double loadSeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        
+        // The same book rebuilt from its journal instead
+        {
+            JournalConfig config;
+            config.sync = false;
+            JournalWriter journal(journalPath, config);
+            for (size_t i = 0; i < flow.size(); i += 1024) {
+                journal.append(flow.data() + i, std::min<size_t>(1024, flow.size() - i));
+            }
+        }
+        OrderBook replayed(numOrders);
+        start = std::chrono::high_resolution_clock::now();
+        JournalReader(journalPath).replay(replayed);
+        double replaySeconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        std::remove(snapshotPath.c_str());
+        std::remove(journalPath.c_str());
+        
+        std::cout << "\n=== Snapshots ===\n";
+        std::cout << "Write: " << writeSeconds * 1000 << " ms (" << numOrders / writeSeconds << " orders/sec)\n";
+        std::cout << "Background: " << forkMs << " ms matching stall for the fork, "
+                  << backgroundSeconds * 1000 << " ms until on disk\n";
+        std::cout << "Load: " << loadSeconds * 1000 << " ms for " << restored << " resting orders ("
+                  << restored / loadSeconds << " orders/sec)\n";
+        std::cout << "Journal replay of the same book: " << replaySeconds * 1000 << " ms\n";
+    }
+    
+    void runFileReplayTest(int numLines) {
+        std::cout << "\nRunning file replay test with " << numLines << " orders...\n";
+        const std::string textPath = "../data/performance_replay.json";
+        const std::string binaryPath = "../data/performance_replay.bin";
+        {
+            std::ofstream out(textPath);
+            WireEncoder encoder;
+            encoder.writeFileHeader();
+            for (int i = 0; i < numLines; ++i) {
+                Order order = generateLimitOrder();
+                out << "{\"orderId\":" << order.orderId << ",\"symbol\":\"AAPL\",\"type\":\"LIMIT\""
+                    << ",\"side\":\"" << (order.side == OrderSide::BUY ? "BUY" : "SELL") << "\""
+                    << ",\"price\":" << order.price << ",\"quantity\":" << order.quantity << "}\n";
+                encoder.encodeNewOrder(order);
+            }
+            std::ofstream binary(binaryPath, std::ios::binary);
+            binary.write(encoder.buffer().data(), static_cast<std::streamsize>(encoder.size()));
+        }
+        
+        auto replay = [](DataFeed& feed, const std::string& path) {
+            feed.connect(path);
+            auto start = std::chrono::high_resolution_clock::now();
+            feed.start();
+            feed.wait();
+            auto end = std::chrono::high_resolution_clock::now();
+            feed.disconnect();
+            return std::chrono::duration<double>(end - start).count();
+        };
+        
+        // Text: mmap replay plus the allocation-free parser
+        DataFeed textFeed;
+        OrderParser parser;
+        Order parsed;
+        uint64_t textOrders = 0;
+        textFeed.setLineHandler([&](std::string_view line) {
+            if (parser.parse(line, parsed) == ParseError::OK) textOrders++;
+        });
+        double textSeconds = replay(textFeed, textPath);
+        
+        // Binary: messages map straight onto CompactOrder
+        DataFeed binaryFeed;
+        SymbolCache symbols;
+        uint64_t binaryOrders = 0;
+        binaryFeed.setWireHandler([&](const WireMessage& message) {
+            if (message.type == WireType::NEW_ORDER &&
+                WireDecoder::toCompactOrder(message.newOrder, symbols).isValid()) binaryOrders++;
+        });
+        double binarySeconds = replay(binaryFeed, binaryPath);
+        
+        std::ifstream textFile(textPath, std::ios::ate | std::ios::binary);
+        std::ifstream binaryFile(binaryPath, std::ios::ate | std::ios::binary);
+        double textMb = textFile.tellg() / (1024.0 * 1024.0);
+        double binaryMb = binaryFile.tellg() / (1024.0 * 1024.0);
+        std::remove(textPath.c_str());
+        std::remove(binaryPath.c_str());
+        
+        std::cout << "\n=== File Replay (mmap, as fast as possible) ===\n";
+        std::cout << "JSON lines: " << textOrders / textSeconds << " orders/sec, "
+                  << textMb << " MB on disk\n";
+        std::cout << "Binary wire: " << binaryOrders / binarySeconds << " orders/sec, "
+                  << binaryMb << " MB on disk\n";
+    }
+    
+    void runParserBenchmark(const std::string& path, int iterations) {
+        std::cout << "\nRunning parser benchmark on " << path << "...\n";
+        std::ifstream in(path);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::vector<std::string> messages;
+        for (size_t pos = contents.find('{'); pos != std::string::npos; pos = contents.find('{', pos)) {
+            size_t end = contents.find('}', pos);
+            if (end == std::string::npos) break;
+            messages.push_back(contents.substr(pos, end - pos + 1));
+            pos = end + 1;
+        }
+        if (messages.empty()) {
+            std::cout << "No orders found in " << path << "\n";
+            return;
+        }
+        
+        OrderParser parser;
+        uint64_t checksum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (const auto& message : messages) {
+                checksum += parser.parseJson(message).quantity;
+            }
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        Order order;
+        for (int i = 0; i < iterations; ++i) {
+            for (const auto& message : messages) {
+                if (parser.parseJson(std::string_view(message), order) == ParseError::OK) checksum += order.quantity;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        double total = static_cast<double>(iterations) * messages.size();
+        double legacyNs = std::chrono::duration<double, std::nano>(mid - start).count() / total;
+        double fastNs = std::chrono::duration<double, std::nano>(end - mid).count() / total;
+        std::cout << "\n=== JSON Parser (" << messages.size() << " orders x " << iterations << ") ===\n";
+        std::cout << "Legacy parseJson: " << legacyNs << " ns/order\n";
+        std::cout << "string_view parseJson: " << fastNs << " ns/order\n";
+        std::cout << "Speedup: " << legacyNs / fastNs << "x (checksum " << checksum << ")\n";
+    }
+    
+    void runBulkDecodeTest(int numLines) {
+        std::cout << "\nRunning bulk decode test with " << numLines << " lines per format...\n";
+        const char* symbols[] = {"AAPL", "GOOGL", "MSFT", "TSLA", "AMZN"};
+        std::string json, csv;
+        char line[256];
+        for (int i = 0; i < numLines; ++i) {
+            Order order = generateLimitOrder();
+            const char* side = order.side == OrderSide::BUY ? "BUY" : "SELL";
+            // Same shape as scripts/stress_test.py's line-delimited output
+            snprintf(line, sizeof(line),
+                     "{\"orderId\": %llu, \"clientId\": %d, \"symbol\": \"%s\", \"type\": \"LIMIT\", "
+                     "\"side\": \"%s\", \"price\": %.2f, \"quantity\": %u, \"timestamp\": 1700000000.%06d}\n",
+                     static_cast<unsigned long long>(order.orderId), 1 + i % 1000, symbols[i % 5],
+                     side, order.price, order.quantity, i % 1000000);
+            json += line;
+            snprintf(line, sizeof(line), "%llu,%s,LIMIT,%s,%.2f,%u,%d\n",
+                     static_cast<unsigned long long>(order.orderId), symbols[i % 5], side,
+                     order.price, order.quantity, 1 + i % 1000);
+            csv += line;
+        }
+        
+        std::cout << "\n=== Bulk Decoder Throughput (MB/s) ===\n";
+        const std::pair<const char*, const std::string*> inputs[] = {{"JSON", &json}, {"CSV", &csv}};
+        for (const auto& input : inputs) {
+            const std::string& text = *input.second;
+            OrderParser parser;
+            Order order;
+            auto start = std::chrono::high_resolution_clock::now();
+            size_t pos = 0;
+            while (pos < text.size()) {
+                size_t end = text.find('\n', pos);
+                parser.parse(std::string_view(text.data() + pos, end - pos), order);
+                pos = end + 1;
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double mb = text.size() / (1024.0 * 1024.0);
+            std::cout << input.first << " OrderParser per line: "
+                      << mb / std::chrono::duration<double>(end - start).count() << "\n";
+            
+            for (auto isa : {BulkDecoder::Isa::SCALAR, BulkDecoder::Isa::SSE2, BulkDecoder::Isa::AVX2}) {
+                BulkDecoder decoder(isa);
+                if (decoder.getIsa() != isa) continue;
+                OrderBatch batch;
+                batch.reserve(numLines);
+                start = std::chrono::high_resolution_clock::now();
+                decoder.decode(text, batch);
+                end = std::chrono::high_resolution_clock::now();
+                std::cout << input.first << " BulkDecoder " << BulkDecoder::isaName(isa) << ": "
+                          << mb / std::chrono::duration<double>(end - start).count()
+                          << " (" << batch.size() << " orders)\n";
+            }
+        }
+    }
+    
+    void runPerformanceTest(int numOrders) {
+        std::cout << "Starting performance test with " << numOrders << " orders...\n";
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        for (int i = 0; i < numOrders; ++i) {
+            Order order = generateRandomOrder();
+            book_.addOrder(order);
+        }
+        
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        
+        double seconds = duration.count() / 1000000.0;
+        double ordersPerSecond = numOrders / seconds;
+        double avgLatencyMicros = duration.count() / (double)numOrders;
+        
+        std::cout << "\n=== Performance Results ===\n";
+        std::cout << "Total Orders: " << numOrders << "\n";
+        std::cout << "Total Time: " << seconds << " seconds\n";
+        std::cout << "Orders/Second: " << ordersPerSecond << "\n";
+        std::cout << "Average Latency: " << avgLatencyMicros << " microseconds\n";
+        std::cout << "Total Trades: " << book_.getTotalTrades() << "\n";
+        std::cout << "Best Bid: " << book_.getBestBid() << "\n";
+        std::cout << "Best Ask: " << book_.getBestAsk() << "\n";
+        std::cout << "Pool High-Water Mark: " << book_.getPoolStats().highWaterMark << " orders\n";
+        
+        if (ordersPerSecond >= 10000) {
+            std::cout << "TARGET ACHIEVED: 10,000+ orders/sec!\n";
+        } else {
+            std::cout << "Target not reached, but performance is: " << ordersPerSecond << " orders/sec\n";
+        }
+        
+        if (avgLatencyMicros < 1000) {
+            std::cout << "SUB-MILLISECOND LATENCY ACHIEVED!\n";
+        } else {
+            std::cout << "Latency is: " << avgLatencyMicros << " microseconds\n";
+        }
+    }
+    
+    void runLatencyTest(int numOrders = 1000) {
+        std::cout << "\nRunning latency test...\n";
+        std::vector<double> latencies, limitLatencies, marketLatencies;
+        
+        for (int i = 0; i < numOrders; ++i) {
+            Order order = generateRandomOrder();
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            book_.addOrder(order);
+            auto end = std::chrono::high_resolution_clock::now();
+            
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            latencies.push_back(latency.count());
+            (order.type == OrderType::MARKET ? marketLatencies : limitLatencies).push_back(latency.count());
+        }
+        
+        // Calculate statistics
+        std::sort(latencies.begin(), latencies.end());
+        double min_lat = latencies.front();
+        double max_lat = latencies.back();
+        double avg_lat = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+        double p50 = latencies[latencies.size() * 0.5];
+        double p95 = latencies[latencies.size() * 0.95];
+        double p99 = latencies[latencies.size() * 0.99];
+        
+        std::cout << "\n=== Latency Statistics (nanoseconds) ===\n";
+        std::cout << "Min: " << min_lat << " ns\n";
+        std::cout << "Average: " << avg_lat << " ns\n";
+        std::cout << "P50 (median): " << p50 << " ns\n";
+        std::cout << "P95: " << p95 << " ns\n";
+        std::cout << "P99: " << p99 << " ns\n";
+        std::cout << "Max: " << max_lat << " ns\n";
+        
+        std::cout << "\n=== Latency Statistics (microseconds) ===\n";
+        std::cout << "Min: " << min_lat/1000 << " μs\n";
+        std::cout << "Average: " << avg_lat/1000 << " μs\n";
+        std::cout << "P50 (median): " << p50/1000 << " μs\n";
+        std::cout << "P95: " << p95/1000 << " μs\n";
+        std::cout << "P99: " << p99/1000 << " μs\n";
+        std::cout << "Max: " << max_lat/1000 << " μs\n";
+        
+        std::cout << "\n=== Latency by Order Type (nanoseconds) ===\n";
+        printLatencySeries("LIMIT", limitLatencies);
+        printLatencySeries("MARKET", marketLatencies);
+        
+        // The book's own always-on histograms cover the same orders, timed
+        // inside the lock
+        BookLatencyStats stats = book_.getLatencyStats();
+        std::cout << "\n=== Built-in Book Histograms ===\n";
+        std::cout << "Service ns: " << stats.service.summary() << "\n";
+        std::cout << "Match depth: " << stats.matchDepth.summary() << "\n";
+    }
+    
+    // Cost of the always-on instrumentation: a clock read plus a record is
+    // paid per order on the hot path
+    void runHistogramOverheadTest(int numRecords) {
+        std::cout << "\nRunning latency histogram overhead test with " << numRecords << " records...\n";
+        LatencyHistogram histogram;
+        std::uniform_int_distribution<uint64_t> valueDist(50, 50000);
+        std::vector<uint64_t> values(4096);
+        for (auto& v : values) v = valueDist(rng_);
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < numRecords; ++i) histogram.record(values[i & 4095]);
+        auto mid = std::chrono::high_resolution_clock::now();
+        uint64_t sink = 0;
+        for (int i = 0; i < numRecords; ++i) sink += LatencyHistogram::now();
+        auto end = std::chrono::high_resolution_clock::now();
+        LatencySnapshot snapshot = histogram.snapshot();
+        auto taken = std::chrono::high_resolution_clock::now();
+        
+        double recordNs = std::chrono::duration<double, std::nano>(mid - start).count() / numRecords;
+        double clockNs = std::chrono::duration<double, std::nano>(end - mid).count() / numRecords;
+        double snapshotUs = std::chrono::duration<double, std::micro>(taken - end).count();
+        std::cout << "record(): " << recordNs << " ns, now(): " << clockNs << " ns"
+                  << " (checksum " << (sink & 1) << ")\n";
+        std::cout << "snapshot(): " << snapshotUs << " us for " << snapshot.count << " samples, "
+                  << sizeof(LatencyHistogram) << " bytes per histogram\n";
+    }
+};
+
+int main() {
+    std::cout << "OBME Core Performance Test Suite\n";
+    std::cout << "========================================\n";
+    
+    PerformanceTester tester;
+    
+    // Test different scales
+    std::vector<int> testSizes = {1000, 5000, 10000, 25000, 50000};
+    
+    for (int size : testSizes) {
+        tester.runPerformanceTest(size);
+        std::cout << "\n";
+    }
+    
+    // Detailed latency analysis
+    tester.runLatencyTest(10000);
+    
+    // What the always-on latency histograms cost per order
+    tester.runHistogramOverheadTest(10000000);
+    
+    // Cancels from random positions in a deep level
+    tester.runCancelTest(50000);
+    
+    // New, cancel and modify through the batch ingress path
+    tester.runMessageTypeLatency(200000);
+    
+    // Trigger books: pending stops must not slow normal matching
+    tester.runStopTriggerTest(10000);
+    
+    // Iceberg replenishment cost against the same plain flow
+    tester.runIcebergTest(200000);
+    
+    // Level deltas vs polling the top of book
+    tester.runDepthFeedTest(200000);
+    
+    // Fills through a logging callback vs the execution report ring
+    tester.runExecutionReportTest(200000);
+    
+    // Multi-symbol flow across symbol shards
+    tester.runShardedTest(200000);
+    
+    // Hot-path logging cost, sync vs async
+    tester.runLoggingTest(100000);
+    
+    // Write-ahead journal and crash recovery replay
+    tester.runJournalTest(1000000);
+    
+    // Startup from a snapshot instead of the full journal
+    tester.runSnapshotTest(1000000);
+    
+    // Zero-copy file ingestion
+    tester.runFileReplayTest(500000);
+    
+    // Order parsing, legacy vs string_view fast path
+    tester.runParserBenchmark("../data/sample_orders.json", 20000);
+    
+    // Columnar bulk decoding of line-delimited orders
+    tester.runBulkDecodeTest(200000);
+    
+    // Book backend comparison
+    tester.runBackendComparison(100000);
+    
+    std::cout << "\nPerformance Goals Status:\n";
+    std::cout << "High-performance C++ order book: IMPLEMENTED\n";
+    std::cout << "Price-time priority matching: IMPLEMENTED\n";
+    std::cout << "Thread-safe order handling: IMPLEMENTED\n";
+    std::cout << "Custom bid/ask queues: IMPLEMENTED\n";
+    std::cout << "Robust logging system: IMPLEMENTED\n";
+    std::cout << "Trade execution tracking: IMPLEMENTED\n";
+    
+    return 0;
+}
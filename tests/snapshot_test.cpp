@@ -0,0 +1,247 @@
+#include "../src/io/Snapshot.h"
+#include "../src/engine/Matcher.h"
+#include "../src/engine/SymbolTable.h"
+#include "test_flow.h"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+static const char* SNAPSHOT_PATH = "snapshot_test.snap";
+static const char* JOURNAL_PATH = "snapshot_test.jrnl";
+
+using Resting = std::tuple<uint64_t, int, double, double, uint32_t, uint32_t, uint32_t, int>;
+
+// Everything a restore must reproduce, in queue order
+static std::vector<Resting> restingOf(const OrderBook& book) {
+    std::vector<Resting> out;
+    book.forEachResting([&out](const Order& o) {
+        out.emplace_back(o.orderId, static_cast<int>(o.side), o.price, o.stopPrice, o.quantity,
+                         o.remainingQty, o.visibleQty, static_cast<int>(o.type));
+    });
+    return out;
+}
+
+static void removeJournal() {
+    for (const auto& path : JournalWriter::listFiles(JOURNAL_PATH)) std::remove(path.c_str());
+}
+
+// Several orders per level on both sides, a half-eaten iceberg slice and
+// pending stops on both sides
+static void buildBook(OrderBook& book) {
+    for (uint64_t id = 1; id <= 6; ++id) {
+        book.addOrder(Order(id, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 99.0 + (id % 3) * 0.5, 10 * id));
+        book.addOrder(Order(100 + id, 2, "AAPL", OrderType::LIMIT, OrderSide::SELL, 101.0 + (id % 3) * 0.5, 10 * id));
+    }
+    Order iceberg(50, 3, "AAPL", OrderType::LIMIT, OrderSide::SELL, 100.5, 100);
+    iceberg.displayQty = 20;
+    book.addOrder(iceberg);
+    book.addOrder(Order(51, 4, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.5, 7));
+    book.addOrder(Order(60, 5, "AAPL", OrderType::STOP, OrderSide::BUY, 0.0, 15, 101.0));
+    book.addOrder(Order(61, 5, "AAPL", OrderType::STOP_LIMIT, OrderSide::SELL, 98.5, 25, 99.0));
+    book.addOrder(Order(62, 5, "AAPL", OrderType::STOP, OrderSide::SELL, 0.0, 5, 99.0));
+}
+
+// Sweeps through the iceberg and both sides so every stop fires
+static void followUp(OrderBook& book) {
+    book.addOrder(Order(200, 6, "AAPL", OrderType::LIMIT, OrderSide::BUY, 101.0, 150));
+    book.addOrder(Order(201, 6, "AAPL", OrderType::MARKET, OrderSide::SELL, 0.0, 200));
+    book.addOrder(Order(202, 6, "AAPL", OrderType::LIMIT, OrderSide::BUY, 102.0, 60));
+}
+
+void test_round_trip_rebuilds_book() {
+    OrderBook book;
+    buildBook(book);
+    assert(book.getLastTradePrice() == 100.5 && book.getPendingStops() == 3);
+    SnapshotWriter::write(SNAPSHOT_PATH, book, 42);
+
+    OrderBook loaded;
+    SnapshotReader reader(SNAPSHOT_PATH);
+    assert(reader.getSequence() == 42);
+    assert(reader.load(loaded) == restingOf(book).size());
+    assert(restingOf(loaded) == restingOf(book));
+    assert(loaded.getLastTradePrice() == book.getLastTradePrice());
+    assert(loaded.getPendingStops() == book.getPendingStops());
+    DepthSnapshot expected = book.getDepthSnapshot(10);
+    DepthSnapshot actual = loaded.getDepthSnapshot(10);
+    assert(actual.bids.size() == expected.bids.size() && actual.asks.size() == expected.asks.size());
+    for (size_t i = 0; i < expected.asks.size(); ++i) {
+        assert(actual.asks[i].price == expected.asks[i].price && actual.asks[i].qty == expected.asks[i].qty);
+        assert(actual.asks[i].orderCount == expected.asks[i].orderCount);
+    }
+
+    // Queue positions, the iceberg's slice and the stops all behave the same
+    std::vector<std::vector<uint64_t>> original, restored;
+    recordTrades(book, original);
+    recordTrades(loaded, restored);
+    followUp(book);
+    followUp(loaded);
+    assert(!original.empty() && restored == original);
+    assert(restingOf(loaded) == restingOf(book));
+    std::remove(SNAPSHOT_PATH);
+    std::cout << "test_round_trip_rebuilds_book passed (" << original.size() << " trades)\n";
+}
+
+void test_background_snapshot_is_point_in_time() {
+    OrderBook book;
+    buildBook(book);
+    auto before = restingOf(book);
+    BackgroundSnapshot snapshot;
+    assert(snapshot.start(SNAPSHOT_PATH, book, 7));
+    // The parent keeps changing the book while the child writes
+    followUp(book);
+    book.cancelOrder(1);
+    assert(restingOf(book) != before);
+    assert(snapshot.wait());
+    assert(!snapshot.running() && !snapshot.poll());
+
+    OrderBook loaded;
+    SnapshotReader reader(SNAPSHOT_PATH);
+    reader.load(loaded);
+    assert(reader.getSequence() == 7);
+    assert(restingOf(loaded) == before);
+    std::remove(SNAPSHOT_PATH);
+    std::cout << "test_background_snapshot_is_point_in_time passed\n";
+}
+
+void test_periodic_snapshots_and_recovery() {
+    std::remove(SNAPSHOT_PATH);
+    removeJournal();
+    auto flow = makeFlow(20000, 11, true);
+    BookRegistry live;
+    {
+        JournalConfig journalConfig;
+        journalConfig.preallocateBytes = 256 * 1024;
+        JournalWriter journal(JOURNAL_PATH, journalConfig);
+        Logger logger("snapshot_test.log");
+        MatcherConfig config;
+        config.ingress = IngressMode::SPSC_RING;
+        config.maxBatch = 300;
+        config.journal = &journal;
+        config.snapshotPath = SNAPSHOT_PATH;
+        config.snapshotInterval = 3000;
+        Matcher matcher(live, logger, config);
+        matcher.start();
+        for (size_t i = 0; i < flow.size(); i += 97) {
+            matcher.submitBatch(flow.data() + i, std::min<size_t>(97, flow.size() - i));
+        }
+        matcher.stop();
+        // Every closed segment is covered by the last snapshot and deleted
+        assert(journal.getLastSequence() == flow.size());
+        assert(journal.getBaseSequence() >= 3000);
+        assert(journal.getSegmentCount() == 0);
+        assert(JournalWriter::listFiles(JOURNAL_PATH).size() == 1);
+        assert(SnapshotReader(SNAPSHOT_PATH).getSequence() == journal.getBaseSequence());
+    }
+
+    BookRegistry recovered;
+    assert(recoverBooks(recovered, SNAPSHOT_PATH, JOURNAL_PATH) == flow.size());
+    assert(recovered.size() == live.size());
+    live.forEachBook([&recovered](uint32_t symbolId, const OrderBook& book) {
+        const OrderBook* other = recovered.findBook(symbolId);
+        assert(other && restingOf(*other) == restingOf(book));
+        assert(other->getLastTradePrice() == book.getLastTradePrice());
+    });
+    std::remove(SNAPSHOT_PATH);
+    removeJournal();
+    std::remove("snapshot_test.log");
+    std::cout << "test_periodic_snapshots_and_recovery passed\n";
+}
+
+// A snapshot that cannot be written costs disk, not the engine: matching
+// goes on, the journal keeps every segment, and recovery replays them all
+void test_failed_snapshots_keep_matching() {
+    const char* badPath = "no_such_directory/snapshot_test.snap";
+    removeJournal();
+    auto flow = makeFlow(10000, 11, true);
+    BookRegistry live;
+    {
+        JournalConfig journalConfig;
+        journalConfig.preallocateBytes = 256 * 1024;
+        JournalWriter journal(JOURNAL_PATH, journalConfig);
+        Logger logger("snapshot_test.log");
+        MatcherConfig config;
+        config.ingress = IngressMode::SPSC_RING;
+        config.maxBatch = 300;
+        config.journal = &journal;
+        config.snapshotPath = badPath;
+        config.snapshotInterval = 3000;
+        Matcher matcher(live, logger, config);
+        matcher.start();
+        for (size_t i = 0; i < flow.size(); i += 97) {
+            matcher.submitBatch(flow.data() + i, std::min<size_t>(97, flow.size() - i));
+        }
+        matcher.stop();
+        assert(!matcher.isHalted());
+        assert(matcher.getProcessedOrders() == flow.size());
+        assert(matcher.getSnapshotFailures() >= 2);
+        assert(journal.getSegmentCount() == matcher.getSnapshotFailures());
+    }
+
+    BookRegistry recovered;
+    assert(recoverBooks(recovered, badPath, JOURNAL_PATH) == flow.size());
+    live.forEachBook([&recovered](uint32_t symbolId, const OrderBook& book) {
+        const OrderBook* other = recovered.findBook(symbolId);
+        assert(other && restingOf(*other) == restingOf(book));
+    });
+    removeJournal();
+    std::remove("snapshot_test.log");
+    std::cout << "test_failed_snapshots_keep_matching passed\n";
+}
+
+// A crash after rotating but before the next snapshot finished: recovery
+// starts from the older snapshot and reads on through the closed segment
+void test_recovery_across_segments() {
+    std::remove(SNAPSHOT_PATH);
+    removeJournal();
+    auto flow = makeFlow(150, 11, true);
+    OrderBook expected;
+    {
+        JournalWriter journal(JOURNAL_PATH);
+        journal.append(flow.data(), 60);
+        expected.addOrders(flow.data(), 60);
+        SnapshotWriter::write(SNAPSHOT_PATH, expected, journal.getLastSequence());
+        journal.append(flow.data() + 60, 40);
+        journal.rotate();
+        journal.append(flow.data() + 100, 50);
+        expected.addOrders(flow.data() + 60, 90);
+        assert(journal.getSegmentCount() == 1 && journal.getBaseSequence() == 100);
+    }
+    {
+        // Reopening finds the closed segment again
+        JournalWriter journal(JOURNAL_PATH);
+        assert(journal.getSegmentCount() == 1 && journal.getLastSequence() == 150);
+    }
+    OrderBook recovered;
+    assert(recoverBooks(recovered, SNAPSHOT_PATH, JOURNAL_PATH) == 150);
+    assert(restingOf(recovered) == restingOf(expected));
+
+    // Without the segment the snapshot and the active file no longer join up
+    {
+        JournalWriter journal(JOURNAL_PATH);
+        journal.dropThrough(100);
+        assert(journal.getSegmentCount() == 0);
+    }
+    bool threw = false;
+    try {
+        OrderBook book;
+        recoverBooks(book, SNAPSHOT_PATH, JOURNAL_PATH);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove(SNAPSHOT_PATH);
+    removeJournal();
+    std::cout << "test_recovery_across_segments passed\n";
+}
+
+int main() {
+    test_round_trip_rebuilds_book();
+    test_background_snapshot_is_point_in_time();
+    test_periodic_snapshots_and_recovery();
+    test_recovery_across_segments();
+    test_failed_snapshots_keep_matching();
+    std::cout << "All snapshot tests passed!\n";
+    return 0;
+}
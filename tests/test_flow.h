@@ -0,0 +1,49 @@
+#pragma once
+#include "../src/engine/CompactOrder.h"
+#include "../src/engine/Order.h"
+#include "../src/engine/SymbolTable.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Shared by the journal and snapshot tests: a reproducible mix of new
+// limits, markets, icebergs, cancels and modifies over two symbols, plus
+// stops when withStops is set
+inline std::vector<CompactOrder> makeFlow(size_t count, unsigned seed, bool withStops = false) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::uniform_int_distribution<int> tick(9900, 10100);
+    std::uniform_int_distribution<uint32_t> qty(1, 100);
+    uint32_t symbols[] = {SymbolTable::instance().intern("AAPL"), SymbolTable::instance().intern("MSFT")};
+    std::vector<CompactOrder> flow;
+    for (uint64_t id = 1; flow.size() < count; ++id) {
+        uint32_t symbolId = symbols[id % 2];
+        int k = kind(rng);
+        if (k == 0 && id > 10) {
+            flow.push_back(CompactOrder::makeCancel(id - 10, symbolId));
+            continue;
+        }
+        if (k == 1 && id > 10) {
+            flow.push_back(CompactOrder::makeModify(id - 10, symbolId, tick(rng), qty(rng)));
+            continue;
+        }
+        bool stop = withStops && k == 4;
+        OrderType type = k == 2 ? OrderType::MARKET : stop ? OrderType::STOP : OrderType::LIMIT;
+        double price = tick(rng) / 100.0;
+        uint32_t quantity = qty(rng);
+        Order order(id, 1, SymbolTable::instance().name(symbolId), type,
+                    id % 3 ? OrderSide::BUY : OrderSide::SELL, price, quantity, stop ? price : 0.0);
+        if (k == 3) order.displayQty = 5;
+        flow.push_back(CompactOrder::fromOrder(order));
+    }
+    return flow;
+}
+
+// Trades as (buy id, sell id, price in cents, qty), from an OrderBook or a
+// BookRegistry
+template<typename Books>
+void recordTrades(Books& books, std::vector<std::vector<uint64_t>>& out) {
+    books.setTradeCallback([&out](const Order& buy, const Order& sell, double price, uint32_t qty) {
+        out.push_back({buy.orderId, sell.orderId, static_cast<uint64_t>(price * 100 + 0.5), qty});
+    });
+}
@@ -0,0 +1,174 @@
+#include "../src/io/WireFormat.h"
+#include "../src/io/DataFeed.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+void test_round_trip() {
+    WireEncoder encoder;
+    Order order(42, 7, "AAPL", OrderType::STOP_LIMIT, OrderSide::SELL, 150.25, 300, 149.5);
+    order.remainingQty = 120;
+    order.timeInForce = TimeInForce::FOK;
+    order.displayQty = 25;
+    encoder.encodeNewOrder(order);
+    encoder.encodeCancel(42, "AAPL", 1000);
+    encoder.encodeModify(43, "MSFT", 301.75, 55, 2000);
+    encoder.encodeTrade(Trade{44, 45, 99.99, 10}, "GOOGL", 3000);
+    assert(encoder.size() == 64 + 32 + 48 + 56);
+
+    std::string_view bytes(encoder.buffer().data(), encoder.size());
+    WireDecoder decoder(bytes);
+    WireMessage message;
+
+    assert(decoder.next(message) == WireStatus::OK);
+    assert(message.type == WireType::NEW_ORDER);
+    assert(message.newOrder.orderId == 42 && message.newOrder.clientId == 7);
+    assert(message.newOrder.quantity == 120);
+    assert(message.newOrder.price == 15025000000LL);
+    assert(fromWirePrice(message.newOrder.stopPrice) == 149.5);
+    assert(message.symbol() == "AAPL");
+
+    SymbolCache symbols;
+    CompactOrder compact = WireDecoder::toCompactOrder(message.newOrder, symbols);
+    assert(compact.symbolId == SymbolTable::instance().find("AAPL"));
+    assert(compact.priceTicks == 15025 && compact.stopTicks == 14950);
+    assert(compact.type == OrderType::STOP_LIMIT && compact.side == OrderSide::SELL);
+    assert(compact.timeInForce == TimeInForce::FOK && compact.displayQty == 25);
+    // The sender's timestamp survives, on the same clock fromOrder uses
+    CompactOrder direct;
+    assert(CompactOrder::fromOrder(order, direct));
+    assert(compact.timestampNs == direct.timestampNs);
+
+    assert(decoder.next(message) == WireStatus::OK);
+    assert(message.type == WireType::CANCEL && message.cancel.orderId == 42);
+    assert(message.timestampNs() == 1000);
+
+    assert(decoder.next(message) == WireStatus::OK);
+    assert(message.type == WireType::MODIFY && message.modify.orderId == 43);
+    assert(fromWirePrice(message.modify.price) == 301.75 && message.modify.quantity == 55);
+    assert(message.symbol() == "MSFT");
+
+    assert(decoder.next(message) == WireStatus::OK);
+    assert(message.type == WireType::TRADE);
+    assert(message.trade.buyOrderId == 44 && message.trade.sellOrderId == 45);
+    assert(message.trade.quantity == 10 && message.symbol() == "GOOGL");
+
+    assert(decoder.next(message) == WireStatus::END);
+    std::cout << "test_round_trip passed\n";
+}
+
+void test_decoder_rejects_bad_input() {
+    WireEncoder encoder;
+    encoder.encodeCancel(1, "AAPL");
+    std::vector<char> bytes = encoder.buffer();
+
+    // Unknown types are skipped using their length
+    std::vector<char> withUnknown = {8, 0, 99, 0, 0, 0, 0, 0};
+    withUnknown.insert(withUnknown.end(), bytes.begin(), bytes.end());
+    WireDecoder skipping(std::string_view(withUnknown.data(), withUnknown.size()));
+    WireMessage message;
+    assert(skipping.next(message) == WireStatus::OK && message.type == WireType::CANCEL);
+
+    WireDecoder truncated(std::string_view(bytes.data(), bytes.size() - 1));
+    assert(truncated.next(message) == WireStatus::TRUNCATED);
+
+    bytes[0] = 16;  // Shorter than a cancel
+    WireDecoder badLength(std::string_view(bytes.data(), bytes.size()));
+    assert(badLength.next(message) == WireStatus::BAD_LENGTH);
+
+    // Enum bytes are range checked, and a new order cannot be a cancel or modify
+    for (size_t field : {offsetof(WireNewOrder, orderType), offsetof(WireNewOrder, side),
+                         offsetof(WireNewOrder, timeInForce)}) {
+        for (uint8_t value : {uint8_t(3), uint8_t(4), uint8_t(5), uint8_t(200)}) {
+            WireEncoder orders;
+            orders.encodeNewOrder(Order(1, 1, "AAPL", OrderType::LIMIT, OrderSide::BUY, 100.0, 5));
+            std::vector<char> order = orders.buffer();
+            order[field] = static_cast<char>(value);
+            bool valid = field == offsetof(WireNewOrder, orderType) ? value <= 3 : false;
+            WireDecoder badField(std::string_view(order.data(), order.size()));
+            assert(badField.next(message) == (valid ? WireStatus::OK : WireStatus::BAD_FIELD));
+            assert(badField.offset() == (valid ? order.size() : 0));
+        }
+    }
+
+    // Prices off the symbol's tick grid are refused rather than rounded
+    struct PriceCase {
+        OrderType type;
+        double price;
+        double stopPrice;
+        bool valid;
+    };
+    for (const PriceCase& c : {PriceCase{OrderType::LIMIT, 100.006, 0.0, false},
+                               PriceCase{OrderType::STOP, 0.0, 99.995, false},
+                               PriceCase{OrderType::STOP_LIMIT, 100.0, 99.001, false},
+                               PriceCase{OrderType::STOP_LIMIT, 100.001, 99.0, false},
+                               PriceCase{OrderType::MARKET, 100.006, 0.0, true},
+                               PriceCase{OrderType::STOP_LIMIT, 100.01, 99.99, true}}) {
+        WireEncoder orders;
+        orders.encodeNewOrder(Order(1, 1, "AAPL", c.type, OrderSide::BUY, c.price, 5, c.stopPrice));
+        WireDecoder decoder(std::string_view(orders.buffer().data(), orders.size()));
+        assert(decoder.next(message) == (c.valid ? WireStatus::OK : WireStatus::BAD_FIELD));
+        assert(decoder.offset() == (c.valid ? orders.size() : 0));
+    }
+    WireEncoder modifies;
+    modifies.encodeModify(1, "AAPL", 100.006, 5);
+    modifies.encodeModify(1, "AAPL", 100.01, 5);
+    WireDecoder offTickModify(std::string_view(modifies.buffer().data(), modifies.size()));
+    assert(offTickModify.next(message) == WireStatus::BAD_FIELD);
+    assert(offTickModify.offset() == 0);
+    WireDecoder onTickModify(std::string_view(modifies.buffer().data() + 48, modifies.size() - 48));
+    assert(onTickModify.next(message) == WireStatus::OK && message.type == WireType::MODIFY);
+
+    bool threw = false;
+    try {
+        encoder.encodeCancel(1, "TOOLONGSYM");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(WireDecoder::checkFileHeader("not a wire file at all") == 0);
+    std::cout << "test_decoder_rejects_bad_input passed\n";
+}
+
+void test_binary_feed_replay() {
+    WireEncoder encoder;
+    encoder.writeFileHeader();
+    for (uint64_t id = 1; id <= 100; ++id) {
+        encoder.encodeNewOrder(Order(id, 1, "TSLA", OrderType::LIMIT,
+                                     id % 2 ? OrderSide::BUY : OrderSide::SELL, 200.0, 5));
+    }
+    encoder.encodeCancel(1, "TSLA");
+    {
+        std::ofstream out("wire_feed.bin", std::ios::binary);
+        out.write(encoder.buffer().data(), static_cast<std::streamsize>(encoder.size()));
+    }
+
+    DataFeed feed;
+    assert(feed.connect("wire_feed.bin"));
+    uint64_t newOrders = 0, cancels = 0, idSum = 0;
+    feed.setWireHandler([&](const WireMessage& message) {
+        if (message.type == WireType::NEW_ORDER) {
+            newOrders++;
+            idSum += message.newOrder.orderId;
+        } else if (message.type == WireType::CANCEL) {
+            cancels++;
+        }
+    });
+    feed.start();
+    feed.wait();
+    assert(newOrders == 100 && cancels == 1 && idSum == 5050);
+    assert(feed.getProcessedLines() == 101);
+    std::remove("wire_feed.bin");
+    std::cout << "test_binary_feed_replay passed\n";
+}
+
+int main() {
+    test_round_trip();
+    test_decoder_rejects_bad_input();
+    test_binary_feed_replay();
+    std::cout << "All wire format tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include "../src/io/Workload.h"
+#include "../src/io/MappedFile.h"
+#include "../src/io/WireFormat.h"
+#include "../src/engine/BookRegistry.h"
+#include "../src/engine/SymbolTable.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+static bool near(double actual, double expected, double tolerance) {
+    return std::fabs(actual - expected) <= tolerance * expected;
+}
+
+// What a replay acts on. Timestamps differ between formats, binary cancels
+// and modifies carry no side, and a binary cancel nothing but the id.
+static auto key(const CompactOrder& o) {
+    bool cancel = o.type == OrderType::CANCEL;
+    bool newOrder = !cancel && o.type != OrderType::MODIFY;
+    return std::make_tuple(o.orderId, o.symbolId, static_cast<int>(o.type), newOrder ? static_cast<int>(o.side) : 0,
+                           cancel ? 0 : o.priceTicks, cancel ? 0 : o.quantity);
+}
+
+void test_same_seed_same_stream() {
+    WorkloadConfig config;
+    config.seed = 42;
+    auto first = WorkloadGenerator(config).generate(20000);
+    auto second = WorkloadGenerator(config).generate(20000);
+    config.seed = 43;
+    auto other = WorkloadGenerator(config).generate(20000);
+    size_t differing = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        assert(first[i].orderId == second[i].orderId && first[i].type == second[i].type);
+        assert(first[i].symbol == second[i].symbol && first[i].price == second[i].price);
+        assert(first[i].quantity == second[i].quantity && first[i].timestamp == second[i].timestamp);
+        if (first[i].price != other[i].price || first[i].symbol != other[i].symbol) differing++;
+    }
+    assert(differing > first.size() / 2);
+    std::cout << "test_same_seed_same_stream passed\n";
+}
+
+void test_message_mix_and_references() {
+    WorkloadConfig config;
+    config.cancelRatio = 0.4;
+    config.modifyRatio = 0.1;
+    config.marketRatio = 0.05;
+    config.midMoveProbability = 0.0;    // Keeps the touch at 99.99 / 100.01
+    WorkloadGenerator generator(config);
+    const size_t count = 200000;
+    std::map<OrderType, size_t> types;
+    std::map<std::string, size_t> symbols;
+    std::set<uint64_t> resting;
+    size_t passiveAtTouch = 0, passive = 0;
+    Order order;
+    for (size_t i = 0; i < count; ++i) {
+        generator.next(order);
+        types[order.type]++;
+        symbols[order.symbol]++;
+        if (order.type == OrderType::CANCEL || order.type == OrderType::MODIFY) {
+            // Only ever an order it sent earlier and has not cancelled
+            assert(resting.count(order.orderId));
+            if (order.type == OrderType::CANCEL) resting.erase(order.orderId);
+        } else if (order.type == OrderType::LIMIT) {
+            resting.insert(order.orderId);
+            passive++;
+            if (std::fabs(order.price - 100.0) < 0.05) passiveAtTouch++;
+        }
+    }
+    assert(generator.getGenerated() == count);
+    assert(near(types[OrderType::CANCEL], 0.4 * count, 0.05));
+    assert(near(types[OrderType::MODIFY], 0.1 * count, 0.05));
+    size_t newOrders = types[OrderType::LIMIT] + types[OrderType::MARKET];
+    assert(near(types[OrderType::MARKET], 0.05 * newOrders, 0.1));
+    // Zipf: popularity falls with rank, AAPL about twice MSFT
+    assert(symbols["AAPL"] > symbols["MSFT"] && symbols["MSFT"] > symbols["GOOGL"]);
+    assert(symbols["GOOGL"] > symbols["AMZN"] && symbols["AMZN"] > symbols["TSLA"]);
+    assert(near(static_cast<double>(symbols["AAPL"]) / symbols["MSFT"], 2.0, 0.1));
+    // Prices cluster at the touch
+    assert(passiveAtTouch > passive / 2);
+    std::cout << "test_message_mix_and_references passed\n";
+}
+
+// Variance over mean of the message count per millisecond: 1 for Poisson
+static double dispersion(const std::vector<Order>& orders) {
+    std::map<int64_t, double> perWindow;
+    for (const auto& order : orders) {
+        perWindow[std::chrono::duration_cast<std::chrono::milliseconds>(order.timestamp - orders[0].timestamp).count()]++;
+    }
+    double windows = static_cast<double>(perWindow.rbegin()->first + 1);
+    double sum = 0, sumSquares = 0;
+    for (const auto& entry : perWindow) {
+        sum += entry.second;
+        sumSquares += entry.second * entry.second;
+    }
+    double mean = sum / windows;
+    return (sumSquares / windows - mean * mean) / mean;
+}
+
+void test_arrival_rates() {
+    WorkloadConfig config;
+    config.arrivals = ArrivalProcess::POISSON;
+    config.baseRate = 50000.0;
+    WorkloadGenerator poisson(config);
+    auto steady = poisson.generate(200000);
+    double poissonRate = 200000 / (poisson.getElapsedNs() / 1e9);
+    assert(near(poissonRate, 50000.0, 0.03));
+    assert(dispersion(steady) < 1.3);
+
+    // Hawkes runs at baseRate / (1 - branchingRatio) on average, in bursts
+    config.arrivals = ArrivalProcess::HAWKES;
+    config.branchingRatio = 0.6;
+    WorkloadGenerator hawkes(config);
+    auto bursty = hawkes.generate(200000);
+    double hawkesRate = 200000 / (hawkes.getElapsedNs() / 1e9);
+    assert(near(hawkesRate, 50000.0 / 0.4, 0.1));
+    double burstiness = dispersion(bursty);
+    assert(burstiness > 2.0);
+    std::cout << "test_arrival_rates passed (dispersion " << dispersion(steady) << " Poisson, "
+              << burstiness << " Hawkes)\n";
+}
+
+void test_rejects_bad_config() {
+    auto rejects = [](WorkloadConfig config) {
+        try {
+            WorkloadGenerator generator(config);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    WorkloadConfig config;
+    config.branchingRatio = 1.0;
+    assert(rejects(config));
+    config = WorkloadConfig();
+    config.cancelRatio = 0.8;
+    config.modifyRatio = 0.3;
+    assert(rejects(config));
+    config = WorkloadConfig();
+    config.symbols.clear();
+    assert(rejects(config));
+    std::cout << "test_rejects_bad_config passed\n";
+}
+
+void test_file_round_trip_and_replay() {
+    WorkloadConfig config;
+    config.seed = 9;
+    auto orders = WorkloadGenerator(config).generate(30000);
+    std::vector<CompactOrder> expected;
+    for (const auto& order : orders) expected.push_back(CompactOrder::fromOrder(order));
+
+    for (const char* path : {"workload_test.bin", "workload_test.json"}) {
+        WorkloadFile::write(path, orders);
+        auto loaded = WorkloadFile::load(path);
+        assert(loaded.size() == expected.size());
+        for (size_t i = 0; i < loaded.size(); ++i) assert(key(loaded[i]) == key(expected[i]));
+        std::remove(path);
+    }
+    // The binary messages keep the simulated arrival times for paced replay
+    WorkloadFile::write("workload_test.bin", orders);
+    auto loaded = WorkloadFile::load("workload_test.bin");
+    {
+        MappedFile file("workload_test.bin");
+        WireDecoder decoder(file.view().substr(WireDecoder::checkFileHeader(file.view())));
+        WireMessage message;
+        for (const auto& order : orders) {
+            assert(decoder.next(message) == WireStatus::OK);
+            assert(static_cast<int64_t>(message.timestampNs()) ==
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(order.timestamp.time_since_epoch()).count());
+        }
+    }
+    std::remove("workload_test.bin");
+
+    // Replays cleanly: cancels and modifies hit resting orders and trades happen
+    BookRegistry books;
+    for (const auto& order : loaded) books.getBook(order.symbolId).addOrder(order);
+    assert(books.size() == config.symbols.size());
+    assert(books.getTotalTrades() > 0);
+    std::cout << "test_file_round_trip_and_replay passed (" << books.getTotalTrades() << " trades)\n";
+}
+
+int main() {
+    test_same_seed_same_stream();
+    test_message_mix_and_references();
+    test_arrival_rates();
+    test_rejects_bad_config();
+    test_file_round_trip_and_replay();
+    std::cout << "All workload tests passed!\n";
+    return 0;
+}